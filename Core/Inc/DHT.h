@@ -17,6 +17,18 @@ typedef struct
 }DHT_DataTypedef;
 
 
+typedef enum
+{
+	DHT_IDLE = 0,   // no reading in flight
+	DHT_BUSY,       // start pulse or reply capture in progress
+	DHT_READY,      // reading finished, data is valid
+	DHT_FAILED      // no reply, short frame or bad checksum
+}DHT_StatusTypedef;
+
+
+void DHT_StartRead (void);
+DHT_StatusTypedef DHT_GetResult (DHT_DataTypedef *DHT_Data);
+uint8_t DHT_IsBusy (void);
 void DHT_GetData (DHT_DataTypedef *DHT_Data);
 
 #endif /* INC_DHT_H_ */
@@ -0,0 +1,44 @@
+/**
+  ******************************************************************************
+  * @file           : adcScan.h
+
+  * @brief          : continuous DMA scan of the three ADC1 inputs
+  * @date           : 17-10-2026
+
+  ******************************************************************************
+  */
+
+#ifndef INC_ADCSCAN_H_
+#define INC_ADCSCAN_H_
+
+#include "stm32f4xx_hal.h"
+
+// Positions in the scan, in ADC1 rank order (see MX_ADC1_Init):
+#define ADC_SCAN_SOLAR      0   // rank 1, ADC1_IN10 / PC0 (ANALOG_IN_1)
+#define ADC_SCAN_AUX1       1   // rank 2, ADC1_IN11 / PC1 (ANALOG_IN_2)
+#define ADC_SCAN_AUX2       2   // rank 3, ADC1_IN12 / PC2 (ANALOG_IN_3)
+#define ADC_SCAN_CHANNELS   3
+
+#define ADC_SCAN_DEPTH      16  // scans averaged per half of the DMA buffer
+#define ADC_SCAN_RATE_HZ    1000 // default scans per second, started by TIM4 CH4 (0 = free-running)
+
+typedef struct {
+	uint16_t value[ADC_SCAN_CHANNELS]; // mean of the last ADC_SCAN_DEPTH samples, 12-bit
+	uint32_t blocks;                   // number of half-buffers processed so far
+} adc_scan_snapshot_t;
+
+typedef struct {
+	uint32_t irqCount;                 // ADC and ADC DMA interrupts taken since start-up
+	uint32_t irqCycles;                // CPU cycles spent in those handlers
+} adc_scan_irq_stats_t;
+
+void adc_scan_start(void);
+void adc_scan_stop(void);
+void adc_scan_snapshot(adc_scan_snapshot_t *snapshot);
+void adc_scan_set_rate(uint32_t hz);
+uint32_t adc_scan_get_rate(void);
+void adc_scan_irq_stats(adc_scan_irq_stats_t *stats);
+void adc_scan_account_irq(uint32_t cycles);
+void adc_scan_block_ready(const uint16_t *samples, uint16_t scans); // weak hook, raw scans from the DMA interrupt
+
+#endif /* INC_ADCSCAN_H_ */
@@ -0,0 +1,28 @@
+/**
+  ******************************************************************************
+  * @file           : clockProfile.h
+
+  * @brief          : run-time switchable system clock profiles
+  * @date           : 17-10-2026
+
+  ******************************************************************************
+  */
+
+#ifndef INC_CLOCKPROFILE_H_
+#define INC_CLOCKPROFILE_H_
+
+#include "stm32f4xx_hal.h"
+
+typedef enum {
+	CLOCK_PROFILE_LOW = 0,   // 16 MHz straight from the HSI, PLL off: sensing and console
+	CLOCK_PROFILE_HIGH       // 100 MHz PLL (SystemClock_Config): drawing and OLED flushes
+} clock_profile_t;
+
+#define CLOCK_SPI2_MAX_HZ   6250000  // OLED SCK, what SystemClock_Config + SPI /8 gives
+#define CLOCK_TIMER_TICK_HZ 1000000  // TIM2 (DHT11) and TIM4 (ADC trigger) count microseconds
+
+HAL_StatusTypeDef clock_set_profile(clock_profile_t profile); // HAL_BUSY while a DHT11, OLED or UART transfer is in flight
+clock_profile_t clock_get_profile(void);
+void clock_restore(void);   // re-apply the current profile, e.g. after Stop mode
+
+#endif /* INC_CLOCKPROFILE_H_ */
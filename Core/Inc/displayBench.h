@@ -0,0 +1,35 @@
+/**
+  ******************************************************************************
+  * @file           : displayBench.h
+
+  * @brief          : timed standard workloads for the SSD1331 drawing calls
+  * @date           : 17-10-2026
+
+  ******************************************************************************
+  */
+
+#ifndef INC_DISPLAYBENCH_H_
+#define INC_DISPLAYBENCH_H_
+
+#include "stm32f4xx_hal.h"
+
+#define DISPLAY_BENCH_RUNS   16   // calls per case from the menu
+
+typedef struct {
+	const char *name;
+	uint16_t runs;
+	uint32_t ns;                 // per call, until the panel is idle again
+	uint32_t spiBytes;           // per call
+	uint32_t spiTransfers;       // per call
+	uint32_t pixels;             // per call, what the workload draws
+	uint32_t pixelsPerSec;
+} display_bench_result_t;
+
+uint8_t display_bench_cases(void);
+void display_bench_setup(uint8_t index);    // before display_bench_case(), untimed and uncounted
+void display_bench_case(uint8_t index, uint16_t runs, display_bench_result_t *result);
+void display_bench_print_header(uint16_t runs);
+void display_bench_print(const display_bench_result_t *result);
+void display_bench_run(uint16_t runs);      // every case, as CSV on the console
+
+#endif /* INC_DISPLAYBENCH_H_ */
@@ -0,0 +1,53 @@
+/**
+  ******************************************************************************
+  * @file           : flashLog.h
+
+  * @brief          : log-structured sensor history in flash sectors 6 and 7
+  * @date           : 17-10-2026
+
+  ******************************************************************************
+  */
+
+#ifndef INC_FLASHLOG_H_
+#define INC_FLASHLOG_H_
+
+#include "stm32f4xx_hal.h"
+#include "sampleCodec.h"
+
+#define FLASH_LOG_SECTOR_COUNT  2
+#define FLASH_LOG_SECTOR_SIZE   (128 * 1024)                // sectors 6 and 7 are 128 KB each
+#define FLASH_LOG_PAGE_SIZE     256                         // bytes programmed per batch
+#define FLASH_LOG_PAGE_DATA     (FLASH_LOG_PAGE_SIZE - 8)    // encoded bytes after the page header
+#define FLASH_LOG_PAGE_RECORDS  120                         // most records per page, bounds what a reset loses
+#define FLASH_LOG_NO_DATA       0xFF                        // humidity of a record without a DHT11 reading
+
+typedef struct {
+	uint32_t time;               // ms since boot
+	uint8_t humidity;            // %RH, FLASH_LOG_NO_DATA if the DHT11 didn't answer
+	int8_t temperature;          // degrees C
+	uint16_t light;              // solar panel ADC value
+} flash_log_record_t;            // 8 bytes, ~2 once encoded
+
+typedef struct {
+	uint32_t records;            // committed records in flash
+	uint16_t pending;            // records waiting in RAM for a full page
+	uint16_t boot;               // number of this boot (records carry it)
+	uint32_t erases[FLASH_LOG_SECTOR_COUNT]; // erase count of each sector
+} flash_log_info_t;
+
+typedef struct {
+	uint8_t sector;              // position of a dump, see flash_log_dump_next
+	uint16_t page;
+	uint16_t left;               // records still to read from the page
+	uint8_t done;
+	codec_reader_t reader;
+} flash_log_cursor_t;
+
+void flash_log_init(void);                                  // scan flash, takes a few ms
+void flash_log_append(const flash_log_record_t *record);    // buffers, programs a page once it's full
+void flash_log_sync(void);                                  // program the buffered records now
+void flash_log_info(flash_log_info_t *info);
+void flash_log_dump_begin(flash_log_cursor_t *cursor);      // oldest record first
+uint8_t flash_log_dump_next(flash_log_cursor_t *cursor, uint16_t *boot, flash_log_record_t *record); // 0 at the end
+
+#endif /* INC_FLASHLOG_H_ */
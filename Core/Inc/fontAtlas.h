@@ -0,0 +1,35 @@
+/**
+  ******************************************************************************
+  * @file           : fontAtlas.h
+
+  * @brief          : row-major glyph atlas compiled from fonts.c
+  * @date           : 17-10-2026
+
+  ******************************************************************************
+  */
+
+#ifndef INC_FONTATLAS_H_
+#define INC_FONTATLAS_H_
+
+#include <stdint.h>
+
+/* One font of fontAtlas.c, generated by tools/font_compile.py. Glyph g
+ * (character first + g) has height rows of rowBytes bytes each, starting at
+ * pchRows + g * height * rowBytes, left pixel in the MSB. */
+typedef struct {
+	uint8_t chWidth;             // cell width, the advance of monospaced text
+	uint8_t chHeight;
+	uint8_t chRowBytes;
+	uint8_t chFirst;             // first character
+	uint8_t chCount;             // characters in the font
+	const uint8_t *pchRows;
+	const uint8_t *pchInkLeft;   // per glyph: first column with a set pixel
+	const uint8_t *pchInkWidth;  // per glyph: columns from there to the last set one, 0 if blank
+} font_atlas_t;
+
+extern const font_atlas_t c_tFontAtlas1206;
+extern const font_atlas_t c_tFontAtlas1608;
+extern const font_atlas_t c_tFontAtlas1612;   // '0'-'9' and ':' only
+extern const font_atlas_t c_tFontAtlas3216;   // '0'-'9' and ':' only
+
+#endif /* INC_FONTATLAS_H_ */
@@ -0,0 +1,91 @@
+/**
+  ******************************************************************************
+  * @file           : logger.h
+
+  * @brief          : tokenized logging: call sites store a format id and raw
+  *                   arguments, formatting happens later
+  * @date           : 17-10-2026
+
+  ******************************************************************************
+  */
+
+#ifndef INC_LOGGER_H_
+#define INC_LOGGER_H_
+
+#include "stm32f4xx_hal.h"
+
+#define LOG_LEVEL_ERROR   1
+#define LOG_LEVEL_WARN    2
+#define LOG_LEVEL_INFO    3
+#define LOG_LEVEL_DEBUG   4
+
+// Modules, for filtering (also listed in tools/telemetry_decode.py)
+#define LOG_MODULE_MAIN   0
+#define LOG_MODULE_DHT    1
+#define LOG_MODULE_ADC    2
+#define LOG_MODULE_POWER  3
+
+// Compile-time filter: calls above LOG_LEVEL or for a module outside
+// LOG_MODULES generate no code (at -O0 the format string of a filtered-out
+// module still takes flash)
+#ifndef LOG_LEVEL
+#define LOG_LEVEL         LOG_LEVEL_INFO
+#endif
+#ifndef LOG_MODULES
+#define LOG_MODULES       0xFFFFFFFFUL  // bit n = LOG_MODULE n
+#endif
+
+// Where log_task() sends the entries: formatted by printf, or as
+// TELEMETRY_FRAME_LOG frames for the host to format (always the latter while
+// telemetry is on, so the text can't break up the binary stream)
+#define LOG_OUTPUT_TEXT   0
+#define LOG_OUTPUT_BINARY 1
+#ifndef LOG_OUTPUT
+#define LOG_OUTPUT        LOG_OUTPUT_TEXT
+#endif
+
+#define LOG_RING_WORDS    256   // entry ring, 4 bytes each; an entry is 2 words + 1 per argument
+#define LOG_MAX_ARGS      10
+
+// Arguments are stored as 32-bit words, so formats may only use integer
+// conversions (%d %u %lu %x %c...), no %s or %f. The format string goes into
+// the .log_fmt section and the entry holds its offset there.
+#define LOG(level, module, fmt, ...) do { \
+	if (LOG_MODULES & (1UL << (module))) { \
+		static const char logFmt[] __attribute__((section(".log_fmt"))) = fmt; \
+		const uint32_t logArgs[] = { 0, ##__VA_ARGS__ }; \
+		_Static_assert(sizeof(logArgs) <= (LOG_MAX_ARGS + 1) * sizeof(uint32_t), "too many log arguments"); \
+		log_write(logFmt, (level), (module), logArgs + 1, sizeof(logArgs) / sizeof(uint32_t) - 1); \
+	} \
+} while (0)
+
+// A filtered-out level still names its arguments (unevaluated), so values
+// computed only for the log don't trigger unused-variable warnings
+#define LOG_NONE(module, fmt, ...)  do { (void)sizeof((const uint32_t[]){ 0, ##__VA_ARGS__ }); } while (0)
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(module, fmt, ...)  LOG(LOG_LEVEL_ERROR, module, fmt, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(module, fmt, ...)  LOG_NONE(module, fmt, ##__VA_ARGS__)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(module, fmt, ...)   LOG(LOG_LEVEL_WARN, module, fmt, ##__VA_ARGS__)
+#else
+#define LOG_WARN(module, fmt, ...)   LOG_NONE(module, fmt, ##__VA_ARGS__)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(module, fmt, ...)   LOG(LOG_LEVEL_INFO, module, fmt, ##__VA_ARGS__)
+#else
+#define LOG_INFO(module, fmt, ...)   LOG_NONE(module, fmt, ##__VA_ARGS__)
+#endif
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(module, fmt, ...)  LOG(LOG_LEVEL_DEBUG, module, fmt, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(module, fmt, ...)  LOG_NONE(module, fmt, ##__VA_ARGS__)
+#endif
+
+void log_write(const char *fmt, uint8_t level, uint8_t module, const uint32_t *args, uint8_t count); // use the macros
+void log_task(void);               // formats / sends the queued entries, run on EVENT_LOG
+uint32_t log_dropped(void);        // entries lost to a full ring
+
+#endif /* INC_LOGGER_H_ */
@@ -0,0 +1,41 @@
+/**
+  ******************************************************************************
+  * @file           : lowPower.h
+
+  * @brief          : idle policy for the scheduler (Sleep / Stop with RTC wake-up)
+  * @date           : 17-10-2026
+
+  ******************************************************************************
+  */
+
+#ifndef INC_LOWPOWER_H_
+#define INC_LOWPOWER_H_
+
+#include "stm32f4xx_hal.h"
+
+// Deepest state the core may use while no task is ready:
+typedef enum {
+	LP_RUN = 0,     // never sleep (baseline for the duty cycle report)
+	LP_SLEEP,       // WFI only, every peripheral keeps running
+	LP_STOP         // Stop mode for gaps of LP_STOP_MIN_MS or more, WFI otherwise
+} lp_mode_t;
+
+#define LP_MODE             LP_SLEEP // mode in effect at start-up, Stop is opted into with 'd' (menu 7)
+#define LP_STOP_MIN_MS      10       // shorter gaps aren't worth restarting the PLL for
+#define LP_STOP_MAX_MS      30000    // longest single Stop, the wake-up timer is 16-bit at ~2 kHz
+#define LP_RX_AWAKE_MS      5000     // stay out of Stop this long after a key press woke us
+
+typedef struct {
+	uint32_t activeUs;  // core running
+	uint32_t sleepUs;   // in WFI
+	uint32_t stopUs;    // in Stop mode
+	uint32_t stops;     // number of times Stop was entered
+} lp_stats_t;
+
+void lp_init(void);
+void lp_set_mode(lp_mode_t mode);
+lp_mode_t lp_get_mode(void);
+void lp_stats(lp_stats_t *stats);    // running totals, diff two copies to get a duty cycle
+void lp_wakeup_irq_handler(void);    // call from RTC_WKUP_IRQHandler and EXTI3_IRQHandler
+
+#endif /* INC_LOWPOWER_H_ */
@@ -41,7 +41,12 @@ extern "C" {
 
 /* Exported constants --------------------------------------------------------*/
 /* USER CODE BEGIN EC */
-
+// Scheduler event flags (see scheduler.h):
+#define EVENT_CONSOLE   (1UL << 0)  // a character arrived on USART2
+#define EVENT_SENSORS   (1UL << 1)  // new DHT11 + ADC values are in
+#define EVENT_RISK      (1UL << 2)  // mold risk re-evaluated
+#define EVENT_TELEMETRY (1UL << 3)  // raw ADC blocks are queued for telemetry
+#define EVENT_LOG       (1UL << 4)  // log entries are queued
 /* USER CODE END EC */
 
 /* Exported macro ------------------------------------------------------------*/
@@ -0,0 +1,33 @@
+/**
+  ******************************************************************************
+  * @file           : oledChart.h
+
+  * @brief          : scrolling strip chart on the SSD1331, shifted in hardware
+  * @date           : 17-10-2026
+
+  ******************************************************************************
+  */
+
+#ifndef INC_OLEDCHART_H_
+#define INC_OLEDCHART_H_
+
+#include "stm32f4xx_hal.h"
+
+#define CHART_NO_ROW   0xFF
+
+typedef struct {
+	uint8_t x, y;                // top-left corner of the plot on the panel
+	uint8_t width, height;
+	int32_t min, max;            // values mapped to the bottom and top row
+	uint16_t color;
+	uint16_t background;
+	uint8_t columns;             // columns drawn so far, up to width
+	uint8_t lastRow;             // row of the newest sample, CHART_NO_ROW after a gap
+} oled_chart_t;
+
+void chart_init(oled_chart_t *chart, uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+		int32_t min, int32_t max, uint16_t color);
+void chart_redraw(oled_chart_t *chart, uint8_t channel);        // from sensorHistory, newest sample on the right
+void chart_push(oled_chart_t *chart, int32_t value, uint8_t valid); // valid = 0 leaves a gap
+
+#endif /* INC_OLEDCHART_H_ */
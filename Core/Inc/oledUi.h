@@ -0,0 +1,64 @@
+/**
+  ******************************************************************************
+  * @file           : oledUi.h
+
+  * @brief          : retained widgets for the SSD1331 status screens
+  * @date           : 17-10-2026
+
+  ******************************************************************************
+  */
+
+#ifndef INC_OLEDUI_H_
+#define INC_OLEDUI_H_
+
+#include "stm32f4xx_hal.h"
+
+#define UI_TEXT_MAX    17            // 16 characters of FONT_1206 fill a line, plus '\0'
+
+typedef enum {
+	UI_LABEL,                        // fixed text
+	UI_VALUE,                        // a number through a printf format
+	UI_BANNER,                       // text on a coloured block, e.g. a warning
+	UI_BAR                           // horizontal bar gauge
+} ui_type_t;
+
+typedef struct {
+	uint8_t type;                    // ui_type_t
+	uint8_t x, y;                    // top-left corner on the panel
+	uint8_t width, height;
+	uint8_t font;                    // FONT_1206 or FONT_1608, text widgets only
+	const char *format;              // UI_VALUE: printf format with one %ld
+	int32_t min, max;                // UI_BAR: values of an empty and a full bar
+
+	// What the application asks for
+	char text[UI_TEXT_MAX];
+	int32_t value;
+	uint16_t color, background;
+	uint8_t visible;
+
+	// What the panel shows, compared against the above by ui_render()
+	char shownText[UI_TEXT_MAX];
+	uint16_t shownColor, shownBackground;
+	uint8_t shownVisible;
+	uint8_t shownFill;               // UI_BAR: filled columns
+	uint8_t drawn;                   // 0 until the first ui_render()
+} ui_widget_t;
+
+void ui_label_init(ui_widget_t *widget, uint8_t x, uint8_t y, uint8_t width, uint8_t font,
+		const char *text, uint16_t color);
+void ui_value_init(ui_widget_t *widget, uint8_t x, uint8_t y, uint8_t width, uint8_t font,
+		const char *format, uint16_t color);
+void ui_banner_init(ui_widget_t *widget, uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t font,
+		const char *text, uint16_t color, uint16_t background);
+void ui_bar_init(ui_widget_t *widget, uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+		int32_t min, int32_t max, uint16_t color);
+
+void ui_set_text(ui_widget_t *widget, const char *text);      // any text widget, a UI_VALUE until the next ui_set_value()
+void ui_set_value(ui_widget_t *widget, int32_t value);        // UI_VALUE and UI_BAR
+void ui_set_color(ui_widget_t *widget, uint16_t color);
+void ui_set_background(ui_widget_t *widget, uint16_t background);
+void ui_set_visible(ui_widget_t *widget, uint8_t visible);
+
+uint8_t ui_render(ui_widget_t *widgets, uint8_t count);       // redraws what changed, returns how many widgets
+
+#endif /* INC_OLEDUI_H_ */
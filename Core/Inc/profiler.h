@@ -0,0 +1,55 @@
+/**
+  ******************************************************************************
+  * @file           : profiler.h
+
+  * @brief          : begin/end probes timed with the DWT cycle counter
+  * @date           : 17-10-2026
+
+  ******************************************************************************
+  */
+
+#ifndef INC_PROFILER_H_
+#define INC_PROFILER_H_
+
+#include "stm32f4xx_hal.h"
+
+#ifndef PROFILE_ENABLED
+#define PROFILE_ENABLED   1   // 0 turns every probe into nothing
+#endif
+
+// One entry per probe, in the order prof_print() lists them
+typedef enum {
+	PROF_SENSORS = 0,        // collectSensors (main.c)
+	PROF_DISPLAY,            // displayTask (main.c)
+	PROF_OLED_STRING,        // ssd1331_display_string
+	PROF_OLED_FILL,          // ssd1331_fill_rect
+	PROF_DHT_READ,           // DHT_GetData, blocking read
+	PROF_DHT_DECODE,         // DHT_Finish, frame decode at the end of a reading (ISR)
+	PROF_ADC_ISR,            // ADC and ADC DMA interrupt handlers
+	PROF_PROBES
+} prof_probe_t;
+
+typedef struct {
+	uint32_t count;
+	uint32_t min;                // cycles
+	uint32_t max;
+	uint64_t total;
+	uint64_t totalNs;            // time, at whatever core clock each call ran
+} prof_stats_t;
+
+#if PROFILE_ENABLED
+// PROF_BEGIN declares a variable, so a begin/end pair has to share a block
+#define PROF_BEGIN(probe)  uint32_t profStart_##probe = DWT->CYCCNT
+#define PROF_END(probe)    prof_record(probe, DWT->CYCCNT - profStart_##probe)
+#else
+#define PROF_BEGIN(probe)  do { } while (0)
+#define PROF_END(probe)    do { } while (0)
+#endif
+
+void prof_init(void);                                  // starts DWT, measures the probe overhead
+void prof_record(prof_probe_t probe, uint32_t cycles); // also callable from ISRs
+void prof_get(prof_probe_t probe, prof_stats_t *stats);
+void prof_reset(void);
+void prof_print(void);                                 // table of all probes since the last reset
+
+#endif /* INC_PROFILER_H_ */
@@ -0,0 +1,51 @@
+/**
+  ******************************************************************************
+  * @file           : sampleCodec.h
+
+  * @brief          : delta / zig-zag / varint packing of timestamped sample streams
+  * @date           : 17-10-2026
+
+  ******************************************************************************
+  */
+
+#ifndef INC_SAMPLECODEC_H_
+#define INC_SAMPLECODEC_H_
+
+#include "stm32f4xx_hal.h"
+
+#define CODEC_MAX_CHANNELS   4    // values per sample
+#define CODEC_MAX_TOKEN      (10 + CODEC_MAX_CHANNELS * 5) // bytes one sample can take, worst case
+#define CODEC_NO_RUN         0xFFFF
+
+// Appends samples to a caller-provided buffer
+typedef struct {
+	uint8_t *buf;
+	uint16_t size;
+	uint16_t len;                // bytes used
+	uint16_t count;              // samples written
+	uint8_t channels;
+	uint32_t tick;               // previous sample
+	uint32_t dt;
+	int32_t value[CODEC_MAX_CHANNELS];
+	uint16_t runPos;             // offset of the run token at the end of buf, CODEC_NO_RUN if none
+	uint32_t run;
+} codec_writer_t;
+
+// Reads them back, in order
+typedef struct {
+	const uint8_t *buf;
+	uint16_t len;
+	uint16_t pos;
+	uint8_t channels;
+	uint32_t tick;
+	uint32_t dt;
+	int32_t value[CODEC_MAX_CHANNELS];
+	uint32_t run;                // repeats still to hand out
+} codec_reader_t;
+
+void codec_writer_init(codec_writer_t *writer, uint8_t *buf, uint16_t size, uint8_t channels);
+uint8_t codec_write(codec_writer_t *writer, uint32_t tick, const int32_t *value); // 0 if the sample doesn't fit
+void codec_reader_init(codec_reader_t *reader, const uint8_t *buf, uint16_t len, uint8_t channels);
+uint8_t codec_read(codec_reader_t *reader, uint32_t *tick, int32_t *value);        // 0 at the end (or on bad data)
+
+#endif /* INC_SAMPLECODEC_H_ */
@@ -0,0 +1,33 @@
+/**
+  ******************************************************************************
+  * @file           : scheduler.h
+
+  * @brief          : run-to-completion scheduler (periodic tasks, one-shot timers, event flags)
+  * @date           : 17-10-2026
+
+  ******************************************************************************
+  */
+
+#ifndef INC_SCHEDULER_H_
+#define INC_SCHEDULER_H_
+
+#include "stm32f4xx_hal.h"
+
+#define SCHED_MAX_TASKS     16  // periodic/event tasks and pending one-shot timers together
+#define SCHED_IDLE_FOREVER  0xFFFFFFFFUL // sched_idle() argument when no timed task is armed
+
+typedef void (*sched_fn_t)(void);
+
+// Thread context only:
+int8_t sched_add_task(sched_fn_t fn, uint32_t periodMs, uint32_t events); // id, or -1 if the table is full
+void sched_set_period(int8_t id, uint32_t periodMs);                      // 0 = run on events only
+int8_t sched_call_after(sched_fn_t fn, uint32_t delayMs);                 // one-shot, slot freed after it runs
+void sched_run(void);                                                     // never returns
+
+// Safe from interrupts too:
+void sched_post(uint32_t events);
+
+// Idle hook, weak (default: WFI). Called with interrupts masked:
+void sched_idle(uint32_t idleMs);
+
+#endif /* INC_SCHEDULER_H_ */
@@ -0,0 +1,43 @@
+/**
+  ******************************************************************************
+  * @file           : sensorHistory.h
+
+  * @brief          : per-channel delta-encoded history of timestamped sensor
+  *                   samples with O(1) rolling statistics
+  * @date           : 17-10-2026
+
+  ******************************************************************************
+  */
+
+#ifndef INC_SENSORHISTORY_H_
+#define INC_SENSORHISTORY_H_
+
+#include "stm32f4xx_hal.h"
+
+#define HISTORY_HUMIDITY     0   // %RH
+#define HISTORY_TEMPERATURE  1   // degrees C
+#define HISTORY_LIGHT        2   // solar panel ADC value, 12-bit
+#define HISTORY_CHANNELS     3
+
+#define HISTORY_DEPTH        384 // samples kept per channel (4 OLED widths), fewer if readings are very noisy
+#define HISTORY_WINDOW       10  // newest samples the statistics cover, <= HISTORY_DEPTH
+
+typedef struct {
+	uint32_t tick;               // HAL tick when the sample was taken
+	int32_t value;
+} history_sample_t;
+
+typedef struct {
+	uint16_t count;              // samples in the window, 0 if there is no data yet
+	float mean;
+	float variance;              // population variance
+	int32_t min;
+	int32_t max;
+} history_stats_t;
+
+void history_push(uint8_t channel, uint32_t tick, int32_t value);
+void history_stats(uint8_t channel, history_stats_t *stats);
+uint16_t history_count(uint8_t channel);    // samples stored, up to HISTORY_DEPTH
+uint8_t history_get(uint8_t channel, uint16_t age, history_sample_t *sample); // age 0 = newest; 0 if there is no such sample
+
+#endif /* INC_SENSORHISTORY_H_ */
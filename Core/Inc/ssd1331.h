@@ -31,6 +31,19 @@
 #define FONT_1206    12
 #define FONT_1608    16
 
+/* Draw into a 96x64 RGB565 RAM copy of the panel (12 KB) and send only the
+ * changed regions on ssd1331_flush(). Comment out to write every pixel straight
+ * to the controller as the original driver did. */
+#define SSD1331_USE_FRAMEBUFFER
+
+/* Queue panel transfers on SPI2_TX DMA (DMA1 Stream 4) so a flush returns as
+ * soon as it has been queued. Comment out to send everything by polling. */
+#define SSD1331_USE_DMA
+
+/* Use the controller's own line/rectangle/fill/clear/copy commands instead of
+ * plotting pixel by pixel. Comment out to draw everything in software. */
+#define SSD1331_USE_HW_ACCEL
+
 #define RGB(R,G,B)  (((R >> 3) << 11) | ((G >> 2) << 5) | (B >> 3))
 enum Color{
     BLACK     = RGB(  0,  0,  0), // black
@@ -63,10 +76,25 @@ extern void ssd1331_draw_circle(uint8_t chXpos, uint8_t chYpos, uint8_t chRadius
 extern void ssd1331_display_char(uint8_t chXpos, uint8_t chYpos, uint8_t chChr, uint8_t chSize, uint16_t hwColor);
 extern void ssd1331_display_num(uint8_t chXpos, uint8_t chYpos, uint32_t chNum, uint8_t chLen, uint8_t chSize, uint16_t hwColor);
 extern void ssd1331_display_string(uint8_t chXpos, uint8_t chYpos, const char *pchString, uint8_t chSize, uint16_t hwColor);
+extern uint8_t ssd1331_display_text(uint8_t chXpos, uint8_t chYpos, const char *pchString, uint8_t chSize, uint16_t hwColor);
+extern uint8_t ssd1331_text_width(const char *pchString, uint8_t chSize);
 extern void ssd1331_draw_1616char(uint8_t chXpos, uint8_t chYpos, uint8_t chChar, uint16_t hwColor);
 extern void ssd1331_draw_3216char(uint8_t chXpos, uint8_t chYpos, uint8_t chChar, uint16_t hwColor);
 extern void ssd1331_draw_bitmap(uint8_t chXpos, uint8_t chYpos, const uint8_t *pchBmp, uint8_t chWidth, uint8_t chHeight, uint16_t hwColor);
 extern void ssd1331_clear_screen(uint16_t hwColor);
+extern void ssd1331_copy_window(uint8_t chXpos0, uint8_t chYpos0, uint8_t chXpos1, uint8_t chYpos1, uint8_t chXdest, uint8_t chYdest);
+extern void ssd1331_start_scroll(uint8_t chColumns, uint8_t chRow, uint8_t chRows, uint8_t chInterval);
+extern void ssd1331_stop_scroll(void);
+extern void ssd1331_flush(void);
+extern uint8_t ssd1331_is_busy(void);
+extern void ssd1331_wait_idle(void);
+extern void ssd1331_begin(void);
+extern void ssd1331_write_cmd(const uint8_t *pchCmd, uint16_t hwLen);
+extern void ssd1331_write_data(const uint8_t *pchData, uint16_t hwLen);
+extern void ssd1331_end(void);
+extern uint32_t ssd1331_benchmark(uint8_t chLegacy);
+extern void ssd1331_get_spi_counts(uint32_t *pwBytes, uint32_t *pwTransfers);
+extern void ssd1331_reset_spi_counts(void);
 
 extern void ssd1331_init(void);
 
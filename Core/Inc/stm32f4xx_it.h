@@ -56,8 +56,14 @@ void DebugMon_Handler(void);
 void PendSV_Handler(void);
 void SysTick_Handler(void);
 void ADC_IRQHandler(void);
+void DMA1_Stream4_IRQHandler(void);
+void DMA1_Stream6_IRQHandler(void);
+void TIM2_IRQHandler(void);
+void USART2_IRQHandler(void);
+void DMA2_Stream0_IRQHandler(void);
 /* USER CODE BEGIN EFP */
-
+void RTC_WKUP_IRQHandler(void);
+void EXTI3_IRQHandler(void);
 /* USER CODE END EFP */
 
 #ifdef __cplusplus
@@ -0,0 +1,51 @@
+/**
+  ******************************************************************************
+  * @file           : telemetry.h
+
+  * @brief          : binary sample frames on USART2 (COBS framed, CRC-16)
+  * @date           : 17-10-2026
+
+  ******************************************************************************
+  */
+
+#ifndef INC_TELEMETRY_H_
+#define INC_TELEMETRY_H_
+
+#include "stm32f4xx_hal.h"
+#include "adcScan.h"
+
+// Frame types (first byte of a decoded frame), see telemetry.c and tools/telemetry_decode.py
+#define TELEMETRY_FRAME_SENSORS  1   // one DHT11 + light reading and the mold risk verdict
+#define TELEMETRY_FRAME_ADC      2   // ADC_SCAN_DEPTH raw scans of all ADC channels
+#define TELEMETRY_FRAME_LOG      3   // one tokenized log entry (see logger.c)
+
+#define TELEMETRY_ADC_QUEUE      4   // raw ADC blocks waiting for telemetry_task, 16 ms each at 1 kHz
+#define TELEMETRY_NO_DATA        0xFF // humidity of a frame without a DHT11 reading
+
+typedef enum {
+	TELEMETRY_OFF = 0,
+	TELEMETRY_SENSORS,           // sensor frames only
+	TELEMETRY_RAW                // sensor frames and every raw ADC scan
+} telemetry_mode_t;
+
+typedef struct {
+	uint32_t tick;               // HAL tick of the reading
+	uint8_t humidity;            // %RH, TELEMETRY_NO_DATA if the DHT11 didn't answer
+	int8_t temperature;          // degrees C
+	uint16_t light;              // solar panel ADC value
+	int8_t risk;                 // latest mold risk verdict, 1 = risk
+} telemetry_sensors_t;
+
+typedef struct {
+	uint32_t frames;             // frames queued for sending
+	uint32_t skipped;            // frames dropped because the UART buffer was full
+} telemetry_stats_t;
+
+void telemetry_set_mode(telemetry_mode_t mode);
+telemetry_mode_t telemetry_get_mode(void);
+void telemetry_send_sensors(const telemetry_sensors_t *sensors);
+void telemetry_send_log(uint32_t tick, uint16_t id, uint8_t level, uint8_t module, const uint32_t *args, uint8_t count);
+void telemetry_task(void);                              // sends the queued ADC blocks, run on EVENT_TELEMETRY
+void telemetry_stats(telemetry_stats_t *stats);
+
+#endif /* INC_TELEMETRY_H_ */
@@ -0,0 +1,25 @@
+/**
+  ******************************************************************************
+  * @file           : uartRx.h
+
+  * @brief          : interrupt-driven USART2 (VCP) receive ring buffer
+  * @date           : 17-10-2026
+
+  ******************************************************************************
+  */
+
+#ifndef INC_UARTRX_H_
+#define INC_UARTRX_H_
+
+#include "stm32f4xx_hal.h"
+
+#define UART_RX_BUFFER_SIZE  128  // bytes, must be a power of two
+
+void uart_rx_init(void);
+void uart_rx_irq_handler(void);   // call from USART2_IRQHandler before HAL_UART_IRQHandler
+
+uint16_t uart_available(void);    // bytes waiting to be read
+int uart_read(void);              // next byte, or -1 if none is waiting
+uint32_t uart_rx_dropped(void);   // bytes lost to a full buffer or a hardware overrun
+
+#endif /* INC_UARTRX_H_ */
@@ -0,0 +1,35 @@
+/**
+  ******************************************************************************
+  * @file           : uartTx.h
+
+  * @brief          : buffered USART2 (VCP) transmit drained by DMA
+  * @date           : 17-10-2026
+
+  ******************************************************************************
+  */
+
+#ifndef INC_UARTTX_H_
+#define INC_UARTTX_H_
+
+#include "stm32f4xx_hal.h"
+
+#define UART_TX_BUFFER_SIZE  1024 // bytes, must be a power of two
+#define UART_TX_CHUNK        64   // most bytes handed to the DMA at once
+
+// What uart_tx_write does when the buffer cannot take the whole message:
+typedef enum {
+  UART_TX_DROP = 0,    // keep what is queued, discard the new bytes that don't fit
+  UART_TX_BLOCK,       // wait for the DMA to make room (drops instead inside an ISR)
+  UART_TX_OVERWRITE    // discard the oldest queued bytes to make room
+} uart_tx_policy_t;
+
+#define UART_TX_POLICY       UART_TX_DROP  // policy in effect at start-up
+
+int uart_tx_write(const char *ptr, int len);  // called by _write (syscalls.c)
+void uart_tx_set_policy(uart_tx_policy_t policy);
+void uart_tx_flush(void);                     // wait until everything queued has been sent
+uint8_t uart_tx_busy(void);                   // 1 until everything queued has been sent
+uint16_t uart_tx_space(void);                 // bytes that can be queued right now without dropping
+uint32_t uart_tx_dropped(void);               // bytes discarded by DROP or OVERWRITE
+
+#endif /* INC_UARTTX_H_ */
@@ -1,5 +1,3 @@
-
-
 /************** MAKE CHANGES HERE ********************/
 #include "stm32f4xx_hal.h"
 
@@ -10,57 +8,38 @@
 #define DHT_PORT GPIOA
 #define DHT_PIN GPIO_PIN_1
 
+#define DHT_TIM htim2              // 1 MHz timer, CH1 times the start pulse, CH2 captures PA1
+#define DHT_TIM_AF GPIO_AF1_TIM2
 
 
 
-/*******************************************     NO CHANGES AFTER THIS LINE      ****************************************************/
 
-uint8_t Rh_byte1, Rh_byte2, Temp_byte1, Temp_byte2;
-uint16_t SUM; uint8_t Presence = 0;
+/*******************************************     NO CHANGES AFTER THIS LINE      ****************************************************/
 
 #include "DHT.h"
+#include "tim.h"
+#include "profiler.h"
 
-uint32_t DWT_Delay_Init(void)
-{
-  /* Disable TRC */
-  CoreDebug->DEMCR &= ~CoreDebug_DEMCR_TRCENA_Msk; // ~0x01000000;
-  /* Enable TRC */
-  CoreDebug->DEMCR |=  CoreDebug_DEMCR_TRCENA_Msk; // 0x01000000;
-
-  /* Disable clock cycle counter */
-  DWT->CTRL &= ~DWT_CTRL_CYCCNTENA_Msk; //~0x00000001;
-  /* Enable  clock cycle counter */
-  DWT->CTRL |=  DWT_CTRL_CYCCNTENA_Msk; //0x00000001;
-
-  /* Reset the clock cycle counter value */
-  DWT->CYCCNT = 0;
-
-     /* 3 NO OPERATION instructions */
-     __ASM volatile ("NOP");
-     __ASM volatile ("NOP");
-  __ASM volatile ("NOP");
-
-  /* Check if clock cycle counter has started */
-     if(DWT->CYCCNT)
-     {
-       return 0; /*clock cycle counter started*/
-     }
-     else
-  {
-    return 1; /*clock cycle counter not started*/
-  }
-}
+#if defined(TYPE_DHT11)
+#define DHT_START_US       18000   // host holds the line low for 18ms
+#endif
 
-__STATIC_INLINE void delay(volatile uint32_t microseconds)
-{
-  uint32_t clk_cycle_start = DWT->CYCCNT;
+#if defined(TYPE_DHT22)
+#define DHT_START_US       1200    // >1ms
+#endif
 
-  /* Go to number of cycles for system */
-  microseconds *= (HAL_RCC_GetHCLKFreq() / 1000000);
+#define DHT_FRAME_TIMEOUT_US  8000  // a full frame takes about 5ms after the start pulse
+#define DHT_EDGES          42      // falling edges: response, 40 bits, end of frame
+#define DHT_BIT_ONE_US     100     // a bit period is ~78us for a 0 and ~120us for a 1
 
-  /* Delay till end */
-  while ((DWT->CYCCNT - clk_cycle_start) < microseconds);
-}
+uint8_t Rh_byte1, Rh_byte2, Temp_byte1, Temp_byte2;
+uint16_t SUM; uint8_t Presence = 0;
+
+static volatile DHT_StatusTypedef dhtStatus = DHT_IDLE;
+static volatile uint8_t dhtReleased = 0;      // 0 during the start pulse, 1 while capturing
+static volatile uint8_t dhtEdgeCount = 0;
+static uint32_t dhtEdges[DHT_EDGES];          // timer value at each falling edge, in us
+static DHT_DataTypedef dhtResult;
 
 void Set_Pin_Output (GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
 {
@@ -71,91 +50,149 @@ void Set_Pin_Output (GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
 	HAL_GPIO_Init(GPIOx, &GPIO_InitStruct);
 }
 
-void Set_Pin_Input (GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+void Set_Pin_Capture (GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
 {
 	GPIO_InitTypeDef GPIO_InitStruct = {0};
 	GPIO_InitStruct.Pin = GPIO_Pin;
-	GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
+	GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
 	GPIO_InitStruct.Pull = GPIO_NOPULL;
+	GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+	GPIO_InitStruct.Alternate = DHT_TIM_AF;
 	HAL_GPIO_Init(GPIOx, &GPIO_InitStruct);
 }
 
 
-void DHT_Start (void)
+/* Decodes the captured edges into the five frame bytes and checks the sum */
+static uint8_t DHT_Decode (void)
 {
-	DWT_Delay_Init();
-	Set_Pin_Output (DHT_PORT, DHT_PIN);  // set the pin as output
-	HAL_GPIO_WritePin (DHT_PORT, DHT_PIN, 0);   // pull the pin low
+	uint8_t bytes[5] = {0};
+	uint8_t i;
 
-#if defined(TYPE_DHT11)
-	delay (18000);   // wait for 18ms
-#endif
+	for (i = 0; i < 40; i++)
+	{
+		uint32_t period = dhtEdges[i + 2] - dhtEdges[i + 1];
+		bytes[i / 8] = (bytes[i / 8] << 1) | (period > DHT_BIT_ONE_US);
+	}
 
-#if defined(TYPE_DHT22)
-	delay (1200);  // >1ms delay
-#endif
+	Rh_byte1 = bytes[0];
+	Rh_byte2 = bytes[1];
+	Temp_byte1 = bytes[2];
+	Temp_byte2 = bytes[3];
+	SUM = bytes[4];
+
+	if (SUM != ((Rh_byte1 + Rh_byte2 + Temp_byte1 + Temp_byte2) & 0xFF)) return 0;
 
-    HAL_GPIO_WritePin (DHT_PORT, DHT_PIN, 1);   // pull the pin high
-    delay (20);   // wait for 30us
-	Set_Pin_Input(DHT_PORT, DHT_PIN);    // set as input
+	#if defined(TYPE_DHT11)
+		dhtResult.Temperature = Temp_byte1;
+		dhtResult.Humidity = Rh_byte1;
+	#endif
+
+	#if defined(TYPE_DHT22)
+		dhtResult.Temperature = ((Temp_byte1<<8)|Temp_byte2);
+		dhtResult.Humidity = ((Rh_byte1<<8)|Rh_byte2);
+	#endif
+	return 1;
 }
 
-uint8_t DHT_Check_Response (void)
+/* Stops the timer channels, hands the line back and publishes the result */
+static void DHT_Finish (void)
 {
-	uint8_t Response = 0;
-	delay (40);
-	if (!(HAL_GPIO_ReadPin (DHT_PORT, DHT_PIN)))
+	PROF_BEGIN(PROF_DHT_DECODE);
+	HAL_TIM_IC_Stop_IT(&DHT_TIM, TIM_CHANNEL_2);
+	HAL_TIM_OC_Stop_IT(&DHT_TIM, TIM_CHANNEL_1);
+
+	Presence = (dhtEdgeCount > 0);
+	if (dhtEdgeCount == DHT_EDGES && DHT_Decode())
 	{
-		delay (80);
-		if ((HAL_GPIO_ReadPin (DHT_PORT, DHT_PIN))) Response = 1;
-		else Response = -1;
+		dhtStatus = DHT_READY;
 	}
-	while ((HAL_GPIO_ReadPin (DHT_PORT, DHT_PIN)));   // wait for the pin to go low
-
-	return Response;
+	else
+	{
+		dhtStatus = DHT_FAILED;
+	}
+	PROF_END(PROF_DHT_DECODE);
 }
 
-uint8_t DHT_Read (void)
+/*
+ * Starts a reading and returns straight away. The line is pulled low here,
+ * released by the timer after DHT_START_US and the reply is captured in the
+ * TIM2 interrupt. Poll DHT_GetResult() for the outcome.
+ */
+void DHT_StartRead (void)
 {
-	uint8_t i,j;
-	for (j=0;j<8;j++)
-	{
-		while (!(HAL_GPIO_ReadPin (DHT_PORT, DHT_PIN)));   // wait for the pin to go high
-		delay (40);   // wait for 40 us
-		if (!(HAL_GPIO_ReadPin (DHT_PORT, DHT_PIN)))   // if the pin is low
-		{
-			i&= ~(1<<(7-j));   // write 0
-		}
-		else i|= (1<<(7-j));  // if the pin is high, write 1
-		while ((HAL_GPIO_ReadPin (DHT_PORT, DHT_PIN)));  // wait for the pin to go low
-	}
-	return i;
+	if (dhtStatus == DHT_BUSY) return;
+
+	dhtStatus = DHT_BUSY;
+	dhtReleased = 0;
+	dhtEdgeCount = 0;
+
+	Set_Pin_Output (DHT_PORT, DHT_PIN);  // set the pin as output
+	HAL_GPIO_WritePin (DHT_PORT, DHT_PIN, 0);   // pull the pin low
+
+	__HAL_TIM_SET_COMPARE(&DHT_TIM, TIM_CHANNEL_1, __HAL_TIM_GET_COUNTER(&DHT_TIM) + DHT_START_US);
+	__HAL_TIM_CLEAR_FLAG(&DHT_TIM, TIM_FLAG_CC1);
+	HAL_TIM_OC_Start_IT(&DHT_TIM, TIM_CHANNEL_1);
 }
 
+/*
+ * Returns DHT_BUSY while a reading is in flight. Once it has finished the
+ * outcome is returned exactly once (DHT_READY with DHT_Data filled in, or
+ * DHT_FAILED) and the driver goes back to DHT_IDLE.
+ */
+DHT_StatusTypedef DHT_GetResult (DHT_DataTypedef *DHT_Data)
+{
+	DHT_StatusTypedef status = dhtStatus;
+
+	if (status == DHT_READY) *DHT_Data = dhtResult;
+	if (status == DHT_READY || status == DHT_FAILED) dhtStatus = DHT_IDLE;
+	return status;
+}
 
+/*
+ * Returns 1 while a reading is in flight (TIM2 must keep its 1 us tick until then)
+ */
+uint8_t DHT_IsBusy (void)
+{
+	return dhtStatus == DHT_BUSY;
+}
 
+/*
+ * Blocking reading kept for callers that want the old behaviour. DHT_Data is
+ * left untouched if the sensor did not answer or the checksum failed.
+ */
 void DHT_GetData (DHT_DataTypedef *DHT_Data)
 {
-    DHT_Start ();
-	Presence = DHT_Check_Response ();
-	Rh_byte1 = DHT_Read ();
-	Rh_byte2 = DHT_Read ();
-	Temp_byte1 = DHT_Read ();
-	Temp_byte2 = DHT_Read ();
-	SUM = DHT_Read();
-
-	if (SUM == (Rh_byte1+Rh_byte2+Temp_byte1+Temp_byte2))
+	PROF_BEGIN(PROF_DHT_READ);
+	DHT_StartRead ();
+	while (DHT_GetResult (DHT_Data) == DHT_BUSY);
+	PROF_END(PROF_DHT_READ);
+}
+
+
+/* CH1 compare: end of the start pulse, then the frame timeout */
+void HAL_TIM_OC_DelayElapsedCallback (TIM_HandleTypeDef *htim)
+{
+	if (htim->Instance != DHT_TIM.Instance || htim->Channel != HAL_TIM_ACTIVE_CHANNEL_1) return;
+
+	if (!dhtReleased)
+	{
+		dhtReleased = 1;
+		Set_Pin_Capture (DHT_PORT, DHT_PIN);   // release the line and listen
+		__HAL_TIM_CLEAR_FLAG(&DHT_TIM, TIM_FLAG_CC2);
+		HAL_TIM_IC_Start_IT(&DHT_TIM, TIM_CHANNEL_2);
+		__HAL_TIM_SET_COMPARE(&DHT_TIM, TIM_CHANNEL_1, __HAL_TIM_GET_COUNTER(&DHT_TIM) + DHT_FRAME_TIMEOUT_US);
+	}
+	else
 	{
-		#if defined(TYPE_DHT11)
-			DHT_Data->Temperature = Temp_byte1;
-			DHT_Data->Humidity = Rh_byte1;
-		#endif
-
-		#if defined(TYPE_DHT22)
-			DHT_Data->Temperature = ((Temp_byte1<<8)|Temp_byte2);
-			DHT_Data->Humidity = ((Rh_byte1<<8)|Rh_byte2);
-		#endif
+		DHT_Finish ();   // timed out before the whole frame arrived
 	}
 }
 
+/* CH2 capture: one falling edge on the data line */
+void HAL_TIM_IC_CaptureCallback (TIM_HandleTypeDef *htim)
+{
+	if (htim->Instance != DHT_TIM.Instance || htim->Channel != HAL_TIM_ACTIVE_CHANNEL_2) return;
 
+	dhtEdges[dhtEdgeCount++] = HAL_TIM_ReadCapturedValue(htim, TIM_CHANNEL_2);
+	if (dhtEdgeCount == DHT_EDGES) DHT_Finish ();
+}
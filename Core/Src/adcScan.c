@@ -0,0 +1,201 @@
+/**
+  ******************************************************************************
+  * @file           : adcScan.c
+
+  * @brief          : continuous DMA scan of the three ADC1 inputs
+  * @date           : 17-10-2026
+  *
+  * Each TIM4 CH4 compare event starts one scan of ranks 1-3 (or, at rate 0,
+  * ADC1 free-runs back to back) and DMA2 Stream0 writes the results
+  * into a circular buffer split in two halves. Whenever a half fills up the
+  * DMA half/full-transfer callback averages it per channel and publishes the
+  * means, so there is no interrupt per conversion. Readers copy the published
+  * values with adc_scan_snapshot(), which uses a sequence counter to make sure
+  * the three values always come from the same block. The raw scans of each
+  * half are also handed to adc_scan_block_ready() (telemetry streams them).
+
+  ******************************************************************************
+  */
+
+#include "adcScan.h"
+
+extern ADC_HandleTypeDef hadc1;
+extern TIM_HandleTypeDef htim4;   // 1 MHz tick, see MX_TIM4_Init
+
+// Two halves of ADC_SCAN_DEPTH scans each, channels interleaved in rank order:
+static uint16_t adcDmaBuffer[2][ADC_SCAN_DEPTH][ADC_SCAN_CHANNELS];
+
+static volatile uint32_t adcSequence = 0; // odd while the snapshot is being written
+static adc_scan_snapshot_t adcPublished;
+
+static uint32_t adcRateHz = ADC_SCAN_RATE_HZ;
+static volatile adc_scan_irq_stats_t adcIrqStats;
+
+
+// FUNCTION      : adc_scan_start
+// DESCRIPTION   :
+//   Start the continuous scan. Values are available from adc_scan_snapshot()
+//   once the first half of the buffer has filled.
+// PARAMETERS    :
+//   none
+// RETURNS       :
+//   nothing
+void adc_scan_start(void)
+{
+	// IRQ time is measured with the cycle counter
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	if (adcRateHz == 0) {
+		hadc1.Init.ContinuousConvMode = ENABLE;
+		hadc1.Init.ExternalTrigConvEdge = ADC_EXTERNALTRIGCONVEDGE_NONE;
+		hadc1.Init.ExternalTrigConv = ADC_SOFTWARE_START;
+	} else {
+		hadc1.Init.ContinuousConvMode = DISABLE;
+		hadc1.Init.ExternalTrigConvEdge = ADC_EXTERNALTRIGCONVEDGE_RISING;
+		hadc1.Init.ExternalTrigConv = ADC_EXTERNALTRIGCONV_T4_CC4;
+	}
+	HAL_ADC_Init(&hadc1); // only rewrites CR1/CR2, the channel ranks are kept
+	HAL_ADC_Start_DMA(&hadc1, (uint32_t *)adcDmaBuffer, sizeof(adcDmaBuffer) / sizeof(uint16_t));
+
+	if (adcRateHz != 0) {
+		uint32_t period = 1000000 / adcRateHz;
+		if (period < 10) period = 10;          // a 3-channel scan takes ~8 us
+		if (period > 65536) period = 65536;    // 16-bit timer, ~16 Hz minimum
+		__HAL_TIM_SET_AUTORELOAD(&htim4, period - 1);
+		__HAL_TIM_SET_COMPARE(&htim4, TIM_CHANNEL_4, period / 2);
+		__HAL_TIM_SET_COUNTER(&htim4, 0);
+		HAL_TIM_PWM_Start(&htim4, TIM_CHANNEL_4);
+	}
+}
+
+
+// FUNCTION      : adc_scan_stop
+// DESCRIPTION   :
+//   Stop the scan. The last snapshot stays readable.
+// PARAMETERS    :
+//   none
+// RETURNS       :
+//   nothing
+void adc_scan_stop(void)
+{
+	HAL_TIM_PWM_Stop(&htim4, TIM_CHANNEL_4);
+	HAL_ADC_Stop_DMA(&hadc1);
+}
+
+
+// FUNCTION      : adc_scan_set_rate
+// DESCRIPTION   :
+//   Change how many scans per second are taken, restarting the scan.
+//   0 lets the ADC convert back to back as fast as it can.
+// PARAMETERS    :
+//   uint32_t hz : scans per second
+// RETURNS       :
+//   nothing
+void adc_scan_set_rate(uint32_t hz)
+{
+	adc_scan_stop();
+	adcRateHz = hz;
+	adc_scan_start();
+}
+
+
+uint32_t adc_scan_get_rate(void)
+{
+	return adcRateHz;
+}
+
+
+// FUNCTION      : adc_scan_irq_stats
+// DESCRIPTION   :
+//   Copy the running interrupt counters; diff two copies to get a rate.
+// PARAMETERS    :
+//   adc_scan_irq_stats_t *stats : where to store the counters
+// RETURNS       :
+//   nothing
+void adc_scan_irq_stats(adc_scan_irq_stats_t *stats)
+{
+	__disable_irq();
+	stats->irqCount = adcIrqStats.irqCount;
+	stats->irqCycles = adcIrqStats.irqCycles;
+	__enable_irq();
+}
+
+
+// Called at the end of the ADC and ADC DMA interrupt handlers
+void adc_scan_account_irq(uint32_t cycles)
+{
+	adcIrqStats.irqCount++;
+	adcIrqStats.irqCycles += cycles;
+}
+
+
+// FUNCTION      : adc_scan_snapshot
+// DESCRIPTION   :
+//   Copy the latest per-channel means. Safe to call at any time from thread
+//   context; retries if a DMA callback publishes new values mid-copy.
+// PARAMETERS    :
+//   adc_scan_snapshot_t *snapshot : where to store the values
+// RETURNS       :
+//   nothing
+void adc_scan_snapshot(adc_scan_snapshot_t *snapshot)
+{
+	uint32_t before, after;
+
+	do {
+		before = adcSequence;
+		__DMB();
+		*snapshot = adcPublished;
+		__DMB();
+		after = adcSequence;
+	} while ((before & 1) || before != after);
+}
+
+
+// Average one half of the DMA buffer and publish it
+static void adc_scan_publish(uint16_t (*block)[ADC_SCAN_CHANNELS])
+{
+	uint32_t sum[ADC_SCAN_CHANNELS] = {0};
+	uint8_t i, ch;
+
+	for (i = 0; i < ADC_SCAN_DEPTH; i++) {
+		for (ch = 0; ch < ADC_SCAN_CHANNELS; ch++) {
+			sum[ch] += block[i][ch];
+		}
+	}
+
+	adcSequence++;
+	__DMB();
+	for (ch = 0; ch < ADC_SCAN_CHANNELS; ch++) {
+		adcPublished.value[ch] = (uint16_t)(sum[ch] / ADC_SCAN_DEPTH);
+	}
+	adcPublished.blocks++;
+	__DMB();
+	adcSequence++;
+}
+
+
+// Called from the DMA interrupt with the ADC_SCAN_DEPTH raw scans of each
+// half-buffer, channels interleaved; does nothing unless overridden
+__weak void adc_scan_block_ready(const uint16_t *samples, uint16_t scans)
+{
+	UNUSED(samples);
+	UNUSED(scans);
+}
+
+
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
+{
+	if (hadc->Instance == ADC1) {
+		adc_scan_publish(adcDmaBuffer[0]);
+		adc_scan_block_ready(&adcDmaBuffer[0][0][0], ADC_SCAN_DEPTH);
+	}
+}
+
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+	if (hadc->Instance == ADC1) {
+		adc_scan_publish(adcDmaBuffer[1]);
+		adc_scan_block_ready(&adcDmaBuffer[1][0][0], ADC_SCAN_DEPTH);
+	}
+}
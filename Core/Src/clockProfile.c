@@ -0,0 +1,151 @@
+/**
+  ******************************************************************************
+  * @file           : clockProfile.c
+
+  * @brief          : run-time switchable system clock profiles
+  * @date           : 17-10-2026
+  *
+  * CLOCK_PROFILE_HIGH is the 100 MHz PLL configuration from
+  * SystemClock_Config(). CLOCK_PROFILE_LOW runs the core and every bus
+  * straight from the 16 MHz HSI with the PLL stopped and no flash wait states.
+  * The only thing the firmware does most of the time is wait for the next
+  * sensor reading, and that is much cheaper at 16 MHz.
+  *
+  * After each switch, everything that was derived from the old bus clocks is
+  * worked out again:
+  *   - SysTick: HAL_RCC_ClockConfig() re-runs HAL_InitTick() itself
+  *   - USART2 baud divider, for the same baud rate
+  *   - SPI2 prescaler, for the fastest OLED clock up to CLOCK_SPI2_MAX_HZ
+  *   - TIM2/TIM4 prescalers, so both keep counting microseconds and the
+  *     DHT11 timings (DHT.c) and ADC trigger period (adcScan.c) stay valid
+  * A switch is refused while a DHT11 reading or an OLED transfer is in
+  * flight, because both are timed in timer ticks or core cycles. Queued UART
+  * output is flushed first.
+
+  ******************************************************************************
+  */
+
+#include "main.h"
+#include "clockProfile.h"
+#include "uartTx.h"
+#include "ssd1331.h"
+#include "DHT.h"
+
+extern UART_HandleTypeDef huart2;   // VCP
+extern SPI_HandleTypeDef hspi2;     // OLED
+extern TIM_HandleTypeDef htim2;     // DHT11
+extern TIM_HandleTypeDef htim4;     // ADC trigger
+void SystemClock_Config(void);      // main.c
+
+static clock_profile_t clockProfile = CLOCK_PROFILE_HIGH;   // SystemClock_Config() at reset
+
+
+// 16 MHz HSI for SYSCLK and every bus, then stop the PLL
+static void clock_config_low(void)
+{
+	RCC_ClkInitTypeDef RCC_ClkInitStruct = {0};
+	RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+
+	RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK|RCC_CLOCKTYPE_SYSCLK
+								|RCC_CLOCKTYPE_PCLK1|RCC_CLOCKTYPE_PCLK2;
+	RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_HSI;
+	RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
+	RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV1;
+	RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV1;
+	if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_0) != HAL_OK) {
+		Error_Handler();
+	}
+
+	RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_NONE;
+	RCC_OscInitStruct.PLL.PLLState = RCC_PLL_OFF;
+	if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK) {
+		Error_Handler();
+	}
+}
+
+
+// Timers on APB1 run at twice PCLK1 unless APB1 is undivided
+static uint32_t clock_apb1_timer_hz(void)
+{
+	uint32_t pclk1 = HAL_RCC_GetPCLK1Freq();
+
+	return ((RCC->CFGR & RCC_CFGR_PPRE1) == RCC_HCLK_DIV1) ? pclk1 : 2 * pclk1;
+}
+
+
+// Re-derive the dividers of the peripherals that must keep their rates
+static void clock_update_peripherals(void)
+{
+	uint32_t pclk1 = HAL_RCC_GetPCLK1Freq();
+	uint32_t timerPsc = clock_apb1_timer_hz() / CLOCK_TIMER_TICK_HZ - 1;
+	uint32_t spiBr = 0;
+
+	huart2.Instance->BRR = UART_BRR_SAMPLING16(pclk1, huart2.Init.BaudRate);
+
+	// SPI prescalers go 2, 4, ... 256
+	while ((pclk1 >> (spiBr + 1)) > CLOCK_SPI2_MAX_HZ && spiBr < 7) {
+		spiBr++;
+	}
+	hspi2.Init.BaudRatePrescaler = spiBr << SPI_CR1_BR_Pos;
+	__HAL_SPI_DISABLE(&hspi2);      // re-enabled by the next transfer
+	MODIFY_REG(hspi2.Instance->CR1, SPI_CR1_BR, hspi2.Init.BaudRatePrescaler);
+
+	// An update event loads the new prescalers straight away (and restarts the counters)
+	htim2.Init.Prescaler = timerPsc;
+	htim2.Instance->PSC = timerPsc;
+	htim2.Instance->EGR = TIM_EGR_UG;
+	htim4.Init.Prescaler = timerPsc;
+	htim4.Instance->PSC = timerPsc;
+	htim4.Instance->EGR = TIM_EGR_UG;
+}
+
+
+// FUNCTION      : clock_set_profile
+// DESCRIPTION   :
+//   Switch the system clock to the given profile and re-derive the
+//   peripheral dividers.
+// PARAMETERS    :
+//   clock_profile_t profile : CLOCK_PROFILE_LOW or CLOCK_PROFILE_HIGH
+// RETURNS       :
+//   HAL_OK, or HAL_BUSY (nothing changed) while a DHT11 reading, an OLED
+//   transfer or queued UART output is in flight; try again once it's done
+HAL_StatusTypeDef clock_set_profile(clock_profile_t profile)
+{
+	if (profile == clockProfile) {
+		return HAL_OK;
+	}
+	// A byte being shifted out would be garbled by the new baud divider
+	if (DHT_IsBusy() || ssd1331_is_busy() || uart_tx_busy()) {
+		return HAL_BUSY;
+	}
+
+	clockProfile = profile;
+	clock_restore();
+	return HAL_OK;
+}
+
+
+clock_profile_t clock_get_profile(void)
+{
+	return clockProfile;
+}
+
+
+// FUNCTION      : clock_restore
+// DESCRIPTION   :
+//   Apply the current profile again, e.g. after Stop mode has left the core
+//   on the HSI with the PLL off. Doesn't wait for anything, so it can be
+//   called with interrupts masked.
+// PARAMETERS    :
+//   none
+// RETURNS       :
+//   nothing
+void clock_restore(void)
+{
+	if (clockProfile == CLOCK_PROFILE_HIGH) {
+		SystemClock_Config();
+	} else {
+		clock_config_low();
+	}
+	clock_update_peripherals();
+}
@@ -0,0 +1,218 @@
+/**
+  ******************************************************************************
+  * @file           : displayBench.c
+
+  * @brief          : timed standard workloads for the SSD1331 drawing calls
+  * @date           : 17-10-2026
+  *
+  * Each case calls one drawing primitive with a fixed workload, flushes and
+  * waits until the DMA queue and the controller are idle, so a run covers
+  * the whole cost of getting the pixels onto the panel. Time comes from the
+  * DWT cycle counter, SPI traffic from the driver's own counters. Runs
+  * alternate between two colours so every call really changes the screen.
+  *
+  * display_bench_run() prints one CSV line per case:
+  *   case,runs,us,spi_bytes,spi_xfers,pixels,px_per_s
+  * with per-call figures. The same code runs in the host build (host/), where
+  * the numbers come from the simulated board; tools/display_bench_compare.py
+  * compares two such tables.
+
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+
+#include "displayBench.h"
+#include "ssd1331.h"
+#include "oledChart.h"
+#include "oledUi.h"
+
+typedef struct {
+	const char *name;
+	void (*setup)(void);         // run by display_bench_setup(), may be NULL
+	void (*draw)(uint16_t run);
+	uint32_t pixels;
+} display_bench_case_t;
+
+static const uint8_t benchBitmap[32] = {       // 16x16, a frame with a cross
+	0xFF, 0xFF, 0xC0, 0x03, 0xA0, 0x05, 0x90, 0x09, 0x88, 0x11, 0x84, 0x21, 0x82, 0x41, 0x81, 0x81,
+	0x81, 0x81, 0x82, 0x41, 0x84, 0x21, 0x88, 0x11, 0x90, 0x09, 0xA0, 0x05, 0xC0, 0x03, 0xFF, 0xFF,
+};
+
+static oled_chart_t benchChart;
+static ui_widget_t benchField;
+
+
+static void bench_clear(uint16_t run)
+{
+	ssd1331_clear_screen((run & 1) ? BLUE : BLACK);
+}
+
+static void bench_fill_rect(uint16_t run)
+{
+	ssd1331_fill_rect(10, 10, 40, 20, (run & 1) ? GREEN : RED);
+}
+
+static void bench_string(uint16_t run)
+{
+	ssd1331_display_string(0, 16, "Humidity: 55 %", FONT_1206, (run & 1) ? YELLOW : WHITE);
+}
+
+static void bench_text(uint16_t run)
+{
+	ssd1331_display_text(0, 16, "Humidity: 55 %", FONT_1206, (run & 1) ? YELLOW : WHITE);
+}
+
+static void bench_circle(uint16_t run)
+{
+	ssd1331_draw_circle(48, 32, 20, (run & 1) ? CYAN : WHITE);
+}
+
+static void bench_bitmap(uint16_t run)
+{
+	ssd1331_draw_bitmap(40, 24, benchBitmap, 16, 16, (run & 1) ? PURPLE : WHITE);
+}
+
+// A full 96 x 32 chart, so every push shifts it
+static void bench_chart_setup(void)
+{
+	uint8_t i;
+
+	chart_init(&benchChart, 0, 32, 96, 32, 0, 100, GREEN);
+	for (i = 0; i < 96; i++) {
+		chart_push(&benchChart, i, 1);
+	}
+}
+
+static void bench_chart(uint16_t run)
+{
+	chart_push(&benchChart, (run & 1) ? 20 : 80, 1);
+}
+
+// The line of string_1206_14ch, already on the panel, of which one digit
+// changes per run: the update an oledUi value field makes instead
+static void bench_field_setup(void)
+{
+	ui_value_init(&benchField, 0, 16, 96, FONT_1206, "Humidity: %ld %%", WHITE);
+	ui_set_value(&benchField, 55);
+	ui_render(&benchField, 1);
+}
+
+static void bench_field(uint16_t run)
+{
+	ui_set_value(&benchField, (run & 1) ? 56 : 55);
+	ui_render(&benchField, 1);
+}
+
+static const display_bench_case_t benchCases[] = {
+	{ "clear_screen",     NULL,              bench_clear,     96 * 64 },
+	{ "fill_rect_40x20",  NULL,              bench_fill_rect, 40 * 20 },
+	{ "string_1206_14ch", NULL,              bench_string,    14 * 6 * 12 },
+	{ "text_1206_14ch",   NULL,              bench_text,      73 * 12 },   // ssd1331_text_width() of the string
+	{ "ui_value_1digit",  bench_field_setup, bench_field,     6 * 12 },    // one cell of the same line
+	{ "circle_r20",       NULL,              bench_circle,    112 },       // points the midpoint loop plots for r = 20
+	{ "bitmap_16x16",     NULL,              bench_bitmap,    16 * 16 },
+	{ "chart_push_96x32", bench_chart_setup, bench_chart,     96 * 32 },   // the whole plot moves
+};
+
+
+uint8_t display_bench_cases(void)
+{
+	return sizeof(benchCases) / sizeof(benchCases[0]);
+}
+
+
+// FUNCTION      : display_bench_setup
+// DESCRIPTION   :
+//   Put the panel in the state a case starts from (e.g. a full chart) and
+//   wait until that has been sent. Kept out of display_bench_case() so a
+//   caller can reset its own counters in between, as the host build does.
+// PARAMETERS    :
+//   uint8_t index                   : case, below display_bench_cases()
+// RETURNS       :
+//   nothing
+void display_bench_setup(uint8_t index)
+{
+	if (benchCases[index].setup != NULL) benchCases[index].setup();
+	ssd1331_flush();
+	ssd1331_wait_idle();
+}
+
+
+// FUNCTION      : display_bench_case
+// DESCRIPTION   :
+//   Run one case a number of times and average it, after
+//   display_bench_setup(). Anything still queued for the panel is sent
+//   first so it doesn't count against the case.
+// PARAMETERS    :
+//   uint8_t index                   : case, below display_bench_cases()
+//   uint16_t runs                   : calls to average over (at least 1)
+//   display_bench_result_t *result  : filled in
+// RETURNS       :
+//   nothing
+void display_bench_case(uint8_t index, uint16_t runs, display_bench_result_t *result)
+{
+	const display_bench_case_t *test = &benchCases[index];
+	uint32_t mhz = SystemCoreClock / 1000000, start, bytes, transfers;
+	uint64_t ns = 0;
+	uint16_t run;
+
+	if (runs == 0) runs = 1;
+	ssd1331_flush();
+	ssd1331_wait_idle();
+	ssd1331_reset_spi_counts();
+
+	for (run = runs; run-- > 0; ) {
+		start = DWT->CYCCNT;
+		test->draw(run);
+		ssd1331_flush();
+		ssd1331_wait_idle();
+		ns += (uint64_t)(DWT->CYCCNT - start) * 1000 / mhz;
+	}
+	ssd1331_get_spi_counts(&bytes, &transfers);
+
+	result->name = test->name;
+	result->runs = runs;
+	result->ns = (uint32_t)(ns / runs);
+	result->spiBytes = bytes / runs;
+	result->spiTransfers = transfers / runs;
+	result->pixels = test->pixels;
+	result->pixelsPerSec = ns ? (uint32_t)((uint64_t)test->pixels * runs * 1000000000ULL / ns) : 0;
+}
+
+
+void display_bench_print_header(uint16_t runs)
+{
+	printf("# display bench: %u runs per case at %lu MHz\n\r", runs, SystemCoreClock / 1000000);
+	printf("case,runs,us,spi_bytes,spi_xfers,pixels,px_per_s\n\r");
+}
+
+
+void display_bench_print(const display_bench_result_t *result)
+{
+	printf("%s,%u,%lu.%02lu,%lu,%lu,%lu,%lu\n\r", result->name, result->runs,
+			result->ns / 1000, (result->ns % 1000) / 10, result->spiBytes,
+			result->spiTransfers, result->pixels, result->pixelsPerSec);
+}
+
+
+// FUNCTION      : display_bench_run
+// DESCRIPTION   :
+//   Run every case and print the CSV table. Leaves the panel black.
+// PARAMETERS    :
+//   uint16_t runs : calls per case
+// RETURNS       :
+//   nothing
+void display_bench_run(uint16_t runs)
+{
+	display_bench_result_t result;
+	uint8_t index;
+
+	display_bench_print_header(runs);
+	for (index = 0; index < display_bench_cases(); index++) {
+		display_bench_setup(index);
+		display_bench_case(index, runs, &result);
+		display_bench_print(&result);
+	}
+	ssd1331_clear_screen(BLACK);
+}
@@ -0,0 +1,368 @@
+/**
+  ******************************************************************************
+  * @file           : flashLog.c
+
+  * @brief          : log-structured sensor history in flash sectors 6 and 7
+  * @date           : 17-10-2026
+  *
+  * The two 128 KB sectors at the top of flash (cut out of the FLASH region
+  * in STM32F411RETX_FLASH.ld) are used as one circular log. Records are
+  * delta-encoded into a page buffer in RAM (see sampleCodec.c, each page
+  * decodes on its own) and programmed a FLASH_LOG_PAGE_SIZE page at a time,
+  * when the encoded data fills the page or after FLASH_LOG_PAGE_RECORDS
+  * records. A page's commit word (boot number and record count) is
+  * programmed last and a CRC covers the data, so a page cut short by a reset
+  * is simply never committed and is skipped. Pages are only ever appended; when the active
+  * sector is full the other one (holding the oldest data) is erased and
+  * becomes the active one, so both sectors wear evenly.
+  *
+  * Page 0 of each sector holds a small header (sequence number and erase
+  * count) that is programmed right after the erase. The magic word goes last,
+  * so a sector whose erase or header was interrupted reads as unformatted.
+  * The boot scan looks at one word per page, plus the erased-check of the
+  * pages at the end of the active sector, so it finishes in a few ms.
+  *
+  * NOTE: the F411 has one flash bank, so the CPU stalls for the whole sector
+  * erase (~1-2 s, about once a day at one record a second) and, briefly,
+  * for each page program.
+
+  ******************************************************************************
+  */
+
+#include <string.h>
+
+#include "flashLog.h"
+
+#define FLASH_LOG_MAGIC     0x474F4C53UL   // "SLOG"
+#define FLASH_LOG_ERASED    0xFFFFFFFFUL
+#define FLASH_LOG_PAGES     (FLASH_LOG_SECTOR_SIZE / FLASH_LOG_PAGE_SIZE) // page 0 is the sector header
+
+// Start of each sector, and the sector numbers the HAL erases by
+static const uint32_t flashLogBase[FLASH_LOG_SECTOR_COUNT] = { 0x08040000UL, 0x08060000UL };
+static const uint32_t flashLogSector[FLASH_LOG_SECTOR_COUNT] = { FLASH_SECTOR_6, FLASH_SECTOR_7 };
+
+typedef struct {
+	uint32_t seq;                // higher = newer
+	uint32_t seqCheck;           // ~seq
+	uint32_t erases;             // times this sector has been erased
+	uint32_t magic;              // FLASH_LOG_MAGIC, programmed last
+} flash_log_header_t;
+
+typedef struct {
+	uint32_t commit;             // boot | record count << 16, programmed last
+	uint32_t crc;                // CRC-32 of data[]
+	uint8_t data[FLASH_LOG_PAGE_DATA]; // time, humidity, temperature and light, encoded
+} flash_log_page_t;
+
+typedef char flash_log_page_size_check[(sizeof(flash_log_page_t) == FLASH_LOG_PAGE_SIZE) ? 1 : -1];
+
+static uint8_t flashLogValid[FLASH_LOG_SECTOR_COUNT];
+static uint32_t flashLogSeq[FLASH_LOG_SECTOR_COUNT];
+static uint32_t flashLogErases[FLASH_LOG_SECTOR_COUNT];
+static uint32_t flashLogRecords[FLASH_LOG_SECTOR_COUNT]; // committed records per sector
+static uint8_t flashLogActive = 0;         // sector being appended to
+static uint16_t flashLogNextPage = 1;      // next page to program in it
+static uint16_t flashLogBoot = 1;
+static flash_log_page_t flashLogBuffer;    // page being filled in RAM
+static codec_writer_t flashLogWriter;      // encodes into flashLogBuffer.data
+
+
+#define FLASH_LOG_HEADER(s)     ((const flash_log_header_t *)flashLogBase[s])
+#define FLASH_LOG_PAGE(s, p)    ((const flash_log_page_t *)(flashLogBase[s] + (uint32_t)(p) * FLASH_LOG_PAGE_SIZE))
+
+
+// CRC-32 (IEEE, reflected), bit by bit; it only runs once per page
+static uint32_t flash_log_crc(const void *data, uint32_t len)
+{
+	const uint8_t *byte = data;
+	uint32_t crc = 0xFFFFFFFFUL;
+	uint8_t bit;
+
+	while (len--) {
+		crc ^= *byte++;
+		for (bit = 0; bit < 8; bit++) {
+			crc = (crc >> 1) ^ (0xEDB88320UL & -(crc & 1));
+		}
+	}
+	return ~crc;
+}
+
+
+static uint8_t flash_log_page_erased(uint8_t sector, uint16_t page)
+{
+	const uint32_t *word = (const uint32_t *)FLASH_LOG_PAGE(sector, page);
+	uint16_t i;
+
+	for (i = 0; i < FLASH_LOG_PAGE_SIZE / 4; i++) {
+		if (word[i] != FLASH_LOG_ERASED) return 0;
+	}
+	return 1;
+}
+
+
+// Program consecutive words; stops at the first failure
+static HAL_StatusTypeDef flash_log_program(uint32_t address, const uint32_t *words, uint16_t count)
+{
+	HAL_StatusTypeDef status = HAL_OK;
+
+	while (count-- && status == HAL_OK) {
+		status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address, *words++);
+		address += 4;
+	}
+	return status;
+}
+
+
+// Reading the log straight after programming must not hit stale cache lines
+static void flash_log_flush_cache(void)
+{
+	__HAL_FLASH_DATA_CACHE_DISABLE();
+	__HAL_FLASH_DATA_CACHE_RESET();
+	__HAL_FLASH_DATA_CACHE_ENABLE();
+}
+
+
+// Erase a sector and write its header
+static void flash_log_format(uint8_t sector, uint32_t seq)
+{
+	FLASH_EraseInitTypeDef erase = {0};
+	flash_log_header_t header;
+	uint32_t sectorError;
+
+	header.seq = seq;
+	header.seqCheck = ~seq;
+	header.erases = flashLogErases[sector] + 1;
+	header.magic = FLASH_LOG_MAGIC;
+
+	erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+	erase.Sector = flashLogSector[sector];
+	erase.NbSectors = 1;
+	erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+
+	HAL_FLASH_Unlock();
+	__HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR |
+			FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+	if (HAL_FLASHEx_Erase(&erase, &sectorError) == HAL_OK) {
+		flash_log_program(flashLogBase[sector], (const uint32_t *)&header, sizeof(header) / 4);
+	}
+	HAL_FLASH_Lock();
+	flash_log_flush_cache();
+
+	flashLogValid[sector] = (FLASH_LOG_HEADER(sector)->magic == FLASH_LOG_MAGIC);
+	flashLogSeq[sector] = seq;
+	flashLogErases[sector] = header.erases;
+	flashLogRecords[sector] = 0;
+}
+
+
+// FUNCTION      : flash_log_init
+// DESCRIPTION   :
+//   Find the newest sector, where to append in it, how many records are
+//   stored and the next boot number. Formats sector 6 on first use.
+// PARAMETERS    :
+//   none
+// RETURNS       :
+//   nothing
+void flash_log_init(void)
+{
+	uint16_t lastBoot = 0, page;
+	uint8_t s;
+
+	for (s = 0; s < FLASH_LOG_SECTOR_COUNT; s++) {
+		const flash_log_header_t *header = FLASH_LOG_HEADER(s);
+
+		flashLogValid[s] = (header->magic == FLASH_LOG_MAGIC && header->seqCheck == ~header->seq);
+		flashLogSeq[s] = flashLogValid[s] ? header->seq : 0;
+		flashLogErases[s] = flashLogValid[s] ? header->erases : 0;
+		flashLogRecords[s] = 0;
+		if (!flashLogValid[s]) continue;
+
+		for (page = 1; page < FLASH_LOG_PAGES; page++) {
+			uint32_t commit = FLASH_LOG_PAGE(s, page)->commit;
+			if (commit != FLASH_LOG_ERASED) {
+				flashLogRecords[s] += commit >> 16;
+				if ((uint16_t)commit > lastBoot) lastBoot = (uint16_t)commit;
+			}
+		}
+	}
+	flashLogBoot = (lastBoot >= 0xFFFE) ? 1 : lastBoot + 1;
+
+	if (!flashLogValid[0] && !flashLogValid[1]) {
+		flash_log_format(0, 1);
+	}
+	flashLogActive = (flashLogValid[1] && (!flashLogValid[0] || flashLogSeq[1] > flashLogSeq[0])) ? 1 : 0;
+
+	// Append after the last page that isn't blank (committed or cut short)
+	for (page = FLASH_LOG_PAGES; page > 1; page--) {
+		if (!flash_log_page_erased(flashLogActive, page - 1)) break;
+	}
+	flashLogNextPage = page;
+
+	memset(&flashLogBuffer, 0xFF, sizeof(flashLogBuffer));
+	codec_writer_init(&flashLogWriter, flashLogBuffer.data, FLASH_LOG_PAGE_DATA, 3);
+}
+
+
+static uint8_t flash_log_encode(const flash_log_record_t *record)
+{
+	int32_t value[3];
+
+	value[0] = record->humidity;
+	value[1] = record->temperature;
+	value[2] = record->light;
+	return codec_write(&flashLogWriter, record->time, value);
+}
+
+
+// FUNCTION      : flash_log_append
+// DESCRIPTION   :
+//   Encode a record into the RAM page; the page is programmed once it's full.
+// PARAMETERS    :
+//   const flash_log_record_t *record : the record
+// RETURNS       :
+//   nothing
+void flash_log_append(const flash_log_record_t *record)
+{
+	if (flashLogWriter.count >= FLASH_LOG_PAGE_RECORDS || !flash_log_encode(record)) {
+		flash_log_sync();
+		if (flashLogWriter.count > 0) return;   // programming failed, the record is lost
+		flash_log_encode(record);
+	}
+	if (flashLogWriter.count >= FLASH_LOG_PAGE_RECORDS) {
+		flash_log_sync();
+	}
+}
+
+
+// FUNCTION      : flash_log_sync
+// DESCRIPTION   :
+//   Program the records buffered in RAM as one page (a partly filled one if
+//   called early), moving to the other sector first if this one is full.
+// PARAMETERS    :
+//   none
+// RETURNS       :
+//   nothing
+void flash_log_sync(void)
+{
+	uint32_t address;
+	HAL_StatusTypeDef status;
+
+	if (flashLogWriter.count == 0) return;
+
+	if (flashLogNextPage >= FLASH_LOG_PAGES) {
+		uint8_t other = 1 - flashLogActive;
+		flash_log_format(other, flashLogSeq[flashLogActive] + 1);
+		flashLogActive = other;
+		flashLogNextPage = 1;
+	}
+
+	flashLogBuffer.crc = flash_log_crc(flashLogBuffer.data, sizeof(flashLogBuffer.data));
+	flashLogBuffer.commit = flashLogBoot | ((uint32_t)flashLogWriter.count << 16);
+	address = flashLogBase[flashLogActive] + (uint32_t)flashLogNextPage * FLASH_LOG_PAGE_SIZE;
+
+	HAL_FLASH_Unlock();
+	__HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR |
+			FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+	status = flash_log_program(address + 4, &flashLogBuffer.crc, (sizeof(flashLogBuffer) - 4) / 4);
+	if (status == HAL_OK) {
+		status = flash_log_program(address, &flashLogBuffer.commit, 1);
+	}
+	HAL_FLASH_Lock();
+	flash_log_flush_cache();
+
+	flashLogNextPage++;   // a failed page is left uncommitted and skipped
+	if (status == HAL_OK) {
+		flashLogRecords[flashLogActive] += flashLogWriter.count;
+		memset(&flashLogBuffer, 0xFF, sizeof(flashLogBuffer));
+		codec_writer_init(&flashLogWriter, flashLogBuffer.data, FLASH_LOG_PAGE_DATA, 3);
+	}
+}
+
+
+void flash_log_info(flash_log_info_t *info)
+{
+	uint8_t s;
+
+	info->records = 0;
+	for (s = 0; s < FLASH_LOG_SECTOR_COUNT; s++) {
+		info->records += flashLogRecords[s];
+		info->erases[s] = flashLogErases[s];
+	}
+	info->pending = flashLogWriter.count;
+	info->boot = flashLogBoot;
+}
+
+
+// FUNCTION      : flash_log_dump_begin
+// DESCRIPTION   :
+//   Start reading the committed records back, oldest first. Records still
+//   in RAM aren't included; call flash_log_sync() first for those.
+// PARAMETERS    :
+//   flash_log_cursor_t *cursor : position to initialise
+// RETURNS       :
+//   nothing
+void flash_log_dump_begin(flash_log_cursor_t *cursor)
+{
+	uint8_t older = 1 - flashLogActive;
+
+	cursor->sector = (flashLogValid[older] && flashLogSeq[older] < flashLogSeq[flashLogActive]) ? older : flashLogActive;
+	cursor->page = 1;
+	cursor->left = 0;
+	cursor->done = 0;
+}
+
+
+// FUNCTION      : flash_log_dump_next
+// DESCRIPTION   :
+//   Read the next committed record, skipping pages that fail their CRC.
+// PARAMETERS    :
+//   flash_log_cursor_t *cursor   : position from flash_log_dump_begin
+//   uint16_t *boot               : boot the record was logged in
+//   flash_log_record_t *record   : the record
+// RETURNS       :
+//   1 if a record was read, 0 at the end of the log
+uint8_t flash_log_dump_next(flash_log_cursor_t *cursor, uint16_t *boot, flash_log_record_t *record)
+{
+	uint32_t time;
+	int32_t value[3];
+
+	while (!cursor->done) {
+		if (cursor->left > 0) {
+			if (codec_read(&cursor->reader, &time, value)) {
+				cursor->left--;
+				*boot = (uint16_t)FLASH_LOG_PAGE(cursor->sector, cursor->page)->commit;
+				record->time = time;
+				record->humidity = (uint8_t)value[0];
+				record->temperature = (int8_t)value[1];
+				record->light = (uint16_t)value[2];
+				if (cursor->left == 0) cursor->page++;
+				return 1;
+			}
+			cursor->left = 0;   // shouldn't happen once the CRC matched
+			cursor->page++;
+		}
+
+		uint16_t lastPage = (cursor->sector == flashLogActive) ? flashLogNextPage : FLASH_LOG_PAGES;
+
+		if (cursor->page >= lastPage) {
+			if (cursor->sector == flashLogActive) {
+				cursor->done = 1;
+			} else {
+				cursor->sector = flashLogActive;
+				cursor->page = 1;
+			}
+			continue;
+		}
+
+		// Start on the next committed page with a good CRC
+		const flash_log_page_t *page = FLASH_LOG_PAGE(cursor->sector, cursor->page);
+		if (page->commit == FLASH_LOG_ERASED || page->crc != flash_log_crc(page->data, sizeof(page->data))) {
+			cursor->page++;
+			continue;
+		}
+		cursor->left = page->commit >> 16;
+		codec_reader_init(&cursor->reader, page->data, sizeof(page->data), 3);
+		if (cursor->left == 0) cursor->page++;
+	}
+	return 0;
+}
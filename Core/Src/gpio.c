@@ -62,12 +62,6 @@ void MX_GPIO_Init(void)
   GPIO_InitStruct.Pull = GPIO_NOPULL;
   HAL_GPIO_Init(B0_GPIO_Port, &GPIO_InitStruct);
 
-  /*Configure GPIO pin : DHT11_Pin */
-  GPIO_InitStruct.Pin = DHT11_Pin;
-  GPIO_InitStruct.Mode = GPIO_MODE_INPUT;
-  GPIO_InitStruct.Pull = GPIO_NOPULL;
-  HAL_GPIO_Init(DHT11_GPIO_Port, &GPIO_InitStruct);
-
   /*Configure GPIO pin : ANALOG_OUT_Pin */
   GPIO_InitStruct.Pin = ANALOG_OUT_Pin;
   GPIO_InitStruct.Mode = GPIO_MODE_ANALOG;
@@ -0,0 +1,115 @@
+/**
+  ******************************************************************************
+  * @file           : logger.c
+
+  * @brief          : tokenized logging: call sites store a format id and raw
+  *                   arguments, formatting happens later
+  * @date           : 17-10-2026
+  *
+  * A LOG_* call only copies a few words into a RAM ring (with interrupts
+  * masked, so it works from ISRs too) and posts EVENT_LOG:
+  *   word 0 : format id | argument count << 16 | level << 20 | module << 24
+  *   word 1 : HAL tick
+  *   then one word per argument
+  * The format id is the offset of the format string in the .log_fmt section
+  * (see the linker scripts), so the string itself never moves. log_task(),
+  * registered after the other tasks so it runs once they're done, either
+  * printf's the entries or sends them as TELEMETRY_FRAME_LOG frames, which
+  * tools/telemetry_decode.py formats using the strings it reads out of the
+  * .elf. An entry that doesn't fit in the ring is dropped and counted.
+
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+
+#include "logger.h"
+#include "telemetry.h"
+#include "scheduler.h"
+#include "main.h"
+
+extern const char __log_fmt_start[];   // start of .log_fmt, from the linker script
+
+static uint32_t logRing[LOG_RING_WORDS];
+static volatile uint16_t logHead = 0;     // next free word
+static volatile uint16_t logTail = 0;     // first word of the oldest entry
+static volatile uint32_t logDropped = 0;
+
+#define LOG_USED()   ((uint16_t)((logHead + LOG_RING_WORDS - logTail) % LOG_RING_WORDS))
+
+
+// FUNCTION      : log_write
+// DESCRIPTION   :
+//   Queue a log entry. Called through the LOG_* macros.
+// PARAMETERS    :
+//   const char *fmt      : format string in .log_fmt
+//   uint8_t level        : LOG_LEVEL_*
+//   uint8_t module       : LOG_MODULE_*
+//   const uint32_t *args : arguments
+//   uint8_t count        : number of arguments, up to LOG_MAX_ARGS
+// RETURNS       :
+//   nothing
+void log_write(const char *fmt, uint8_t level, uint8_t module, const uint32_t *args, uint8_t count)
+{
+	uint32_t primask, header;
+	uint8_t i;
+
+	header = (uint32_t)(fmt - __log_fmt_start) | ((uint32_t)count << 16) | ((uint32_t)level << 20)
+			| ((uint32_t)module << 24);
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	if (LOG_RING_WORDS - 1 - LOG_USED() < 2 + count) {
+		logDropped++;
+	} else {
+		logRing[logHead] = header;
+		logRing[(logHead + 1) % LOG_RING_WORDS] = HAL_GetTick();
+		for (i = 0; i < count; i++) {
+			logRing[(logHead + 2 + i) % LOG_RING_WORDS] = args[i];
+		}
+		logHead = (logHead + 2 + count) % LOG_RING_WORDS;
+	}
+	__set_PRIMASK(primask);
+
+	sched_post(EVENT_LOG);
+}
+
+
+// FUNCTION      : log_task
+// DESCRIPTION   :
+//   Scheduler task for EVENT_LOG: takes the queued entries out of the ring
+//   and prints them, or sends them as binary frames (see LOG_OUTPUT).
+// PARAMETERS    :
+//   none
+// RETURNS       :
+//   nothing
+void log_task(void)
+{
+	uint32_t header, tick, args[LOG_MAX_ARGS] = {0};
+	uint8_t count, i;
+
+	while (logTail != logHead) {
+		// Entries are only ever added at the head, so the tail side can be read without masking
+		header = logRing[logTail];
+		tick = logRing[(logTail + 1) % LOG_RING_WORDS];
+		count = (header >> 16) & 0x0F;
+		for (i = 0; i < count && i < LOG_MAX_ARGS; i++) {
+			args[i] = logRing[(logTail + 2 + i) % LOG_RING_WORDS];
+		}
+		logTail = (logTail + 2 + count) % LOG_RING_WORDS;
+
+		if (LOG_OUTPUT == LOG_OUTPUT_BINARY || telemetry_get_mode() != TELEMETRY_OFF) {
+			telemetry_send_log(tick, (uint16_t)header, (header >> 20) & 0x0F, header >> 24, args, count);
+		} else {
+			printf(__log_fmt_start + (uint16_t)header, args[0], args[1], args[2], args[3],
+					args[4], args[5], args[6], args[7], args[8], args[9]);
+			printf("\n\r");
+		}
+	}
+}
+
+
+uint32_t log_dropped(void)
+{
+	return logDropped;
+}
@@ -0,0 +1,274 @@
+/**
+  ******************************************************************************
+  * @file           : lowPower.c
+
+  * @brief          : idle policy for the scheduler (Sleep / Stop with RTC wake-up)
+  * @date           : 17-10-2026
+  *
+  * Replaces the scheduler's default sched_idle(). Short gaps between tasks
+  * are spent in Sleep (WFI), where every peripheral keeps running and the next
+  * interrupt wakes the core. For gaps of LP_STOP_MIN_MS or more the core goes
+  * to Stop mode, where the PLL and all bus clocks are off. It is woken either
+  * by the RTC wake-up timer, armed to go off when the next task is due, or by
+  * a start bit on the USART2 RX pin. On the way out clock_restore() brings
+  * back the clock profile that was in use and the time spent in Stop, read
+  * from the RTC, is added to the HAL tick so the scheduler's deadlines stay
+  * right.
+  *
+  * The RTC is set up at register level (the RTC HAL isn't part of this
+  * project) and runs from the LSI. Because the LSI is only specified to
+  * +-50 %, lp_init() measures it against the HAL tick once.
+  *
+  * Stop is skipped while the UART or the OLED DMA still has data in flight,
+  * or while TIM2 is timing a DHT11 reading.
+  * The key press that wakes the core from Stop is lost (the UART had no
+  * clock), so it stays out of Stop for LP_RX_AWAKE_MS afterwards, which keeps
+  * the console usable while someone is typing. Since the firmware is driven
+  * from that console, Stop is off by default (LP_MODE) and has to be allowed
+  * with 'd' in the duty cycle report.
+
+  ******************************************************************************
+  */
+
+#include "lowPower.h"
+#include "scheduler.h"
+#include "adcScan.h"
+#include "uartTx.h"
+#include "ssd1331.h"
+#include "clockProfile.h"
+#include "DHT.h"
+
+extern UART_HandleTypeDef huart2; // VCP
+
+#define LP_RTC_PREDIV_A     31      // LSI / 32 = ~1 kHz into the sub-second counter
+#define LP_RTC_PREDIV_S     999     // ~1 kHz / 1000 = ~1 Hz calendar
+#define LP_RTC_WRAP         (3600UL * (LP_RTC_PREDIV_S + 1)) // lp_rtc_count() wraps every hour
+#define LP_CAL_MS           200     // LSI measurement time at start-up
+
+static lp_mode_t lpMode = LP_MODE;
+static uint32_t lpRtcHz = 1000;         // sub-second counts per real second, measured
+static uint32_t lpRxWakeTick = 0;       // HAL tick of the last key press that ended a Stop
+static uint32_t lpMark = 0;             // DWT cycle count when the core last woke up
+static lp_stats_t lpStats;
+
+
+// Cycles at the current core clock to microseconds
+static uint32_t lp_us(uint32_t cycles)
+{
+	return cycles / (SystemCoreClock / 1000000);
+}
+
+
+// Sub-second ticks since the top of the RTC hour. The shadow registers are
+// bypassed (they would need a resync after Stop), so read until SSR is stable.
+static uint32_t lp_rtc_count(void)
+{
+	uint32_t ssr, tr, seconds;
+
+	do {
+		ssr = RTC->SSR;
+		tr = RTC->TR;
+	} while (ssr != RTC->SSR);
+
+	seconds = (((tr & RTC_TR_MNT) >> RTC_TR_MNT_Pos) * 10 + ((tr & RTC_TR_MNU) >> RTC_TR_MNU_Pos)) * 60
+			+ ((tr & RTC_TR_ST) >> RTC_TR_ST_Pos) * 10 + ((tr & RTC_TR_SU) >> RTC_TR_SU_Pos);
+	return seconds * (LP_RTC_PREDIV_S + 1) + (LP_RTC_PREDIV_S - ssr);
+}
+
+
+static uint32_t lp_rtc_elapsed(uint32_t start)
+{
+	return (lp_rtc_count() + LP_RTC_WRAP - start) % LP_RTC_WRAP;
+}
+
+
+static void lp_clear_wakeup_flags(void)
+{
+	RTC->ISR = (~(RTC_ISR_WUTF | RTC_ISR_INIT) & 0x0001FFFFU) | (RTC->ISR & RTC_ISR_INIT);
+	EXTI->PR = EXTI_PR_PR22 | EXTI_PR_PR3;
+}
+
+
+// Add the time since lpMark to the active total
+static void lp_fold_active(uint32_t now)
+{
+	lpStats.activeUs += lp_us(now - lpMark);
+	lpMark = now;
+}
+
+
+// FUNCTION      : lp_init
+// DESCRIPTION   :
+//   Start the RTC on the LSI, measure the LSI, and route the RTC wake-up
+//   timer (EXTI 22) and USART2 RX (PA3, EXTI 3) to wake-up interrupts.
+//   Takes LP_CAL_MS. Call after the HAL tick and DWT are running.
+// PARAMETERS    :
+//   none
+// RETURNS       :
+//   nothing
+void lp_init(void)
+{
+	uint32_t start, count;
+
+	__HAL_RCC_PWR_CLK_ENABLE();
+	HAL_PWR_EnableBkUpAccess();
+	RCC->CSR |= RCC_CSR_LSION;
+	while ((RCC->CSR & RCC_CSR_LSIRDY) == 0);
+	if ((RCC->BDCR & RCC_BDCR_RTCSEL) != RCC_BDCR_RTCSEL_1) {
+		// the RTC clock source can only be changed after a backup domain reset
+		RCC->BDCR |= RCC_BDCR_BDRST;
+		RCC->BDCR &= ~RCC_BDCR_BDRST;
+		RCC->BDCR |= RCC_BDCR_RTCSEL_1;    // LSI
+	}
+	RCC->BDCR |= RCC_BDCR_RTCEN;
+
+	RTC->WPR = 0xCA;
+	RTC->WPR = 0x53;
+	RTC->ISR = 0xFFFFFFFFU;                // enter init mode, the flags are rc_w0
+	while ((RTC->ISR & RTC_ISR_INITF) == 0);
+	RTC->PRER = LP_RTC_PREDIV_S;           // two separate writes, synchronous part first
+	RTC->PRER |= LP_RTC_PREDIV_A << RTC_PRER_PREDIV_A_Pos;
+	RTC->TR = 0;
+	RTC->CR = RTC_CR_BYPSHAD;              // wake-up timer clock (WUCKSEL) = RTC / 16
+	RTC->ISR &= ~RTC_ISR_INIT;
+	RTC->WPR = 0xFF;
+
+	EXTI->RTSR |= EXTI_RTSR_TR22;
+	EXTI->IMR |= EXTI_IMR_MR22;
+	__HAL_RCC_SYSCFG_CLK_ENABLE();
+	SYSCFG->EXTICR[0] = (SYSCFG->EXTICR[0] & ~SYSCFG_EXTICR1_EXTI3) | SYSCFG_EXTICR1_EXTI3_PA;
+	HAL_NVIC_SetPriority(RTC_WKUP_IRQn, 0, 0);
+	HAL_NVIC_EnableIRQ(RTC_WKUP_IRQn);
+	HAL_NVIC_SetPriority(EXTI3_IRQn, 0, 0);
+	HAL_NVIC_EnableIRQ(EXTI3_IRQn);
+
+	// Measure the LSI against the HAL tick
+	start = HAL_GetTick();
+	while (HAL_GetTick() == start);
+	start = HAL_GetTick();
+	count = lp_rtc_count();
+	while (HAL_GetTick() - start < LP_CAL_MS);
+	lpRtcHz = lp_rtc_elapsed(count) * 1000 / LP_CAL_MS;
+
+	lpMark = DWT->CYCCNT;
+}
+
+
+void lp_set_mode(lp_mode_t mode)
+{
+	lpMode = mode;
+}
+
+
+lp_mode_t lp_get_mode(void)
+{
+	return lpMode;
+}
+
+
+// FUNCTION      : lp_stats
+// DESCRIPTION   :
+//   Copy the running time totals, including the current active stretch.
+// PARAMETERS    :
+//   lp_stats_t *stats : where to store the totals
+// RETURNS       :
+//   nothing
+void lp_stats(lp_stats_t *stats)
+{
+	lp_fold_active(DWT->CYCCNT);
+	*stats = lpStats;
+}
+
+
+// Both wake-up sources only need their flags cleared, the work is done in lp_stop()
+void lp_wakeup_irq_handler(void)
+{
+	lp_clear_wakeup_flags();
+}
+
+
+// Stop mode until the RTC wake-up timer or a key press, then restore the clocks
+static void lp_stop(uint32_t idleMs)
+{
+	uint32_t ticks, start, sleptMs;
+
+	if (idleMs > LP_STOP_MAX_MS) idleMs = LP_STOP_MAX_MS;
+	ticks = (uint32_t)((uint64_t)idleMs * 2 * lpRtcHz / 1000);   // RTC / 16 = 2 x sub-second rate
+	if (ticks > 0x10000) ticks = 0x10000;
+	if (ticks == 0) ticks = 1;
+
+	adc_scan_stop();    // TIM4 stops in Stop anyway, and the ADC would keep drawing current
+
+	RTC->WPR = 0xCA;
+	RTC->WPR = 0x53;
+	RTC->CR &= ~(RTC_CR_WUTE | RTC_CR_WUTIE);
+	while ((RTC->ISR & RTC_ISR_WUTWF) == 0);
+	RTC->WUTR = ticks - 1;
+	RTC->CR |= RTC_CR_WUTE | RTC_CR_WUTIE;
+	RTC->WPR = 0xFF;
+	lp_clear_wakeup_flags();
+	EXTI->FTSR |= EXTI_FTSR_TR3;    // start bit on USART2 RX
+	EXTI->IMR |= EXTI_IMR_MR3;
+
+	start = lp_rtc_count();
+	HAL_SuspendTick();
+	HAL_PWR_EnterSTOPMode(PWR_LOWPOWERREGULATOR_ON, PWR_STOPENTRY_WFI);
+	clock_restore();                // Stop leaves the core on the 16 MHz HSI
+	HAL_ResumeTick();
+
+	if (EXTI->PR & EXTI_PR_PR3) {
+		lpRxWakeTick = HAL_GetTick();
+		// The character that woke us was clocked in without a UART clock; wait
+		// for it to finish (~90 us at 115200) and throw it away
+		uint32_t wait = DWT->CYCCNT;
+		while (DWT->CYCCNT - wait < SystemCoreClock / 5000);
+		__HAL_UART_CLEAR_PEFLAG(&huart2);    // reads SR then DR: clears RXNE, ORE, FE and NE
+	}
+	EXTI->IMR &= ~EXTI_IMR_MR3;
+	EXTI->FTSR &= ~EXTI_FTSR_TR3;
+	RTC->WPR = 0xCA;
+	RTC->WPR = 0x53;
+	RTC->CR &= ~(RTC_CR_WUTE | RTC_CR_WUTIE);
+	RTC->WPR = 0xFF;
+	lp_clear_wakeup_flags();
+	HAL_NVIC_ClearPendingIRQ(RTC_WKUP_IRQn);
+	HAL_NVIC_ClearPendingIRQ(EXTI3_IRQn);
+
+	// SysTick didn't count while stopped
+	sleptMs = lp_rtc_elapsed(start) * 1000 / lpRtcHz;
+	uwTick += sleptMs;
+	lpStats.stopUs += sleptMs * 1000;
+	lpStats.stops++;
+
+	adc_scan_start();
+}
+
+
+// FUNCTION      : sched_idle
+// DESCRIPTION   :
+//   Scheduler idle hook (see scheduler.c), called with interrupts masked.
+//   Uses the deepest state lpMode and the length of the gap allow.
+// PARAMETERS    :
+//   uint32_t idleMs : ms until the next timed task, SCHED_IDLE_FOREVER if none
+// RETURNS       :
+//   nothing
+void sched_idle(uint32_t idleMs)
+{
+	uint32_t now = DWT->CYCCNT;
+
+	if (lpMode == LP_RUN) {
+		// spin; fold about once a millisecond so the cycle counter can't wrap
+		if (now - lpMark >= SystemCoreClock / 1000) lp_fold_active(now);
+		return;
+	}
+	lp_fold_active(now);
+
+	if (lpMode == LP_STOP && idleMs >= LP_STOP_MIN_MS && HAL_GetTick() - lpRxWakeTick >= LP_RX_AWAKE_MS
+			&& !uart_tx_busy() && !ssd1331_is_busy() && !DHT_IsBusy()) {
+		lp_stop(idleMs);
+	} else {
+		__WFI();
+		lpStats.sleepUs += lp_us(DWT->CYCCNT - now);
+	}
+	lpMark = DWT->CYCCNT;
+}
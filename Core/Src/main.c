@@ -15,7 +15,7 @@
 *    		+ Humidity (1-2 DHT11 sensors) - pulses
 *    	- Periodically check if sensors are working correctly (watchdog timer? Check values?)
 *    		+ If not working properly/disconnected, prompt user to manually restart system
-*    	- Store sensor data (e.g. in big array OR circular buffer)
+*    	- Store sensor data in circular buffers with rolling statistics (sensorHistory.c)
 *    	- Display average sensor status on OLED
 *    		+ But we can see more detailed values on terminal
 *    		+ Screen can refresh at same rate as mold risk evaluation
@@ -52,6 +52,7 @@
 /* Includes ------------------------------------------------------------------*/
 #include "main.h"
 #include "adc.h"
+#include "dma.h"
 #include "spi.h"
 #include "tim.h"
 #include "usart.h"
@@ -63,6 +64,8 @@
 #include <stdio.h>
 #include <string.h> // string manipulation (where necessary)
 #include "userInput.h" // to get user's character input from terminal
+#include "uartRx.h" // interrupt-driven receive buffer behind it
+#include "uartTx.h" // DMA transmit buffer behind printf
 
 #include "debounce.h" // push button debouncing (TEMP - to remove)
 
@@ -71,11 +74,52 @@
 // For OLED:
 #include "ssd1331.h"
 #include "fonts.h"
+
+// For ADC:
+#include "adcScan.h" // DMA-scanned analog inputs
+
+#include "scheduler.h" // run-to-completion tasks
+#include "lowPower.h" // Sleep/Stop while no task is ready
+#include "clockProfile.h" // 16 MHz while sensing, 100 MHz while drawing
+#include "sensorHistory.h" // last readings + windowed mean/min/max
+#include "flashLog.h" // every reading, kept in flash across resets
+#include "telemetry.h" // binary frames for a host tool instead of printf lines
+#include "logger.h" // periodic reports, formatted after the tasks have run
+#include "profiler.h" // cycle counts of the main tasks, drivers and ISRs
+#include "displayBench.h" // timed workloads for the OLED drawing calls
+#include "oledChart.h" // strip charts scrolled with the OLED's copy command
+#include "oledUi.h" // status screens redrawn only where they changed
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
 /* USER CODE BEGIN PTD */
-
+// What the terminal is currently used for (decides how typed keys are handled):
+typedef enum {
+	MODE_MENU,        // waiting for a menu option
+	MODE_DHT,         // DHT11 test
+	MODE_ADC_CONFIRM, // ADC test, waiting for 'Y'
+	MODE_ADC,         // ADC test
+	MODE_ADC_SCAN,    // ADC DMA scan test
+	MODE_MOLD,        // mold risk evaluation
+	MODE_POWER,       // duty cycle report
+	MODE_DUMP,        // flash log dump
+	MODE_TELEMETRY,   // binary telemetry stream
+	MODE_CHART        // humidity and light strip charts on the OLED
+} consoleMode_t;
+
+// Widgets of the OLED status screens:
+enum {
+	DHT_UI_TEMP,
+	DHT_UI_HUMIDITY,
+	DHT_UI_HUMIDITY_BAR,
+	DHT_UI_WIDGETS
+};
+enum {
+	MOLD_UI_HUMIDITY,
+	MOLD_UI_LIGHT,
+	MOLD_UI_STATUS,   // warning banner on the bottom half
+	MOLD_UI_WIDGETS
+};
 /* USER CODE END PTD */
 
 /* Private define ------------------------------------------------------------*/
@@ -88,9 +132,16 @@
 #define SOLAR_HIGH 1700 // >= this val -> high sunlight. Risk = LOW sunlight
 #define HUMIDITY_HIGH 65.0f // >= this val -> high humidity. Risk = HIGH humidity
 
-// Sync read intervals for all sensors:
-#define DHT_READ_INTERVAL 1000 // ms
-#define ADC_READ_INTERVAL 1000 // ms
+// Sync read interval for all sensors (ADC is sampled with each DHT11 reading):
+#define SENSOR_READ_INTERVAL 1000 // ms. IMPORTANT: DHT11 can't handle intervals lower than 1000 ms
+#define DHT_RESULT_DELAY 30 // ms, 18 ms start pulse + ~5 ms frame
+#define DHT_RETRY_DELAY 5 // ms, if the frame isn't in yet
+
+#define DUMP_LINES_PER_RUN 32 // flash log lines printed per dumpTask run
+
+// Strip charts, one sample per reading: humidity on the top half, light below
+#define CHART_HUMIDITY_MAX 100 // %RH at the top row
+#define CHART_LIGHT_MAX 4095 // ADC value at the top row
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -105,11 +156,22 @@
 DHT_DataTypedef DHT11_Data; // Look in the DHT.h for the definition
 float Temperature, Humidity;
 
-// ADC (solar) values for interrupt:
-volatile uint32_t latestAdcValue = 0;
-volatile uint8_t adcUpdated = 0;
-uint32_t latestDhtReadtime = 0; // to sync with ADC reading
-uint32_t latestAdcReadtime = 0;
+uint8_t dhtOk = 0; // 0 if the last DHT11 reading failed
+uint32_t LightLevel = 0; // solar panel ADC value taken with the last DHT11 reading
+int8_t moldRisk = 0; // latest riskTask verdict
+
+// Console:
+consoleMode_t consoleMode = MODE_MENU;
+int8_t adcReportId = -1; // scheduler id of adcReportTask
+uint32_t adcReportTime = 0; // time & IRQ counters of the last ADC report
+adc_scan_irq_stats_t adcReportStats;
+uint8_t heldOutOfStop = 0; // 1 if a test needing the ADC switched the idle mode from Stop to Sleep
+int8_t powerReportId = -1; // scheduler id of powerReportTask
+lp_stats_t powerReportStats; // totals at the last duty cycle report
+flash_log_cursor_t dumpCursor; // position of the flash log dump
+oled_chart_t humidityChart, lightChart;
+ui_widget_t dhtScreen[DHT_UI_WIDGETS]; // DHT11 test
+ui_widget_t moldScreen[MOLD_UI_WIDGETS]; // mold risk test
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
@@ -137,8 +199,15 @@ void printMenu (void) {
 	printf("1: Test only DHT11\n\r");
 	printf("2: Test only OLED (SPI2)\n\r");
 	printf("3: Test only Solar panel (ADC1 CH1)\n\r");
-	printf("4: Test only ADC interrupt\n\r");
+	printf("4: Test ADC DMA scan (all channels)\n\r");
 	printf("5: Evaluate mold risk\n\r");
+	printf("6: Benchmark OLED transfer speed\n\r");
+	printf("7: Report duty cycle (sleep/stop)\n\r");
+	printf("8: Dump flash log (CSV)\n\r");
+	printf("9: Binary telemetry (tools/telemetry_decode.py)\n\r");
+	printf("b: Benchmark OLED drawing calls (CSV)\n\r");
+	printf("c: Humidity & light charts on the OLED\n\r");
+	printf("p: Print CPU profile (and restart it)\n\r");
 	return;
 } // end of func
 
@@ -159,6 +228,22 @@ uint8_t hasElapsed(uint32_t startTime, uint32_t duration) {
 } // end of func
 
 
+/*
+ * FUNCTION : lowerClockWhenIdle
+ * DESCRIPTION :
+ *    Go back to the low clock profile. The switch has to wait for OLED DMA
+ *    transfers (and DHT11 readings) to finish, so while one is going this
+ *    re-arms itself as a one-shot timer and tries again 1 ms later.
+ * PARAMETERS : void
+ * RETURNS : void
+ */
+void lowerClockWhenIdle (void) {
+	if (clock_set_profile(CLOCK_PROFILE_LOW) != HAL_OK) {
+		sched_call_after(lowerClockWhenIdle, 1);
+	}
+} // end of func
+
+
 /*
  * FUNCTION : runOledTest
  * DESCRIPTION : Display a fixed string on the OLED
@@ -171,107 +256,434 @@ void runOledTest (void) {
 	printf("This test displays a fixed message on the OLED screen.\n\r");
 
 	const char *testString = {"Monica's OLED!"}; // the string
+	clock_set_profile(CLOCK_PROFILE_HIGH);
 	ssd1331_display_string(0, 0, testString, FONT_1206, WHITE); // don't need to think about string buffer here
+	ssd1331_flush(); // push the drawn region to the panel
+	lowerClockWhenIdle();
 } // end of func
 
 
 /*
- * FUNCTION : runAdcTest
+ * FUNCTION : runOledBenchmark
  * DESCRIPTION :
- *    Read analog input from ADC1 and display the value on the terminal.
- *    This test is designed to verify that the ADC source is wired correctly
- *    and that the ADC is functioning. Values will be printed continuously.
- *    Type 'q' to quit the test and return to the main menu.
+ *    Time full-screen pixel writes to the OLED with the old byte-by-byte
+ *    writer and with the batched transaction writer, and print both rates.
+ *    Then time redraws of a status line of text, which is left on screen.
  * PARAMETERS : void
  * RETURNS : void
  */
-void runAdcTest (void) {
-	// Short description of the test:
-	printf("=== ADC Input Test ===\n\r");
-	printf("This test reads analog input from a potentiometer via ADC1.\n\r");
-	printf("Ensure the ADC source is connected to one of the ADC pins.\n\r");
-	printf("Type 'Y' to continue or any other key to cancel...\n\r");
+void runOledBenchmark (void) {
+	printf("=== OLED Transfer Benchmark ===\n\r");
+	ssd1331_wait_idle();
+	uart_tx_flush(); // the clock won't change under queued output
+	clock_set_profile(CLOCK_PROFILE_HIGH); // measure at full speed, as displayTask draws
+
+	uint32_t legacyRate = ssd1331_benchmark(1);
+	uint32_t batchedRate = ssd1331_benchmark(0);
+
+	printf("Per-byte writes: %lu bytes/s\n\r", legacyRate);
+	uint32_t ratio = legacyRate ? (uint32_t)((uint64_t)batchedRate * 10 / legacyRate) : 0; // in tenths
+	printf("Transactions:    %lu bytes/s (%lu.%lux)\n\r", batchedRate, ratio / 10, ratio % 10);
+
+	// Text: the same status line the mold risk test redraws
+	const char *line = "Humidity: 55 %";
+	uint32_t chars = 0, start = HAL_GetTick();
+	while (!hasElapsed(start, 250)) {
+		ssd1331_display_string(0, 16, line, FONT_1206, WHITE);
+		ssd1331_flush();
+		ssd1331_wait_idle();
+		chars += strlen(line);
+	}
+	/* the old per-pixel text path cost 8 single-byte writes for each of
+	 * the 6x12 pixels in a glyph, so estimate it from the per-byte rate */
+	printf("Text (FONT_1206): %lu chars/s, per-pixel path ~%lu chars/s\n\r",
+			chars * 1000 / (HAL_GetTick() - start), legacyRate / (8 * 6 * 12));
+	ssd1331_flush(); // repaint over the black benchmark frames
+	lowerClockWhenIdle();
+} // end of func
+
+
+/*
+ * FUNCTION : runDisplayBench
+ * DESCRIPTION :
+ *    Time the standard workload of each OLED drawing call (see displayBench.c)
+ *    and print microseconds, SPI bytes and transfers and pixels per second
+ *    per call as CSV, for comparing builds with tools/display_bench_compare.py.
+ * PARAMETERS : void
+ * RETURNS : void
+ */
+void runDisplayBench (void) {
+	printf("=== OLED Drawing Benchmark ===\n\r");
+	ssd1331_wait_idle();
+	uart_tx_flush(); // the clock won't change under queued output
+	clock_set_profile(CLOCK_PROFILE_HIGH); // as displayTask draws
+	display_bench_run(DISPLAY_BENCH_RUNS);
+	lowerClockWhenIdle();
+} // end of func
+
+
+/*
+ * FUNCTION: evaluateMoldRisk
+ * DESCRIPTION: Checks if mold risk is present based on humidity and light level
+ * PARAMETERS: float humidity, uint32_t lightLevel
+ * RETURNS: int8_t - 1 if mold risk detected, 0 if not (normal values)
+ */
+int8_t evaluateMoldRisk (float humidity, uint32_t lightLevel) {
+	int8_t riskFound = ( humidity >= HUMIDITY_HIGH && lightLevel <= SOLAR_HIGH );
+		/* NOTE 1: using int instead of uint here to potentially return errors in the future
+		 * NOTE 2: still assuming humidity's a float in case we switch sensor model */
+	return riskFound;
+} // end of func
 
-	// Confirmation prompt:
-	char confirm = 0;
-	while (confirm == 0) {
-		confirm = GetCharFromUART2(); // wait for user input via VCP
+
+/*
+ * FUNCTION: showMoldRisk
+ * DESCRIPTION: Sets the status banner of the mold risk screen to the warning
+ *              if mold risk was found, an OK status otherwise
+ * PARAMETERS: int8_t riskFound - result of evaluateMoldRisk()
+ * RETURNS: void
+ */
+void showMoldRisk (int8_t riskFound) {
+	if (riskFound) {
+		ui_set_text(&moldScreen[MOLD_UI_STATUS], "MOLD RISK!");
+		ui_set_background(&moldScreen[MOLD_UI_STATUS], RED); // white text on red
+	} else {
+		ui_set_text(&moldScreen[MOLD_UI_STATUS], "Status: OK");
+		ui_set_background(&moldScreen[MOLD_UI_STATUS], BLACK);
 	}
+	return;
+} // end of func
+
 
-	if (confirm != 'Y' && confirm != 'y') {
-		printf("Test aborted. Returning to main menu...\n\r");
+/*
+ * FUNCTION : collectSensors
+ * DESCRIPTION :
+ *    One-shot timer armed by sensorTask. Picks up the DHT11 result (trying
+ *    again a bit later if the frame isn't in yet), takes the ADC value from
+ *    the same moment and posts EVENT_SENSORS.
+ * PARAMETERS : void
+ * RETURNS : void
+ */
+void collectSensors (void) {
+	PROF_BEGIN(PROF_SENSORS);
+	DHT_StatusTypedef dhtStatus = DHT_GetResult(&DHT11_Data);
+	if (dhtStatus == DHT_BUSY) {
+		sched_call_after(collectSensors, DHT_RETRY_DELAY);
+		PROF_END(PROF_SENSORS);
 		return;
 	}
 
-	uint32_t startTime = HAL_GetTick(); // non-blocking timer for read loop
-	// Begin ADC read loop:
-	printf("ADC test started. Type 'q' to quit.\n\r");
-	while (1) {
-		char exitChar = GetCharFromUART2(); // allow exit via VCP
-		if (exitChar == 'q' || exitChar == 'Q') {
-			printf("Quitting ADC test. Returning to main menu...\n\r");
-			break;
+	// Handle sensor errors/garbage values (no answer, bad checksum, all zeros):
+	uint32_t now = HAL_GetTick();
+	dhtOk = (dhtStatus == DHT_READY) && !(DHT11_Data.Temperature == 0 && DHT11_Data.Humidity == 0);
+	if (dhtOk) {
+		Temperature = DHT11_Data.Temperature;
+		Humidity = DHT11_Data.Humidity;
+		history_push(HISTORY_HUMIDITY, now, (int32_t)Humidity);
+		history_push(HISTORY_TEMPERATURE, now, (int32_t)Temperature);
+	}
+
+	// ADC1 is scanned continuously by DMA, so this is as fresh as the DHT11 value:
+	adc_scan_snapshot_t snapshot;
+	adc_scan_snapshot(&snapshot);
+	LightLevel = snapshot.value[ADC_SCAN_SOLAR];
+	history_push(HISTORY_LIGHT, now, LightLevel);
+
+	flash_log_record_t record;
+	record.time = now;
+	record.humidity = dhtOk ? (uint8_t)Humidity : FLASH_LOG_NO_DATA;
+	record.temperature = dhtOk ? (int8_t)Temperature : 0;
+	record.light = (uint16_t)LightLevel;
+	flash_log_append(&record);
+
+	sched_post(EVENT_SENSORS);
+	PROF_END(PROF_SENSORS);
+} // end of func
+
+
+/*
+ * FUNCTION : sensorTask
+ * DESCRIPTION :
+ *    Periodic task (every SENSOR_READ_INTERVAL, whatever the console is doing).
+ *    Starts a DHT11 reading, which finishes in the background via TIM2, and
+ *    arms collectSensors() for when the frame should be complete.
+ * PARAMETERS : void
+ * RETURNS : void
+ */
+void sensorTask (void) {
+	DHT_StartRead();
+	sched_call_after(collectSensors, DHT_RESULT_DELAY);
+} // end of func
+
+
+/*
+ * FUNCTION : riskTask
+ * DESCRIPTION :
+ *    Runs on EVENT_SENSORS. Re-evaluates the mold risk from the averages over
+ *    the last HISTORY_WINDOW readings, so one noisy reading can't flip it,
+ *    and posts EVENT_RISK.
+ * PARAMETERS : void
+ * RETURNS : void
+ */
+void riskTask (void) {
+	history_stats_t humStats, lightStats;
+	history_sample_t newest;
+	history_stats(HISTORY_HUMIDITY, &humStats);
+	history_stats(HISTORY_LIGHT, &lightStats);
+
+	// No verdict without humidity, or once every humidity reading in the window has gone stale:
+	if (humStats.count == 0 || !history_get(HISTORY_HUMIDITY, 0, &newest)
+			|| hasElapsed(newest.tick, HISTORY_WINDOW * SENSOR_READ_INTERVAL)) {
+		moldRisk = 0;
+	} else {
+		moldRisk = evaluateMoldRisk(humStats.mean, (uint32_t)lightStats.mean);
+	}
+	sched_post(EVENT_RISK);
+} // end of func
+
+
+/*
+ * FUNCTION : displayTask
+ * DESCRIPTION :
+ *    Runs on EVENT_RISK. Updates the OLED for the test that is running
+ *    (DHT11 values, the mold risk screen or the charts) at the high clock
+ *    profile. The status screens are retained widgets, so only what changed
+ *    since the last reading is sent. The OLED is left alone in the other modes.
+ * PARAMETERS : void
+ * RETURNS : void
+ */
+void displayTask (void) {
+	if (consoleMode != MODE_DHT && consoleMode != MODE_MOLD && consoleMode != MODE_CHART) {
+		return;
+	}
+	PROF_BEGIN(PROF_DISPLAY);
+	clock_set_profile(CLOCK_PROFILE_HIGH); // if a transfer is still going, just draw at 16 MHz
+
+	if (consoleMode == MODE_DHT && dhtOk) {
+		ui_set_value(&dhtScreen[DHT_UI_TEMP], (int32_t)Temperature); // whole degrees for simplicity
+		ui_set_value(&dhtScreen[DHT_UI_HUMIDITY], (int32_t)Humidity);
+		ui_set_value(&dhtScreen[DHT_UI_HUMIDITY_BAR], (int32_t)Humidity);
+		ui_render(dhtScreen, DHT_UI_WIDGETS); // flushes only if a value changed
+	}
+	else if (consoleMode == MODE_MOLD) {
+		if (!dhtOk) {
+			ui_set_text(&moldScreen[MOLD_UI_HUMIDITY], "DHT ERROR!");
+			ui_set_color(&moldScreen[MOLD_UI_HUMIDITY], RED);
+		} else {
+			// Averages over the risk window rather than the last (noisy) reading:
+			history_stats_t humStats, lightStats;
+			history_stats(HISTORY_HUMIDITY, &humStats);
+			history_stats(HISTORY_LIGHT, &lightStats);
+			ui_set_value(&moldScreen[MOLD_UI_HUMIDITY], (int32_t)(humStats.mean + 0.5f));
+			ui_set_color(&moldScreen[MOLD_UI_HUMIDITY], WHITE);
+			ui_set_value(&moldScreen[MOLD_UI_LIGHT], (int32_t)(lightStats.mean + 0.5f));
+			showMoldRisk(moldRisk);
 		}
+		ui_render(moldScreen, MOLD_UI_WIDGETS);
+	}
+	else if (consoleMode == MODE_CHART) {
+		// Shifts both plots on the panel and draws one new column each
+		chart_push(&humidityChart, (int32_t)Humidity, dhtOk);
+		chart_push(&lightChart, (int32_t)LightLevel, 1);
+		ssd1331_flush(); // only needed without SSD1331_USE_HW_ACCEL
+	}
+
+	PROF_END(PROF_DISPLAY);
+	lowerClockWhenIdle(); // back to 16 MHz once the flush has gone out
+	return;
+} // end of func
 
-		if (hasElapsed(startTime, 200)) { // non-blocking HAL_Delay equivalent
-			startTime = HAL_GetTick(); // reset timer
 
-			HAL_ADC_Start(&hadc1);
-			if (HAL_ADC_PollForConversion(&hadc1, 10) == HAL_OK) { // polling, not interrupt
-				uint32_t adcValue = HAL_ADC_GetValue(&hadc1);
-				printf("ADC Value: %lu\n\r", adcValue);
-			}
-			HAL_ADC_Stop(&hadc1);
-		} // end of outer if
+/*
+ * FUNCTION : isqrt
+ * DESCRIPTION : Integer square root, rounded down (bit by bit, no FPU or libm)
+ * PARAMETERS : uint32_t value
+ * RETURNS : uint32_t - floor(sqrt(value))
+ */
+uint32_t isqrt (uint32_t value) {
+	uint32_t root = 0, bit = 1UL << 30;
+
+	while (bit > value) {
+		bit >>= 2;
+	}
+	while (bit != 0) {
+		if (value >= root + bit) {
+			value -= root + bit;
+			root = (root >> 1) + bit;
+		} else {
+			root >>= 1;
+		}
+		bit >>= 2;
+	}
+	return root;
+} // end of func
 
-	} // end of inner while()
 
+/*
+ * FUNCTION : sensorReportTask
+ * DESCRIPTION : Runs on EVENT_RISK. Prints the new values on the terminal during the DHT11 and mold risk tests
+ *               (with the window statistics the risk is based on in the latter).
+ * PARAMETERS : void
+ * RETURNS : void
+ */
+void sensorReportTask (void) {
+	if (consoleMode == MODE_DHT) {
+		if (dhtOk) {
+			LOG_INFO(LOG_MODULE_DHT, "Temp: %d C, Humidity: %d %%", (int)Temperature, (int)Humidity);
+		} else {
+			LOG_WARN(LOG_MODULE_DHT, "DHT11 not responding");
+		}
+	}
+	else if (consoleMode == MODE_MOLD) {
+		if (dhtOk) {
+			history_stats_t humStats, lightStats;
+			history_stats(HISTORY_HUMIDITY, &humStats);
+			history_stats(HISTORY_LIGHT, &lightStats);
+			// Fixed point, tenths: no float formatting, and the line goes through the log ring in order
+			uint32_t humMean = (uint32_t)(humStats.mean * 10.0f + 0.5f);
+			uint32_t lightSd = isqrt((uint32_t)(lightStats.variance * 100.0f + 0.5f));
+			LOG_INFO(LOG_MODULE_DHT, "Humidity: %d %% (avg %lu.%lu, min %ld, max %ld), Light: %lu (avg %lu, sd %lu.%lu)",
+					(int)Humidity, humMean / 10, humMean % 10, humStats.min, humStats.max,
+					LightLevel, (uint32_t)(lightStats.mean + 0.5f), lightSd / 10, lightSd % 10);
+		} else {
+			LOG_ERROR(LOG_MODULE_DHT, "ERROR: DHT sensor not responding.");
+		}
+	}
+	else if (consoleMode == MODE_TELEMETRY) {
+		telemetry_sensors_t sensors;
+		sensors.tick = HAL_GetTick();
+		sensors.humidity = dhtOk ? (uint8_t)Humidity : TELEMETRY_NO_DATA;
+		sensors.temperature = dhtOk ? (int8_t)Temperature : 0;
+		sensors.light = (uint16_t)LightLevel;
+		sensors.risk = moldRisk;
+		telemetry_send_sensors(&sensors);
+	}
 	return;
 } // end of func
 
 
 /*
- * FUNCTION : HAL_ADC_ConvCpltCallback (ADC interrupt func)
+ * FUNCTION : holdOutOfStop
  * DESCRIPTION :
- *    Read ADC interrupt value and update them to global vars
- * PARAMETERS : ADC_HandleTypeDef *hadc (ADC typedef)
+ *    The ADC only scans while the core is awake, so tests that watch it
+ *    switch the idle mode from Stop to Sleep, and back when they end.
+ * PARAMETERS : uint8_t hold - 1 to stay out of Stop, 0 to allow it again
  * RETURNS : void
  */
-void HAL_ADC_ConvCpltCallback (ADC_HandleTypeDef *hadc) {
-	if (hadc->Instance == ADC1) {
-		latestAdcValue = HAL_ADC_GetValue(hadc);
-		adcUpdated = 1;
+void holdOutOfStop (uint8_t hold) {
+	if (hold && lp_get_mode() == LP_STOP) {
+		lp_set_mode(LP_SLEEP);
+		heldOutOfStop = 1;
+	} else if (!hold && heldOutOfStop) {
+		lp_set_mode(LP_STOP);
+		heldOutOfStop = 0;
 	}
 } // end of func
 
 
 /*
- * FUNCTION: testAdcInterrupt
- * DESCRIPTION: Simple test to verify ADC1 interrupt is working.
- *              Prints new ADC values when updated via interrupt.
+ * FUNCTION : startAdcReport
+ * DESCRIPTION : Sets how often adcReportTask prints, and restarts its rate measurement.
+ * PARAMETERS : uint32_t period - ms between reports, 0 to stop them
+ * RETURNS : void
+ */
+void startAdcReport (uint32_t period) {
+	adcReportTime = HAL_GetTick();
+	adc_scan_irq_stats(&adcReportStats);
+	sched_set_period(adcReportId, period);
+	holdOutOfStop(period != 0);
+} // end of func
+
+
+/*
+ * FUNCTION: adcReportTask
+ * DESCRIPTION: Periodic task, only armed during the two ADC tests.
+ *              Single input test: prints the solar panel input.
+ *              Scan test: prints all three DMA-scanned channels so the wiring
+ *              can be checked at once, together with the ADC interrupt rate
+ *              and CPU share since the last report.
  * PARAMETERS: void
  * RETURNS: void
  */
-void testAdcInterrupt (void) {
-	// Start ADC in interrupt mode
-	HAL_ADC_Start_IT(&hadc1);
-
-	while (1) {
-		if (adcUpdated) {
-			adcUpdated = 0; // reset flag
-			printf("ADC Interrupt Value: %lu\n\r", latestAdcValue);
-		}
+void adcReportTask (void) {
+	adc_scan_snapshot_t snapshot;
+	adc_scan_snapshot(&snapshot); // all three values come from the same DMA block
+
+	if (consoleMode == MODE_ADC) {
+		LOG_INFO(LOG_MODULE_ADC, "ADC Value: %u", snapshot.value[ADC_SCAN_SOLAR]);
+		return;
 	}
 
-	HAL_ADC_Stop_IT(&hadc1); // stop ADC interrupt when done
+	adc_scan_irq_stats_t stats;
+	uint32_t elapsed = HAL_GetTick() - adcReportTime;
+	adcReportTime = HAL_GetTick();
+	adc_scan_irq_stats(&stats);
+	uint32_t irqs = stats.irqCount - adcReportStats.irqCount;
+	uint32_t cycles = stats.irqCycles - adcReportStats.irqCycles;
+	adcReportStats = stats;
+
+	LOG_INFO(LOG_MODULE_ADC, "Solar: %u, AUX1: %u, AUX2: %u (block %lu)", snapshot.value[ADC_SCAN_SOLAR],
+			snapshot.value[ADC_SCAN_AUX1], snapshot.value[ADC_SCAN_AUX2], snapshot.blocks);
+	// CPU share in hundredths of a percent: cycles / (elapsed ms * cycles per ms)
+	uint32_t load = (uint32_t)((uint64_t)cycles * 10000 / ((uint64_t)elapsed * (SystemCoreClock / 1000)));
+	LOG_INFO(LOG_MODULE_ADC, "ADC IRQs: %lu/s, CPU: %lu.%02lu%%", irqs * 1000 / elapsed, load / 100, load % 100);
+} // end of func
+
+
+/*
+ * FUNCTION : runAdcTest
+ * DESCRIPTION :
+ *    Start the ADC1 input test, which verifies that the ADC source is wired
+ *    correctly and that the ADC is functioning. Asks for confirmation first;
+ *    the answer is handled by consoleTask. Values are then printed every
+ *    200 ms until 'q' is typed.
+ * PARAMETERS : void
+ * RETURNS : void
+ */
+void runAdcTest (void) {
+	// Short description of the test:
+	printf("=== ADC Input Test ===\n\r");
+	printf("This test reads analog input from a potentiometer via ADC1.\n\r");
+	printf("Ensure the ADC source is connected to one of the ADC pins.\n\r");
+	printf("Type 'Y' to continue or any other key to cancel...\n\r");
+	consoleMode = MODE_ADC_CONFIRM;
+} // end of func
+
+
+/*
+ * FUNCTION: testAdcScan
+ * DESCRIPTION: Start printing the DMA-scanned ADC1 channels twice a second.
+ *              Type 'f' to let the ADC free-run, 't' to go back to the
+ *              TIM4-triggered rate (compare the load) and 'q' to quit.
+ * PARAMETERS: void
+ * RETURNS: void
+ */
+void testAdcScan (void) {
+	printf("Type 'f' for free-running, 't' for timer-triggered, 'q' to quit.\n\r");
+	consoleMode = MODE_ADC_SCAN;
+	startAdcReport(500);
+} // end of func
+
+
+/*
+ * FUNCTION : clearOled
+ * DESCRIPTION : Blanks the OLED before a new screen is drawn on it.
+ * PARAMETERS : void
+ * RETURNS : void
+ */
+void clearOled (void) {
+	clock_set_profile(CLOCK_PROFILE_HIGH);
+	ssd1331_clear_screen(BLACK);
+	ssd1331_flush();
+	lowerClockWhenIdle();
 } // end of func
 
 
 /*
  * FUNCTION : runDhtTest
  * DESCRIPTION :
- *    Read analog input from DHT11 and display the value on the terminal & OLED.
- *    Type 'q' to quit the test and return to the main menu.
+ *    Start showing the DHT11 readings on the terminal & OLED as sensorTask
+ *    takes them. Type 'q' to quit the test and return to the main menu.
  * PARAMETERS : void
  * RETURNS : void
  */
@@ -279,176 +691,359 @@ void runDhtTest (void) {
 	printf("=== DHT11 Sensor Test ===\n\r");
 	printf("This test reads temperature and humidity from the DHT11 sensor.\n\r");
 	printf("Type 'q' to quit.\n\r");
+	ui_value_init(&dhtScreen[DHT_UI_TEMP], 0, 0, 96, FONT_1206, "Temp: %ld C", WHITE);
+	ui_value_init(&dhtScreen[DHT_UI_HUMIDITY], 0, 16, 96, FONT_1206, "Humidity: %ld %%", WHITE);
+	ui_bar_init(&dhtScreen[DHT_UI_HUMIDITY_BAR], 0, 30, 96, 2, 0, 100, CYAN);
+	clearOled(); // displayTask draws the widgets with the first reading
+	consoleMode = MODE_DHT;
+} // end of func
 
-	char tempStr[20] = {0}; // format output to readable text (OLED prefers string) & init 1st byte to \0
-	char humStr[20] = {0};
 
-	uint32_t startTime = HAL_GetTick(); // non-blocking timer
+/*
+ * FUNCTION: runMoldRiskTest
+ * DESCRIPTION: Start showing the mold risk evaluation (riskTask runs after every
+ *              sensor reading in any mode, this only makes it visible).
+ * PARAMETERS: void
+ * RETURNS: void
+ */
+void runMoldRiskTest (void) {
+	printf("=== Mold Risk Evaluation ===\n\r");
+	printf("Press 'q' to quit.\n\r");
+	ui_value_init(&moldScreen[MOLD_UI_HUMIDITY], 0, 0, 96, FONT_1206, "Hum avg: %ld %%", WHITE);
+	ui_value_init(&moldScreen[MOLD_UI_LIGHT], 0, 16, 96, FONT_1206, "Light avg: %ld", WHITE);
+	ui_banner_init(&moldScreen[MOLD_UI_STATUS], 0, 32, 96, 32, FONT_1206, "", WHITE, BLACK);
+	clearOled();
+	consoleMode = MODE_MOLD;
+} // end of func
 
-	while (1) {
-		char exitChar = GetCharFromUART2();
-		if (exitChar == 'q' || exitChar == 'Q') {
-			printf("Quitting DHT11 test. Returning to main menu...\n\r");
-			break;
-		}
-		if ( hasElapsed(startTime, 1100) ) { // non-blocking delay. IMPORTANT: DHT11 can't handle delays lower than 1000 ms...
-			startTime = HAL_GetTick(); // reset timer
-			// Read & update values to some vars:
-			DHT_GetData(&DHT11_Data);
-			Temperature = DHT11_Data.Temperature;
-			Humidity = DHT11_Data.Humidity;
-			snprintf(tempStr, sizeof(tempStr), "Temp: %d C", (int)Temperature); // cast to int instead of (uint16_t) for simplicity
-			snprintf(humStr, sizeof(humStr), "Humidity: %d %%", (int)Humidity); // cast to int instead of (uint16_t) for simplicity
-
-			printf("T: %s, H: %s\n\r", tempStr, humStr);
-
-			// Clear top half of screen by drawing a black rectangle:
-			ssd1331_fill_rect(0, 0, 96, 32, BLACK); // clear top half of screen
-			ssd1331_display_string(0, 0, tempStr, FONT_1206, WHITE);
-			ssd1331_display_string(0, 16, humStr, FONT_1206, WHITE);
-
-			// Display values on OLED:
-			ssd1331_display_string(0, 0, tempStr, FONT_1206, WHITE);
-			ssd1331_display_string(0, 16, humStr, FONT_1206, WHITE);
-		} // end of if
 
-	} // end of while()
+/*
+ * FUNCTION : runChart
+ * DESCRIPTION :
+ *    Show humidity (top) and light (bottom) as strip charts on the OLED,
+ *    starting with the readings already in the history and adding a column
+ *    after each new one (see displayTask). Type 'q' to quit.
+ * PARAMETERS : void
+ * RETURNS : void
+ */
+void runChart (void) {
+	printf("=== Sensor Charts ===\n\r");
+	printf("OLED: humidity (0-%d %%) on top, light (0-%d) below, one column per reading. Type 'q' to quit.\n\r",
+			CHART_HUMIDITY_MAX, CHART_LIGHT_MAX);
+	clock_set_profile(CLOCK_PROFILE_HIGH);
+	chart_init(&humidityChart, 0, 0, 96, 31, 0, CHART_HUMIDITY_MAX, CYAN);
+	chart_init(&lightChart, 0, 32, 96, 32, 0, CHART_LIGHT_MAX, YELLOW);
+	ssd1331_clear_screen(BLACK);
+	ssd1331_fill_rect(0, 31, 96, 1, GREY); // divider, outside both plots
+	chart_redraw(&humidityChart, HISTORY_HUMIDITY);
+	chart_redraw(&lightChart, HISTORY_LIGHT);
+	ssd1331_flush();
+	lowerClockWhenIdle();
+	consoleMode = MODE_CHART;
+} // end of func
 
-	return;
+
+/*
+ * FUNCTION : powerReportTask
+ * DESCRIPTION :
+ *    Periodic task, only armed during the duty cycle report. Prints how the
+ *    last period was split between running, Sleep (WFI) and Stop mode.
+ * PARAMETERS : void
+ * RETURNS : void
+ */
+void powerReportTask (void) {
+	static const char modeKeys[] = "rsd"; // the keys that select each lp_mode_t
+	lp_stats_t stats;
+	lp_stats(&stats);
+
+	uint32_t active = stats.activeUs - powerReportStats.activeUs;
+	uint32_t sleep = stats.sleepUs - powerReportStats.sleepUs;
+	uint32_t stop = stats.stopUs - powerReportStats.stopUs;
+	uint32_t stops = stats.stops - powerReportStats.stops;
+	uint32_t total = active + sleep + stop;
+	powerReportStats = stats;
+	if (total == 0) {
+		return;
+	}
+
+	// Shares in hundredths of a percent:
+	uint32_t activeShare = (uint32_t)((uint64_t)active * 10000 / total);
+	uint32_t sleepShare = (uint32_t)((uint64_t)sleep * 10000 / total);
+	uint32_t stopShare = (uint32_t)((uint64_t)stop * 10000 / total);
+	LOG_INFO(LOG_MODULE_POWER, "Awake: %lu.%02lu%%, Sleep: %lu.%02lu%%, Stop: %lu.%02lu%% (%lu stops), mode: %c, %lu MHz",
+			activeShare / 100, activeShare % 100, sleepShare / 100, sleepShare % 100,
+			stopShare / 100, stopShare % 100, stops, modeKeys[lp_get_mode()], SystemCoreClock / 1000000);
 } // end of func
 
 
 /*
- * FUNCTION: readSensors
- * DESCRIPTION: Reads humidity and light level from sensors at synchronized intervals
- * PARAMETERS: float* humidity, uint32_t* lightLevel
- * RETURNS: int8_t - 0 if success, -1 if sensor error
+ * FUNCTION : runPowerReport
+ * DESCRIPTION :
+ *    Start printing the duty cycle once a second. 'r', 's' and 'd' pick the
+ *    deepest idle state (run / sleep / deep = Stop) to compare them.
+ *    NOTE: the key press that wakes the board from Stop is not received, type it again.
+ * PARAMETERS : void
+ * RETURNS : void
  */
-int8_t readSensors (float* humidity, uint32_t* lightLevel) {
-	uint32_t now = HAL_GetTick();
+void runPowerReport (void) {
+	printf("=== Duty Cycle ===\n\r");
+	printf("Type 'r' (never sleep), 's' (sleep only), 'd' (allow Stop) or 'q' to quit.\n\r");
+	consoleMode = MODE_POWER;
+	lp_stats(&powerReportStats);
+	sched_set_period(powerReportId, 1000);
+} // end of func
 
-	// Read DHT11 if interval has passed:
-	if ( hasElapsed(latestDhtReadtime, DHT_READ_INTERVAL) ) {
-		latestDhtReadtime = now;
-		DHT_GetData(&DHT11_Data); // get data
 
-		// Handle sensor errors/garbage values:
-		if (DHT11_Data.Temperature == 0 && DHT11_Data.Humidity == 0) {
-			return -1; // sensor error
-		}
-		// Read value:
-		*humidity = DHT11_Data.Humidity; // we're only getting humidity data for this, not temperatures
-	}
+/*
+ * FUNCTION : endDump
+ * DESCRIPTION : Go back to dropping console output that doesn't fit, and to the menu.
+ * PARAMETERS : void
+ * RETURNS : void
+ */
+void endDump (void) {
+	uart_tx_set_policy(UART_TX_POLICY);
+	consoleMode = MODE_MENU;
+} // end of func
 
-	// Read ADC value if updated via interrupt and interval has passed:
-	if ( adcUpdated && hasElapsed(latestAdcReadtime, ADC_READ_INTERVAL) ) {
-		latestAdcReadtime = now;
-		adcUpdated = 0; // reset flag
-		*lightLevel = latestAdcValue;
-	}
 
-	return 0;
+/*
+ * FUNCTION : dumpTask
+ * DESCRIPTION :
+ *    One-shot timer that prints the next DUMP_LINES_PER_RUN records of the
+ *    flash log and re-arms itself until the log (or the user, with 'q') ends
+ *    the dump. Splitting it up keeps the sensors and display running.
+ * PARAMETERS : void
+ * RETURNS : void
+ */
+void dumpTask (void) {
+	flash_log_record_t record;
+	uint16_t boot;
+
+	if (consoleMode != MODE_DUMP) {
+		return; // aborted
+	}
+	for (uint16_t line = 0; line < DUMP_LINES_PER_RUN; line++) {
+		if (!flash_log_dump_next(&dumpCursor, &boot, &record)) {
+			printf("=== End of log ===\n\r");
+			endDump();
+			return;
+		}
+		if (record.humidity == FLASH_LOG_NO_DATA) {
+			printf("%u,%lu,,,%u\n\r", boot, record.time, record.light);
+		} else {
+			printf("%u,%lu,%u,%d,%u\n\r", boot, record.time, record.humidity, record.temperature, record.light);
+		}
+	}
+	sched_call_after(dumpTask, 1);
 } // end of func
 
 
 /*
- * FUNCTION: evaluateMoldRisk
- * DESCRIPTION: Checks if mold risk is present based on humidity and light level
- * PARAMETERS: float humidity, uint32_t lightLevel
- * RETURNS: int8_t - 1 if mold risk detected, 0 if not (normal values)
+ * FUNCTION : runFlashDump
+ * DESCRIPTION :
+ *    Write the records still buffered in RAM to flash, then print the whole
+ *    log as CSV, oldest first. Output waits for room in the TX buffer
+ *    instead of dropping lines for the duration of the dump.
+ * PARAMETERS : void
+ * RETURNS : void
  */
-int8_t evaluateMoldRisk (float humidity, uint32_t lightLevel) {
-	int8_t riskFound = ( humidity >= HUMIDITY_HIGH && lightLevel <= SOLAR_HIGH );
-		/* NOTE 1: using int instead of uint here to potentially return errors in the future
-		 * NOTE 2: still assuming humidity's a float in case we switch sensor model */
-	return riskFound;
+void runFlashDump (void) {
+	flash_log_info_t info;
+	flash_log_sync();
+	flash_log_info(&info);
+
+	printf("=== Flash Log ===\n\r");
+	printf("%lu records, boot %u, sector erases: %lu / %lu. Type 'q' to stop.\n\r",
+			info.records, info.boot, info.erases[0], info.erases[1]);
+	printf("boot,ms,humidity,temperature,light\n\r");
+	uart_tx_set_policy(UART_TX_BLOCK);
+	consoleMode = MODE_DUMP;
+	flash_log_dump_begin(&dumpCursor);
+	sched_call_after(dumpTask, 1);
 } // end of func
 
 
 /*
- * FUNCTION: showMoldWarning
- * DESCRIPTION: Displays mold risk warning on OLED
- * PARAMETERS: void
- * RETURNS: void
+ * FUNCTION : runTelemetry
+ * DESCRIPTION :
+ *    Replace the printed reports with binary frames (see telemetry.c) until
+ *    'q'. Starts with one sensor frame per reading; 'a' adds every raw ADC
+ *    scan, 's' goes back to sensors only, '1'-'6' set the ADC scan rate in
+ *    steps of 250 Hz.
+ * PARAMETERS : void
+ * RETURNS : void
  */
-void showMoldWarning (void) {
-	ssd1331_fill_rect(0, 32, 96, 32, RED); // clear bottom half with red
-	ssd1331_display_string(0, 32, "MOLD RISK!", FONT_1206, WHITE); // white text
-    return;
+void runTelemetry (void) {
+	printf("=== Telemetry ===\n\r");
+	printf("Binary frames follow, decode them with tools/telemetry_decode.py.\n\r");
+	printf("Type 'a' (raw ADC too), 's' (sensors only), '1'-'6' (x250 Hz ADC rate) or 'q' to quit.\n\r");
+	consoleMode = MODE_TELEMETRY;
+	telemetry_set_mode(TELEMETRY_SENSORS);
 } // end of func
 
 
 /*
- * FUNCTION: evaluateAndDisplayRisk
- * DESCRIPTION: Evaluates mold risk and displays warning if needed
- * PARAMETERS: float humidity, uint32_t lightLevel
- * RETURNS: void
+ * FUNCTION : telemetryKey
+ * DESCRIPTION : Handles the keys of the telemetry mode, except 'q'.
+ * PARAMETERS : char userInput - character typed on the terminal
+ * RETURNS : void
  */
-void evaluateAndDisplayRisk (float humidity, uint32_t lightLevel) {
-	if (evaluateMoldRisk(humidity, lightLevel)) {
-		showMoldWarning();
-	} else {
-		// Clear bottom half of screen if no risk
-		ssd1331_fill_rect(0, 32, 96, 32, BLACK);
-		ssd1331_display_string(0, 32, "Status: OK", FONT_1206, WHITE);
+void telemetryKey (char userInput) {
+	if (userInput == 'a') {
+		holdOutOfStop(1);
+		telemetry_set_mode(TELEMETRY_RAW);
+	} else if (userInput == 's') {
+		telemetry_set_mode(TELEMETRY_SENSORS);
+		holdOutOfStop(0);
+	} else if (userInput >= '1' && userInput <= '6') {
+		adc_scan_set_rate((userInput - '0') * 250);
 	}
-	return;
 } // end of func
 
 
 /*
- * FUNCTION: runMoldRiskTest
- * DESCRIPTION: Runs mold risk evaluation loop
- * 	NOTE:for now I'm implementing this way, but will be updated with circular buffer implementation
- * PARAMETERS: void
- * RETURNS: void
+ * FUNCTION : handleMenuInput
+ * DESCRIPTION : Runs the menu option the user typed.
+ * PARAMETERS : char userInput - character typed on the terminal
+ * RETURNS : void
  */
-void runMoldRiskTest (void) {
-	printf("=== Mold Risk Evaluation ===\n\r");
-	printf("Press 'q' to quit.\n\r");
+void handleMenuInput (char userInput) {
+	printf("You entered: %c\n\r", userInput);
 
-	// Define vars again:
-	char humStr[20] = {0};
-	char lightStr[20] = {0};
-	float humidity = 0;
-	uint32_t lightLevel = 0;
-	uint32_t startTime = HAL_GetTick();
-
-	// Main eval loop:
-	while (1) {
-		// Prompt to escape to main menu:
-		char exitChar = GetCharFromUART2();
-		if (exitChar == 'q' || exitChar == 'Q') {
-			printf("Exiting mold risk test.\n\r");
+	switch (userInput) {
+		case '0': // show menu again
+			printMenu();
 			break;
-		}
 
-		// non-blocking delay:
-		if ( hasElapsed(startTime, 1000) ) { // check every 1 second
-			startTime = HAL_GetTick(); // reset timer
+		case '1': // test DHT11 measurements
+			runDhtTest();
+			break;
 
-			// Check if sensor outputs make sense:
-			if (readSensors(&humidity, &lightLevel) == -1) {
-				printf("ERROR: DHT sensor not responding.\n\r");
-				ssd1331_display_string(0, 0, "DHT ERROR!", FONT_1206, RED);
-				continue;
-			}
+		case '2': // test OLED
+			runOledTest();
+			break;
 
-			// Show results on OLED:
-			snprintf(humStr, sizeof(humStr), "Humidity: %d %%", (int)humidity);
-			snprintf(lightStr, sizeof(lightStr), "Light: %lu", lightLevel);
+		case '3': // test ADC
+			runAdcTest();
+			break;
 
-			ssd1331_fill_rect(0, 0, 96, 32, BLACK); // clear top half
-			ssd1331_display_string(0, 0, humStr, FONT_1206, WHITE);
-			ssd1331_display_string(0, 16, lightStr, FONT_1206, WHITE);
+		case '4': // test ADC interrupt
+			testAdcScan();
+			break;
 
-			// Print results on Terminal:
-			printf("H: %s %%, L: %s\n\r", humStr, lightStr);
+		case '5': // integrated testing:
+			runMoldRiskTest();
+			break;
 
-			evaluateAndDisplayRisk(humidity, lightLevel);
-		} // end of hasElapsed() if loop
+		case '6': // OLED transfer benchmark
+			runOledBenchmark();
+			break;
+
+		case '7': // low-power duty cycle
+			runPowerReport();
+			break;
 
-	} // end of inner while(1)
+		case '8': // flash log
+			runFlashDump();
+			break;
+
+		case '9': // binary telemetry
+			runTelemetry();
+			break;
+
+		case 'b': // OLED drawing benchmark
+			runDisplayBench();
+			break;
+
+		case 'c': // strip charts
+			runChart();
+			break;
+
+		case 'p': // cycle counts per probe since the last 'p'
+			prof_print();
+			prof_reset();
+			break;
+
+		default:
+			printf("ERROR: invalid menu option!\n\rShowing menu again...\n\r");
+			printMenu(); // show menu again
+			break;
+	} // end of switch
+	return;
+} // end of func
+
+
+/*
+ * FUNCTION : consoleTask
+ * DESCRIPTION :
+ *    Runs on EVENT_CONSOLE (posted by the USART2 interrupt). Handles every
+ *    character typed since the last run according to the current mode:
+ *    menu selection, the ADC test confirmation, or the keys of a running test.
+ * PARAMETERS : void
+ * RETURNS : void
+ */
+void consoleTask (void) {
+	char userInput;
+
+	while ((userInput = GetCharFromUART2()) != 0) {
+		switch (consoleMode) {
+			case MODE_MENU:
+				handleMenuInput(userInput);
+				break;
+
+			case MODE_ADC_CONFIRM:
+				if (userInput != 'Y' && userInput != 'y') {
+					printf("Test aborted. Returning to main menu...\n\r");
+					consoleMode = MODE_MENU;
+					break;
+				}
+				printf("ADC test started. Type 'q' to quit.\n\r");
+				consoleMode = MODE_ADC;
+				startAdcReport(200);
+				break;
+
+			default: // a test is running
+				if (consoleMode == MODE_ADC_SCAN && (userInput == 'f' || userInput == 't')) {
+					adc_scan_set_rate(userInput == 'f' ? 0 : ADC_SCAN_RATE_HZ);
+					printf("ADC scan rate: %s\n\r", userInput == 'f' ? "free-running" : "timer-triggered");
+				}
+				if (consoleMode == MODE_POWER && (userInput == 'r' || userInput == 's' || userInput == 'd')) {
+					lp_set_mode(userInput == 'r' ? LP_RUN : (userInput == 's' ? LP_SLEEP : LP_STOP));
+				}
+				if (consoleMode == MODE_TELEMETRY) {
+					telemetryKey(userInput);
+				}
+				if (userInput != 'q' && userInput != 'Q') {
+					break;
+				}
+
+				if (consoleMode == MODE_DHT) {
+					printf("Quitting DHT11 test. Returning to main menu...\n\r");
+				} else if (consoleMode == MODE_ADC) {
+					printf("Quitting ADC test. Returning to main menu...\n\r");
+				} else if (consoleMode == MODE_MOLD) {
+					printf("Exiting mold risk test.\n\r");
+				} else if (consoleMode == MODE_CHART) {
+					printf("Charts stopped.\n\r");
+				} else if (consoleMode == MODE_ADC_SCAN) {
+					adc_scan_set_rate(ADC_SCAN_RATE_HZ); // leave the normal rate behind
+				} else if (consoleMode == MODE_DUMP) {
+					printf("Dump stopped.\n\r");
+					endDump();
+				} else if (consoleMode == MODE_TELEMETRY) {
+					telemetry_stats_t stats;
+					telemetry_set_mode(TELEMETRY_OFF);
+					telemetry_stats(&stats);
+					adc_scan_set_rate(ADC_SCAN_RATE_HZ);
+					holdOutOfStop(0);
+					printf("\n\rTelemetry stopped: %lu frames sent, %lu skipped.\n\r", stats.frames, stats.skipped);
+				}
+				startAdcReport(0);
+				sched_set_period(powerReportId, 0);
+				consoleMode = MODE_MENU;
+				break;
+		} // end of switch
+	} // end of while()
 	return;
 } // end of func
 
@@ -485,74 +1080,42 @@ int main(void)
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
+  MX_DMA_Init();
   MX_USART2_UART_Init();
   MX_ADC1_Init();
   MX_SPI2_Init();
   MX_TIM4_Init();
+  MX_TIM2_Init();
   /* USER CODE BEGIN 2 */
   printf("\n\rGroup 3's Demo:\n\r===\n\r");
 
   ssd1331_init(); // Init OLED
-  HAL_ADC_Start_IT(&hadc1); // Start ADC interrupt
-
-  // Declare vars:
-  uint8_t showMenu = 1; // flag that when set will output the menu prompt
-
+  adc_scan_start(); // Start continuous ADC scan into DMA buffer
+  uart_rx_init(); // Collect typed characters in the background from now on
+  lp_init(); // RTC wake-up for Stop mode (measures the LSI, takes 200 ms)
+  flash_log_init(); // find where the flash log left off
+  prof_init();
+
+  // Tasks run in this order when several are ready at once:
+  sched_add_task(consoleTask, 0, EVENT_CONSOLE);
+  sched_add_task(sensorTask, SENSOR_READ_INTERVAL, 0);
+  sched_add_task(riskTask, 0, EVENT_SENSORS);
+  sched_add_task(displayTask, 0, EVENT_RISK);
+  sched_add_task(sensorReportTask, 0, EVENT_RISK);
+  adcReportId = sched_add_task(adcReportTask, 0, 0); // armed by the ADC tests
+  powerReportId = sched_add_task(powerReportTask, 0, 0); // armed by the duty cycle report
+  sched_add_task(telemetry_task, 0, EVENT_TELEMETRY);
+  sched_add_task(log_task, 0, EVENT_LOG); // last, so entries are formatted once the other tasks are done
+
+  printMenu();
+  lowerClockWhenIdle(); // 16 MHz from here on, except while drawing
   /* USER CODE END 2 */
 
   /* Infinite loop */
   /* USER CODE BEGIN WHILE */
   while (1)
   {
-//	  runDhtTest();
-	  // If menu hasn't been printed:
-	  if(showMenu != 0)	{	// meaning menu flag isn't 0
-		  printMenu();
-		  showMenu = 0;		// reset flag
-	  	  }
-
-	  // Show user input:
-	  char userInput = GetCharFromUART2(); // using VCP here to avoid module failure
-										  /* this declaration needs to be here to restrict
-										   * its scope only to this loop */
-	  if (userInput != 0) {
-		  printf("You entered: %c\n\r", userInput);
-	  }
-
-	  // Handle the menu input:
-	  switch (userInput) {
-	  	  case 0: // (note this is 0 not '0') Nothing received from GetCharFromUART2()
-	  		  break;
-
-	  	  case '0': // show menu again
-	  		  showMenu = 1;
-	  		  break;
-
-	  	  case '1': // test DHT11 measurements
-	  		  runDhtTest();
-	  		  break;
-
-	  	  case '2': // test OLED
-	  		  runOledTest();
-	  		  break;
-
-	  	  case '3': // test ADC
-	  		  runAdcTest();
-	  		  break;
-
-	  	  case '4': // test ADC interrupt
-	  		  testAdcInterrupt();
-			  break;
-
-	  	  case'5': // integrated testing:
-	  		  runMoldRiskTest();
-	  		  break;
-
-	  	  default:
-	  		  printf("ERROR: invalid menu option!\n\rShowing menu again...\n\r");
-	  		  showMenu = 1; // show menu again
-	  		  break;
-	  } // end of switch
+	  sched_run(); // runs the tasks above and sleeps when none is ready (never returns)
     /* USER CODE END WHILE */
 
     /* USER CODE BEGIN 3 */
@@ -617,12 +1180,11 @@ PUTCHAR_PROTOTYPE
 
 GETCHAR_PROTOTYPE
 {
-  uint8_t ch = 0;
-  // Clear the Overrun flag just before receiving the first character
-  __HAL_UART_CLEAR_OREFLAG(&huart2);
-
-  HAL_UART_Receive(&huart2, (uint8_t *)&ch, 1, 5);
-  return ch;
+  // Wait up to 5 ms for the USART2 interrupt to deliver a character
+  uint32_t start = HAL_GetTick();
+  int ch;
+  while ((ch = uart_read()) < 0 && (HAL_GetTick() - start) < 5);
+  return (ch < 0) ? 0 : ch;
 }
 
 /* USER CODE END 4 */
@@ -0,0 +1,168 @@
+/**
+  ******************************************************************************
+  * @file           : oledChart.c
+
+  * @brief          : scrolling strip chart on the SSD1331, shifted in hardware
+  * @date           : 17-10-2026
+  *
+  * One column per sample, the newest on the right. Once the plot is full,
+  * chart_push() moves it left by one column with the controller's
+  * COPY_WINDOW command and draws only the new column: a clear and a fill
+  * command for the line segment joining it to the previous sample, about
+  * 25 SPI bytes in three transfers whatever the size of the plot. Redrawing
+  * the columns through ssd1331_draw_line() instead would resend the whole
+  * plot for every sample.
+  *
+  * The panel's continuous scrolling (ssd1331_start_scroll()) isn't used
+  * here: it steps on the controller's frame clock rather than per sample,
+  * only moves full-width bands, and the band has to be rewritten after it
+  * stops.
+  *
+  * Without SSD1331_USE_HW_ACCEL the driver does the copy in its RAM copy
+  * and the next flush sends the plot, which is still correct, just not cheap.
+
+  ******************************************************************************
+  */
+
+#include "oledChart.h"
+#include "ssd1331.h"
+#include "sensorHistory.h"
+
+#define OLED_WIDTH    96
+#define OLED_HEIGHT   64
+
+
+// Panel row of a value, clamped to the plot
+static uint8_t chart_row(const oled_chart_t *chart, int32_t value)
+{
+	uint32_t span = (uint32_t)(chart->max - chart->min);
+
+	if (value <= chart->min || span == 0) return chart->y + chart->height - 1;
+	if (value >= chart->max) return chart->y;
+	return chart->y + chart->height - 1 - (uint8_t)((uint64_t)(value - chart->min) * (chart->height - 1) / span);
+}
+
+
+// FUNCTION      : chart_segment
+// DESCRIPTION   :
+//   Draw the part of column x that joins the previous sample to this one.
+//   With hardware set it's one fill command, otherwise pixels in the
+//   driver's RAM copy that the next flush sends together.
+// PARAMETERS    :
+//   oled_chart_t *chart : chart, lastRow is updated
+//   uint8_t x           : panel column
+//   uint8_t row         : panel row of the new sample
+//   uint8_t hardware    : 1 to draw with a fill command
+// RETURNS       :
+//   nothing
+static void chart_segment(oled_chart_t *chart, uint8_t x, uint8_t row, uint8_t hardware)
+{
+	uint8_t top = row, bottom = row, i;
+
+	if (chart->lastRow != CHART_NO_ROW) {
+		if (chart->lastRow < top) top = chart->lastRow;
+		if (chart->lastRow > bottom) bottom = chart->lastRow;
+	}
+	chart->lastRow = row;
+
+	if (hardware) {
+		ssd1331_fill_rect(x, top, 1, bottom - top + 1, chart->color);
+	} else {
+		for (i = top; i <= bottom; i++) {
+			ssd1331_draw_point(x, i, chart->color);
+		}
+	}
+}
+
+
+// FUNCTION      : chart_init
+// DESCRIPTION   :
+//   Set up an empty chart (nothing is drawn until chart_redraw() or
+//   chart_push()). The plot is clipped to the panel.
+// PARAMETERS    :
+//   oled_chart_t *chart           : chart to set up
+//   uint8_t x, y                  : top-left corner
+//   uint8_t width, height         : size in pixels, at least 2 x 2
+//   int32_t min, max              : values shown on the bottom and top row
+//   uint16_t color                : colour of the trace, on black
+// RETURNS       :
+//   nothing
+void chart_init(oled_chart_t *chart, uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+		int32_t min, int32_t max, uint16_t color)
+{
+	if (x > OLED_WIDTH - 2) x = OLED_WIDTH - 2;
+	if (y > OLED_HEIGHT - 2) y = OLED_HEIGHT - 2;
+	if (width > OLED_WIDTH - x) width = OLED_WIDTH - x;
+	if (height > OLED_HEIGHT - y) height = OLED_HEIGHT - y;
+
+	chart->x = x;
+	chart->y = y;
+	chart->width = (width < 2) ? 2 : width;
+	chart->height = (height < 2) ? 2 : height;
+	chart->min = min;
+	chart->max = (max > min) ? max : min + 1;
+	chart->color = color;
+	chart->background = BLACK;
+	chart->columns = 0;
+	chart->lastRow = CHART_NO_ROW;
+}
+
+
+// FUNCTION      : chart_redraw
+// DESCRIPTION   :
+//   Clear the plot and draw the newest samples of a history channel, as many
+//   as there are columns. Used when the chart appears; the caller flushes.
+// PARAMETERS    :
+//   oled_chart_t *chart : chart to draw
+//   uint8_t channel     : HISTORY_HUMIDITY, HISTORY_TEMPERATURE or HISTORY_LIGHT
+// RETURNS       :
+//   nothing
+void chart_redraw(oled_chart_t *chart, uint8_t channel)
+{
+	history_sample_t sample;
+	uint16_t age = history_count(channel);
+
+	if (age > chart->width) age = chart->width;
+	ssd1331_fill_rect(chart->x, chart->y, chart->width, chart->height, chart->background);
+	chart->columns = 0;
+	chart->lastRow = CHART_NO_ROW;
+
+	while (age-- > 0) {
+		if (history_get(channel, age, &sample)) {
+			chart_segment(chart, chart->x + chart->columns, chart_row(chart, sample.value), 0);
+		}
+		chart->columns++;
+	}
+}
+
+
+// FUNCTION      : chart_push
+// DESCRIPTION   :
+//   Add a sample on the right. Once the plot is full it is shifted left by
+//   one column on the panel first. With SSD1331_USE_HW_ACCEL everything goes
+//   out as graphic commands; otherwise flush afterwards as for any drawing.
+// PARAMETERS    :
+//   oled_chart_t *chart : chart to add to
+//   int32_t value       : the sample
+//   uint8_t valid       : 0 if there is no sample this time (leaves a gap)
+// RETURNS       :
+//   nothing
+void chart_push(oled_chart_t *chart, int32_t value, uint8_t valid)
+{
+	uint8_t x;
+
+	if (chart->columns < chart->width) {
+		x = chart->x + chart->columns++;
+	} else {
+		ssd1331_copy_window(chart->x + 1, chart->y, chart->x + chart->width - 1, chart->y + chart->height - 1,
+				chart->x, chart->y);
+		x = chart->x + chart->width - 1;
+	}
+
+	ssd1331_fill_rect(x, chart->y, 1, chart->height, chart->background);
+	if (valid) {
+		chart_segment(chart, x, chart_row(chart, value), 1);
+	} else {
+		chart->lastRow = CHART_NO_ROW;
+	}
+}
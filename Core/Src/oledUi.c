@@ -0,0 +1,254 @@
+/**
+  ******************************************************************************
+  * @file           : oledUi.c
+
+  * @brief          : retained widgets for the SSD1331 status screens
+  * @date           : 17-10-2026
+  *
+  * A screen is an array of widgets (labels, value fields, banners, bar
+  * gauges). The application only sets what they should show; ui_render()
+  * compares that with what each widget last drew and redraws the ones that
+  * differ, then flushes once. A screen whose values haven't changed costs no
+  * SPI traffic at all, and a changed one usually only the character cells
+  * that differ or the strip of bar that grew or shrank: a humidity going
+  * from 55 to 56 % rewrites one 6 x 12 cell, not the line.
+  *
+  * Widgets of one screen must not overlap: each one only knows its own
+  * rectangle. Text is monospaced and cut at the widget's width; as with
+  * ssd1331_display_string() the character cells themselves are black.
+  * Hidden widgets leave their rectangle black.
+
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "oledUi.h"
+#include "ssd1331.h"
+
+
+// Common part of the init functions: visible, nothing drawn yet
+static void ui_init(ui_widget_t *widget, uint8_t type, uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+		uint16_t color, uint16_t background)
+{
+	memset(widget, 0, sizeof(*widget));
+	widget->type = type;
+	widget->x = x;
+	widget->y = y;
+	widget->width = width;
+	widget->height = height;
+	widget->color = color;
+	widget->background = background;
+	widget->visible = 1;
+}
+
+
+// FUNCTION      : ui_label_init, ui_value_init, ui_banner_init, ui_bar_init
+// DESCRIPTION   :
+//   Set up a widget. Nothing is drawn until ui_render(), which draws every
+//   widget in full the first time (clear the panel before a new screen).
+//   Labels and value fields are one line of text on black; a value field
+//   shows nothing until its first ui_set_value() or ui_set_text().
+// PARAMETERS    :
+//   ui_widget_t *widget           : widget to set up
+//   uint8_t x, y                  : top-left corner
+//   uint8_t width, height         : size in pixels, text past the width is cut
+//   uint8_t font                  : FONT_1206 or FONT_1608
+//   const char *text              : initial text, copied
+//   const char *format            : printf format of the value, with one %ld; kept, not copied
+//   int32_t min, max              : values of an empty and a full bar
+//   uint16_t color, background    : colours of the text or bar and of the rest
+// RETURNS       :
+//   nothing
+void ui_label_init(ui_widget_t *widget, uint8_t x, uint8_t y, uint8_t width, uint8_t font,
+		const char *text, uint16_t color)
+{
+	ui_init(widget, UI_LABEL, x, y, width, font, color, BLACK);
+	widget->font = font;
+	ui_set_text(widget, text);
+}
+
+void ui_value_init(ui_widget_t *widget, uint8_t x, uint8_t y, uint8_t width, uint8_t font,
+		const char *format, uint16_t color)
+{
+	ui_init(widget, UI_VALUE, x, y, width, font, color, BLACK);
+	widget->font = font;
+	widget->format = format;
+}
+
+void ui_banner_init(ui_widget_t *widget, uint8_t x, uint8_t y, uint8_t width, uint8_t height, uint8_t font,
+		const char *text, uint16_t color, uint16_t background)
+{
+	ui_init(widget, UI_BANNER, x, y, width, height, color, background);
+	widget->font = font;
+	ui_set_text(widget, text);
+}
+
+void ui_bar_init(ui_widget_t *widget, uint8_t x, uint8_t y, uint8_t width, uint8_t height,
+		int32_t min, int32_t max, uint16_t color)
+{
+	ui_init(widget, UI_BAR, x, y, width, height, color, BLACK);
+	widget->min = min;
+	widget->max = (max > min) ? max : min + 1;
+	widget->value = min;
+}
+
+
+void ui_set_text(ui_widget_t *widget, const char *text)
+{
+	strncpy(widget->text, text, UI_TEXT_MAX - 1);
+	widget->text[UI_TEXT_MAX - 1] = '\0';
+}
+
+
+// Value fields are formatted here, so ui_render() only ever compares text
+void ui_set_value(ui_widget_t *widget, int32_t value)
+{
+	widget->value = value;
+	if (widget->type == UI_VALUE) {
+		snprintf(widget->text, UI_TEXT_MAX, widget->format, (long)value);
+	}
+}
+
+
+void ui_set_color(ui_widget_t *widget, uint16_t color)
+{
+	widget->color = color;
+}
+
+
+void ui_set_background(ui_widget_t *widget, uint16_t background)
+{
+	widget->background = background;
+}
+
+
+void ui_set_visible(ui_widget_t *widget, uint8_t visible)
+{
+	widget->visible = visible ? 1 : 0;
+}
+
+
+// FUNCTION      : ui_render_text
+// DESCRIPTION   :
+//   Redraw a text widget if its text or colours changed. A new background
+//   (or showing / hiding it) repaints the whole rectangle, a new colour all
+//   the characters. Otherwise only the cells whose character differs from
+//   what was drawn are rewritten, and if the text got shorter the cells it
+//   no longer covers are cleared.
+// PARAMETERS    :
+//   ui_widget_t *widget : label, value field or banner
+// RETURNS       :
+//   1 if anything was drawn, 0 if the panel already showed it
+static uint8_t ui_render_text(ui_widget_t *widget)
+{
+	uint8_t full = !widget->drawn || widget->visible != widget->shownVisible
+			|| widget->background != widget->shownBackground;
+	uint8_t cell = widget->font / 2, columns = widget->width / cell;
+	uint8_t length = strlen(widget->text), shownLength = strlen(widget->shownText), i;
+
+	if (!full && (!widget->visible
+			|| (widget->color == widget->shownColor && strcmp(widget->text, widget->shownText) == 0))) {
+		return 0;
+	}
+
+	if (full) {
+		ssd1331_fill_rect(widget->x, widget->y, widget->width, widget->height,
+				widget->visible ? widget->background : BLACK);
+	}
+	if (widget->visible) {
+		if (length > columns) length = columns;
+		if (shownLength > columns) shownLength = columns;
+		for (i = 0; i < length; i++) {
+			if (full || widget->color != widget->shownColor || i >= shownLength
+					|| widget->text[i] != widget->shownText[i]) {
+				ssd1331_display_char(widget->x + i * cell, widget->y, widget->text[i], widget->font, widget->color);
+			}
+		}
+		if (!full && shownLength > length) {
+			ssd1331_fill_rect(widget->x + length * cell, widget->y, (shownLength - length) * cell,
+					(widget->font < widget->height) ? widget->font : widget->height, widget->background);
+		}
+	}
+
+	memcpy(widget->shownText, widget->text, UI_TEXT_MAX);
+	widget->shownColor = widget->color;
+	widget->shownBackground = widget->background;
+	widget->shownVisible = widget->visible;
+	widget->drawn = 1;
+	return 1;
+}
+
+
+// Columns of a bar that are filled for its current value
+static uint8_t ui_bar_fill(const ui_widget_t *widget)
+{
+	if (widget->value <= widget->min) return 0;
+	if (widget->value >= widget->max) return widget->width;
+	return (uint8_t)((uint64_t)(widget->value - widget->min) * widget->width / (uint32_t)(widget->max - widget->min));
+}
+
+
+// FUNCTION      : ui_render_bar
+// DESCRIPTION   :
+//   Redraw a bar gauge if the filled part moved by at least a column or the
+//   colours changed. A moved bar only gets the strip between the old and the
+//   new end, one fill command with SSD1331_USE_HW_ACCEL.
+// PARAMETERS    :
+//   ui_widget_t *widget : bar gauge
+// RETURNS       :
+//   1 if anything was drawn, 0 if the panel already showed it
+static uint8_t ui_render_bar(ui_widget_t *widget)
+{
+	uint8_t full = !widget->drawn || widget->visible != widget->shownVisible
+			|| widget->color != widget->shownColor || widget->background != widget->shownBackground;
+	uint8_t fill = ui_bar_fill(widget);
+
+	if (!full && (!widget->visible || fill == widget->shownFill)) {
+		return 0;
+	}
+
+	if (!full) {
+		if (fill > widget->shownFill) {
+			ssd1331_fill_rect(widget->x + widget->shownFill, widget->y, fill - widget->shownFill, widget->height, widget->color);
+		} else {
+			ssd1331_fill_rect(widget->x + fill, widget->y, widget->shownFill - fill, widget->height, widget->background);
+		}
+	} else if (widget->visible) {
+		ssd1331_fill_rect(widget->x, widget->y, fill, widget->height, widget->color);
+		ssd1331_fill_rect(widget->x + fill, widget->y, widget->width - fill, widget->height, widget->background);
+	} else {
+		ssd1331_fill_rect(widget->x, widget->y, widget->width, widget->height, BLACK);
+	}
+
+	widget->shownFill = fill;
+	widget->shownColor = widget->color;
+	widget->shownBackground = widget->background;
+	widget->shownVisible = widget->visible;
+	widget->drawn = 1;
+	return 1;
+}
+
+
+// FUNCTION      : ui_render
+// DESCRIPTION   :
+//   Bring the panel up to date with a screen: redraw the widgets whose
+//   content changed since they were last drawn and flush if there were any.
+// PARAMETERS    :
+//   ui_widget_t *widgets : the screen
+//   uint8_t count        : widgets in it
+// RETURNS       :
+//   number of widgets redrawn, 0 if no SPI traffic was needed
+uint8_t ui_render(ui_widget_t *widgets, uint8_t count)
+{
+	uint8_t changed = 0, i;
+
+	for (i = 0; i < count; i++) {
+		changed += (widgets[i].type == UI_BAR) ? ui_render_bar(&widgets[i]) : ui_render_text(&widgets[i]);
+	}
+	if (changed) {
+		ssd1331_flush();
+	}
+	return changed;
+}
@@ -0,0 +1,142 @@
+/**
+  ******************************************************************************
+  * @file           : profiler.c
+
+  * @brief          : begin/end probes timed with the DWT cycle counter
+  * @date           : 17-10-2026
+  *
+  * PROF_BEGIN reads CYCCNT into a local, PROF_END hands the difference to
+  * prof_record(), which keeps count, min, max and total per probe. The cost
+  * of an empty begin/end pair is measured once by prof_init() and taken off
+  * every sample, so a probe reports the cycles of the code between them.
+  * Nested probes both count the inner code, and a probe cut into by an
+  * interrupt includes the interrupt.
+  *
+  * The core clock changes at run time (clockProfile.c), so each sample is
+  * also converted to ns at the clock it ran at; prof_print() shows cycles
+  * and the share of wall time since the last reset.
+
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "profiler.h"
+
+static const char *const profNames[PROF_PROBES] = {
+	"collectSensors", "displayTask", "oled string", "oled fill rect",
+	"DHT_GetData", "DHT decode ISR", "ADC ISRs"
+};
+
+static prof_stats_t profStats[PROF_PROBES];
+static uint32_t profOverhead = 0;    // cycles of an empty PROF_BEGIN/PROF_END pair
+static uint32_t profResetTick = 0;
+
+
+// FUNCTION      : prof_init
+// DESCRIPTION   :
+//   Start the cycle counter (if nothing else has), measure the cost of an
+//   empty probe and clear the statistics.
+// PARAMETERS    :
+//   none
+// RETURNS       :
+//   nothing
+void prof_init(void)
+{
+	uint32_t cycles, best = 0xFFFFFFFFUL;
+	uint8_t i;
+
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+#if PROFILE_ENABLED
+	// An empty probe; keep the fastest try, an interrupt can only add
+	for (i = 0; i < 8; i++) {
+		PROF_BEGIN(PROF_PROBES);
+		cycles = DWT->CYCCNT - profStart_PROF_PROBES;
+		if (cycles < best) best = cycles;
+	}
+	profOverhead = best;
+#else
+	UNUSED(cycles);
+	UNUSED(best);
+	UNUSED(i);
+#endif
+	prof_reset();
+}
+
+
+void prof_record(prof_probe_t probe, uint32_t cycles)
+{
+	prof_stats_t *stats;
+	uint32_t primask;
+
+	if (probe >= PROF_PROBES) return;
+	cycles = (cycles > profOverhead) ? cycles - profOverhead : 0;
+
+	primask = __get_PRIMASK();
+	__disable_irq();
+	stats = &profStats[probe];
+	if (stats->count == 0 || cycles < stats->min) stats->min = cycles;
+	if (cycles > stats->max) stats->max = cycles;
+	stats->count++;
+	stats->total += cycles;
+	stats->totalNs += (uint64_t)cycles * 1000 / (SystemCoreClock / 1000000);
+	__set_PRIMASK(primask);
+}
+
+
+void prof_get(prof_probe_t probe, prof_stats_t *stats)
+{
+	uint32_t primask;
+
+	if (probe >= PROF_PROBES) return;
+	primask = __get_PRIMASK();
+	__disable_irq();
+	*stats = profStats[probe];
+	__set_PRIMASK(primask);
+}
+
+
+void prof_reset(void)
+{
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	memset(profStats, 0, sizeof(profStats));
+	profResetTick = HAL_GetTick();
+	__set_PRIMASK(primask);
+}
+
+
+// FUNCTION      : prof_print
+// DESCRIPTION   :
+//   Print a table with count, min / mean / max cycles, total time and share
+//   of the time since the last reset for every probe.
+// PARAMETERS    :
+//   none
+// RETURNS       :
+//   nothing
+void prof_print(void)
+{
+	prof_stats_t stats;
+	uint32_t elapsedMs = HAL_GetTick() - profResetTick;
+	uint32_t share;
+	uint8_t probe;
+
+	printf("Profile over the last %lu ms (%lu MHz now, probe overhead %lu cycles):\n\r",
+			elapsedMs, SystemCoreClock / 1000000, profOverhead);
+	printf("%-16s %8s %9s %9s %9s %10s %7s\n\r", "probe", "count", "min", "mean", "max", "total us", "time");
+	for (probe = 0; probe < PROF_PROBES; probe++) {
+		prof_get(probe, &stats);
+		if (stats.count == 0) {
+			printf("%-16s %8s\n\r", profNames[probe], "-");
+			continue;
+		}
+		// share of wall time in hundredths of a percent
+		share = elapsedMs ? (uint32_t)(stats.totalNs / 100 / elapsedMs) : 0;
+		printf("%-16s %8lu %9lu %9lu %9lu %10lu %4lu.%02lu%%\n\r", profNames[probe], stats.count,
+				stats.min, (uint32_t)(stats.total / stats.count), stats.max,
+				(uint32_t)(stats.totalNs / 1000), share / 100, share % 100);
+	}
+}
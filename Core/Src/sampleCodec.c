@@ -0,0 +1,185 @@
+/**
+  ******************************************************************************
+  * @file           : sampleCodec.c
+
+  * @brief          : delta / zig-zag / varint packing of timestamped sample streams
+  * @date           : 17-10-2026
+  *
+  * A stream is a sequence of samples, each a timestamp plus 1 to
+  * CODEC_MAX_CHANNELS integer values. Readings change by a few counts, and
+  * come at a nearly fixed interval, so instead of the raw numbers a sample
+  * stores:
+  *   - the change of the time step since the previous sample (0 when the
+  *     interval is steady)
+  *   - a bit mask of the channels whose value changed
+  *   - the change of each of those values
+  * Signed numbers are zig-zag mapped (0, -1, 1, -2... -> 0, 1, 2, 3...) and
+  * written as little-endian base-128 varints, so small changes of either
+  * sign take one byte. A token starts with one varint:
+  *   bit 0 = 0 : a sample. Bits 1..channels are the change mask, the bits
+  *               above hold the time step change. One varint follows per
+  *               changed channel.
+  *   bit 0 = 1 : a run. The bits above count samples that repeat the
+  *               previous one exactly (same time step, no change); the writer
+  *               keeps growing the run at the end of the buffer in place.
+  * A steady sample therefore costs nothing while a run is open, and a sample
+  * where one channel moved by a little costs 2 bytes.
+  *
+  * Every stream starts from tick 0 and values 0, so its first sample holds
+  * the absolute numbers and any stream can be decoded on its own.
+
+  ******************************************************************************
+  */
+
+#include <string.h>
+
+#include "sampleCodec.h"
+
+static uint32_t codec_zigzag(int32_t value)
+{
+	return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+
+static int32_t codec_unzigzag(uint32_t value)
+{
+	return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+
+// Returns the number of bytes written (1 to 10)
+static uint8_t codec_put_varint(uint8_t *out, uint64_t value)
+{
+	uint8_t n = 0;
+
+	while (value >= 0x80) {
+		out[n++] = (uint8_t)value | 0x80;
+		value >>= 7;
+	}
+	out[n++] = (uint8_t)value;
+	return n;
+}
+
+
+static uint8_t codec_get_varint(codec_reader_t *reader, uint64_t *value)
+{
+	uint8_t shift = 0, byte;
+
+	*value = 0;
+	do {
+		if (reader->pos >= reader->len || shift > 63) return 0;
+		byte = reader->buf[reader->pos++];
+		*value |= (uint64_t)(byte & 0x7F) << shift;
+		shift += 7;
+	} while (byte & 0x80);
+	return 1;
+}
+
+
+void codec_writer_init(codec_writer_t *writer, uint8_t *buf, uint16_t size, uint8_t channels)
+{
+	memset(writer, 0, sizeof(*writer));
+	writer->buf = buf;
+	writer->size = size;
+	writer->channels = (channels > CODEC_MAX_CHANNELS) ? CODEC_MAX_CHANNELS : channels;
+	writer->runPos = CODEC_NO_RUN;
+}
+
+
+// FUNCTION      : codec_write
+// DESCRIPTION   :
+//   Append a sample. Nothing is written if it doesn't fit, so the caller can
+//   start a new buffer and write it there.
+// PARAMETERS    :
+//   codec_writer_t *writer : stream to append to
+//   uint32_t tick          : timestamp, must not go backwards
+//   const int32_t *value   : writer->channels values
+// RETURNS       :
+//   1 if the sample was stored, 0 if the buffer is full
+uint8_t codec_write(codec_writer_t *writer, uint32_t tick, const int32_t *value)
+{
+	uint8_t token[CODEC_MAX_TOKEN], n, ch, mask = 0;
+	uint32_t dt = tick - writer->tick;
+
+	for (ch = 0; ch < writer->channels; ch++) {
+		if (value[ch] != writer->value[ch]) mask |= 1 << ch;
+	}
+
+	if (writer->count > 0 && mask == 0 && dt == writer->dt) {
+		// Repeat of the previous sample: open a run or grow the one at the end
+		uint16_t pos = (writer->runPos != CODEC_NO_RUN) ? writer->runPos : writer->len;
+		n = codec_put_varint(token, ((uint64_t)(writer->run + 1) << 1) | 1);
+		if (pos + n > writer->size) return 0;
+		memcpy(writer->buf + pos, token, n);
+		writer->runPos = pos;
+		writer->run++;
+		writer->len = pos + n;
+	} else {
+		n = codec_put_varint(token, ((uint64_t)codec_zigzag((int32_t)(dt - writer->dt)) << (1 + writer->channels))
+				| ((uint64_t)mask << 1));
+		for (ch = 0; ch < writer->channels; ch++) {
+			if (mask & (1 << ch)) {
+				n += codec_put_varint(token + n, codec_zigzag((int32_t)((uint32_t)value[ch] - (uint32_t)writer->value[ch])));
+			}
+		}
+		if (writer->len + n > writer->size) return 0;
+		memcpy(writer->buf + writer->len, token, n);
+		writer->len += n;
+		writer->runPos = CODEC_NO_RUN;
+		writer->run = 0;
+		writer->dt = dt;
+		memcpy(writer->value, value, writer->channels * sizeof(int32_t));
+	}
+	writer->tick = tick;
+	writer->count++;
+	return 1;
+}
+
+
+void codec_reader_init(codec_reader_t *reader, const uint8_t *buf, uint16_t len, uint8_t channels)
+{
+	memset(reader, 0, sizeof(*reader));
+	reader->buf = buf;
+	reader->len = len;
+	reader->channels = (channels > CODEC_MAX_CHANNELS) ? CODEC_MAX_CHANNELS : channels;
+}
+
+
+// FUNCTION      : codec_read
+// DESCRIPTION   :
+//   Decode the next sample.
+// PARAMETERS    :
+//   codec_reader_t *reader : stream to read
+//   uint32_t *tick         : timestamp of the sample
+//   int32_t *value         : reader->channels values
+// RETURNS       :
+//   1 if a sample was read, 0 at the end of the stream or on a malformed token
+uint8_t codec_read(codec_reader_t *reader, uint32_t *tick, int32_t *value)
+{
+	uint64_t token, delta;
+	uint8_t ch, mask;
+
+	if (reader->run == 0) {
+		if (!codec_get_varint(reader, &token)) return 0;
+		if (token & 1) {
+			reader->run = (uint32_t)(token >> 1);
+			if (reader->run == 0) return 0;
+		} else {
+			mask = (uint8_t)(token >> 1) & ((1 << reader->channels) - 1);
+			reader->dt += (uint32_t)codec_unzigzag((uint32_t)(token >> (1 + reader->channels)));
+			for (ch = 0; ch < reader->channels; ch++) {
+				if (mask & (1 << ch)) {
+					if (!codec_get_varint(reader, &delta)) return 0;
+					reader->value[ch] = (int32_t)((uint32_t)reader->value[ch] + (uint32_t)codec_unzigzag((uint32_t)delta));
+				}
+			}
+			reader->run = 1;
+		}
+	}
+	reader->run--;
+	reader->tick += reader->dt;
+
+	*tick = reader->tick;
+	memcpy(value, reader->value, reader->channels * sizeof(int32_t));
+	return 1;
+}
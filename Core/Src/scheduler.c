@@ -0,0 +1,212 @@
+/**
+  ******************************************************************************
+  * @file           : scheduler.c
+
+  * @brief          : run-to-completion scheduler (periodic tasks, one-shot timers, event flags)
+  * @date           : 17-10-2026
+  *
+  * Tasks are plain functions that do a little work and return. A task becomes
+  * ready when its period runs out (timed on the 1 ms SysTick that HAL already
+  * keeps) or when one of the event flags it listens to is posted, usually from
+  * an interrupt. sched_run() runs the ready tasks in table order, so tasks
+  * added first go first, and calls sched_idle() when nothing is ready. The
+  * default sched_idle() sleeps with WFI until any interrupt (at the latest the
+  * next SysTick); lowPower.c replaces it with one that can also use Stop mode.
+
+  ******************************************************************************
+  */
+
+#include <stddef.h>
+
+#include "scheduler.h"
+
+typedef struct {
+	sched_fn_t fn;        // NULL = free slot
+	uint32_t period;      // ms between runs, 0 = not periodic
+	uint32_t due;         // tick of the next timed run
+	uint32_t events;      // flags that make the task ready
+	uint8_t timed;        // due is armed
+	uint8_t oneShot;      // free the slot once it has run
+} sched_task_t;
+
+static sched_task_t schedTasks[SCHED_MAX_TASKS];
+static volatile uint32_t schedPending = 0;    // posted flags not yet handed to a task
+
+
+// Find a free slot and fill it in
+static int8_t sched_add(sched_fn_t fn, uint32_t delayMs, uint32_t periodMs, uint32_t events, uint8_t oneShot)
+{
+	int8_t id;
+
+	for (id = 0; id < SCHED_MAX_TASKS; id++) {
+		sched_task_t *task = &schedTasks[id];
+		if (task->fn == NULL) {
+			task->period = periodMs;
+			task->due = HAL_GetTick() + delayMs;
+			task->events = events;
+			task->timed = (delayMs != 0 || oneShot);
+			task->oneShot = oneShot;
+			task->fn = fn;
+			return id;
+		}
+	}
+	return -1;
+}
+
+
+// FUNCTION      : sched_add_task
+// DESCRIPTION   :
+//   Register a task that runs every periodMs and/or whenever one of the given
+//   event flags is posted.
+// PARAMETERS    :
+//   sched_fn_t fn     : the task
+//   uint32_t periodMs : ms between runs, 0 for an event-only task
+//   uint32_t events   : event flags to run on, 0 for a timed-only task
+// RETURNS       :
+//   task id, or -1 if all SCHED_MAX_TASKS slots are taken
+int8_t sched_add_task(sched_fn_t fn, uint32_t periodMs, uint32_t events)
+{
+	return sched_add(fn, periodMs, periodMs, events, 0);
+}
+
+
+// FUNCTION      : sched_set_period
+// DESCRIPTION   :
+//   Change how often a task runs. The next run is one new period from now.
+// PARAMETERS    :
+//   int8_t id         : id from sched_add_task()
+//   uint32_t periodMs : ms between runs, 0 to stop the timed runs
+// RETURNS       :
+//   nothing
+void sched_set_period(int8_t id, uint32_t periodMs)
+{
+	if (id < 0 || id >= SCHED_MAX_TASKS) return;
+
+	schedTasks[id].period = periodMs;
+	schedTasks[id].due = HAL_GetTick() + periodMs;
+	schedTasks[id].timed = (periodMs != 0);
+}
+
+
+// FUNCTION      : sched_call_after
+// DESCRIPTION   :
+//   Run a function once, delayMs from now. It may re-arm itself.
+// PARAMETERS    :
+//   sched_fn_t fn    : function to call
+//   uint32_t delayMs : delay in ms
+// RETURNS       :
+//   slot id, or -1 if all SCHED_MAX_TASKS slots are taken
+int8_t sched_call_after(sched_fn_t fn, uint32_t delayMs)
+{
+	return sched_add(fn, delayMs, 0, 0, 1);
+}
+
+
+// FUNCTION      : sched_post
+// DESCRIPTION   :
+//   Set event flags. Every task listening to one of them runs on the next
+//   pass of the scheduler (once, however often the flag was posted).
+// PARAMETERS    :
+//   uint32_t events : flags to set
+// RETURNS       :
+//   nothing
+void sched_post(uint32_t events)
+{
+	uint32_t primask = __get_PRIMASK();
+
+	__disable_irq();
+	schedPending |= events;
+	__set_PRIMASK(primask);
+}
+
+
+// Time until the earliest timed task is due, SCHED_IDLE_FOREVER if there is none
+static uint32_t sched_idle_time(uint32_t now)
+{
+	uint32_t idleMs = SCHED_IDLE_FOREVER;
+	int8_t id;
+
+	for (id = 0; id < SCHED_MAX_TASKS; id++) {
+		sched_task_t *task = &schedTasks[id];
+		if (task->fn != NULL && task->timed) {
+			int32_t left = (int32_t)(task->due - now);
+			if (left <= 0) return 0;
+			if ((uint32_t)left < idleMs) idleMs = (uint32_t)left;
+		}
+	}
+	return idleMs;
+}
+
+
+// FUNCTION      : sched_idle
+// DESCRIPTION   :
+//   Called by sched_run() with interrupts masked when no task is ready. Must
+//   return once an interrupt is pending (WFI does that even with PRIMASK set).
+//   Weak so a power manager can go deeper when the gap is long enough.
+// PARAMETERS    :
+//   uint32_t idleMs : ms until the next timed task, SCHED_IDLE_FOREVER if none
+// RETURNS       :
+//   nothing
+__weak void sched_idle(uint32_t idleMs)
+{
+	(void)idleMs;
+	__WFI();
+}
+
+
+// FUNCTION      : sched_run
+// DESCRIPTION   :
+//   Scheduler loop. Call once all tasks are registered.
+// PARAMETERS    :
+//   none
+// RETURNS       :
+//   never
+void sched_run(void)
+{
+	while (1) {
+		uint32_t events, now;
+		uint8_t ran = 0;
+		int8_t id;
+
+		__disable_irq();
+		events = schedPending;
+		schedPending = 0;
+		__enable_irq();
+
+		now = HAL_GetTick();
+		for (id = 0; id < SCHED_MAX_TASKS; id++) {
+			sched_task_t *task = &schedTasks[id];
+			sched_fn_t fn = task->fn;
+			uint8_t ready = (fn != NULL) && (task->events & events) != 0;
+
+			if (fn != NULL && task->timed && (int32_t)(now - task->due) >= 0) {
+				ready = 1;
+				if (task->oneShot) {
+					task->fn = NULL;                  // free before the call so it can re-arm
+				} else {
+					task->due += task->period;
+					if ((int32_t)(now - task->due) >= 0) {
+						task->due = now + task->period;   // fell behind, skip the missed runs
+					}
+				}
+			}
+			if (ready) {
+				fn();
+				ran = 1;
+			}
+		}
+
+		if (!ran) {
+			// Sleep unless an interrupt posted something since the flags were taken
+			__disable_irq();
+			now = HAL_GetTick();
+			if (schedPending == 0) {
+				uint32_t idleMs = sched_idle_time(now);
+				if (idleMs != 0) {
+					sched_idle(idleMs);
+				}
+			}
+			__enable_irq();
+		}
+	}
+}
@@ -0,0 +1,221 @@
+/**
+  ******************************************************************************
+  * @file           : sensorHistory.c
+
+  * @brief          : per-channel delta-encoded history of timestamped sensor
+  *                   samples with O(1) rolling statistics
+  * @date           : 17-10-2026
+  *
+  * Each channel keeps its samples delta-encoded (see sampleCodec.c) in a
+  * statically allocated ring of small blocks. A new block is started when
+  * the current one is full, dropping the oldest block once all of them are
+  * in use, so each block decodes on its own. With readings that move by a
+  * few counts at a steady interval a sample takes well under 2 bytes instead
+  * of 8, which is what lets HISTORY_DEPTH be 4x what the same RAM held as a
+  * raw ring. Very noisy readings keep fewer samples. history_get() has to
+  * decode from the start of a block, which is up to HISTORY_BLOCK_SAMPLES
+  * samples of work.
+  *
+  * The statistics cover the newest HISTORY_WINDOW samples, whose raw values
+  * are also kept, and are updated on every push instead of being recomputed:
+  *   - the window sum and sum of squares gain the new value and lose the one
+  *     that drops out of the window (exact, in 64-bit integers), which gives
+  *     mean and variance
+  *   - min and max come from monotonic deques of sample numbers: the front is
+  *     always the extreme of the window, and every sample enters and leaves
+  *     each deque once, so a push costs O(1) amortised
+  * Samples are numbered by how many were pushed before them; the value of
+  * sample n lives at window[n % HISTORY_WINDOW], which is what lets the
+  * deques hold plain numbers. Everything here runs in thread context (the
+  * scheduler's tasks).
+
+  ******************************************************************************
+  */
+
+#include "sensorHistory.h"
+#include "sampleCodec.h"
+
+#define HISTORY_BLOCKS          14   // encoded blocks per channel
+#define HISTORY_BLOCK_SIZE      48   // bytes each
+#define HISTORY_BLOCK_SAMPLES   32   // most samples in a block, keeps history_get() bounded
+
+#if (HISTORY_BLOCKS - 1) * HISTORY_BLOCK_SAMPLES < HISTORY_DEPTH
+#error "HISTORY_BLOCKS can't hold HISTORY_DEPTH samples"
+#endif
+#if HISTORY_WINDOW > HISTORY_DEPTH
+#error "HISTORY_WINDOW must not exceed HISTORY_DEPTH"
+#endif
+
+// Sample numbers in the window, ordered so that the front is the extreme
+typedef struct {
+	uint32_t seq[HISTORY_WINDOW];
+	uint8_t head;
+	uint8_t len;
+} history_deque_t;
+
+typedef struct {
+	uint8_t data[HISTORY_BLOCKS][HISTORY_BLOCK_SIZE];
+	uint8_t len[HISTORY_BLOCKS];   // bytes used in each block
+	uint8_t count[HISTORY_BLOCKS]; // samples in each block
+	uint8_t oldest;              // block holding the oldest samples
+	uint8_t blocks;              // blocks in use, the newest one is being appended to
+	uint16_t stored;             // samples in all of them
+	codec_writer_t writer;       // appends to the newest block
+	int32_t window[HISTORY_WINDOW]; // values of the newest samples
+	uint32_t pushed;             // samples pushed so far = number of the next one
+	int64_t sum;                 // over the window
+	int64_t sumSq;
+	history_deque_t minQ;        // values increase from the front
+	history_deque_t maxQ;        // values decrease from the front
+} history_channel_t;
+
+static history_channel_t historyChannels[HISTORY_CHANNELS];
+
+#define HISTORY_VALUE(ch, n)   ((ch)->window[(n) % HISTORY_WINDOW])
+#define HISTORY_NEWEST(ch)     (((ch)->oldest + (ch)->blocks - 1) % HISTORY_BLOCKS)
+#define DEQUE_AT(q, i)         ((q)->seq[((q)->head + (i)) % HISTORY_WINDOW])
+
+
+// Drop samples that have left the window, then samples at the back that the
+// new one outranks (sign = 1 for the max deque, -1 for the min deque)
+static void history_deque_push(history_channel_t *ch, history_deque_t *q, uint32_t seq, int32_t value, int8_t sign)
+{
+	while (q->len && DEQUE_AT(q, 0) + HISTORY_WINDOW <= seq) {
+		q->head = (q->head + 1) % HISTORY_WINDOW;
+		q->len--;
+	}
+	while (q->len && sign * HISTORY_VALUE(ch, DEQUE_AT(q, q->len - 1)) <= sign * value) {
+		q->len--;
+	}
+	DEQUE_AT(q, q->len) = seq;
+	q->len++;
+}
+
+
+// Append a sample to the newest block, starting a new one if it's full
+static void history_store(history_channel_t *ch, uint32_t tick, int32_t value)
+{
+	uint8_t newest;
+
+	if (ch->blocks == 0 || ch->writer.count >= HISTORY_BLOCK_SAMPLES || !codec_write(&ch->writer, tick, &value)) {
+		if (ch->blocks == HISTORY_BLOCKS) {
+			ch->stored -= ch->count[ch->oldest];
+			ch->oldest = (ch->oldest + 1) % HISTORY_BLOCKS;
+			ch->blocks--;
+		}
+		ch->blocks++;
+		newest = HISTORY_NEWEST(ch);
+		codec_writer_init(&ch->writer, ch->data[newest], HISTORY_BLOCK_SIZE, 1);
+		codec_write(&ch->writer, tick, &value);   // one sample always fits an empty block
+	}
+
+	newest = HISTORY_NEWEST(ch);
+	ch->len[newest] = (uint8_t)ch->writer.len;
+	ch->count[newest] = (uint8_t)ch->writer.count;
+	ch->stored++;
+}
+
+
+// FUNCTION      : history_push
+// DESCRIPTION   :
+//   Store a sample, dropping the oldest ones once the blocks are full, and
+//   update the window statistics. O(1).
+// PARAMETERS    :
+//   uint8_t channel : HISTORY_HUMIDITY, HISTORY_TEMPERATURE or HISTORY_LIGHT
+//   uint32_t tick   : HAL tick the sample was taken at
+//   int32_t value   : the reading
+// RETURNS       :
+//   nothing
+void history_push(uint8_t channel, uint32_t tick, int32_t value)
+{
+	history_channel_t *ch;
+	uint32_t seq;
+
+	if (channel >= HISTORY_CHANNELS) return;
+	ch = &historyChannels[channel];
+	seq = ch->pushed;
+
+	if (seq >= HISTORY_WINDOW) {
+		int32_t leaving = HISTORY_VALUE(ch, seq - HISTORY_WINDOW);
+		ch->sum -= leaving;
+		ch->sumSq -= (int64_t)leaving * leaving;
+	}
+	HISTORY_VALUE(ch, seq) = value;
+	history_store(ch, tick, value);
+	ch->sum += value;
+	ch->sumSq += (int64_t)value * value;
+
+	history_deque_push(ch, &ch->minQ, seq, value, -1);
+	history_deque_push(ch, &ch->maxQ, seq, value, 1);
+	ch->pushed = seq + 1;
+}
+
+
+// FUNCTION      : history_stats
+// DESCRIPTION   :
+//   Mean, variance, min and max of the newest HISTORY_WINDOW samples (fewer
+//   until that many have been pushed). O(1).
+// PARAMETERS    :
+//   uint8_t channel        : channel to look at
+//   history_stats_t *stats : where to store the results
+// RETURNS       :
+//   nothing
+void history_stats(uint8_t channel, history_stats_t *stats)
+{
+	history_channel_t *ch;
+	uint32_t n;
+
+	stats->count = 0;
+	if (channel >= HISTORY_CHANNELS) return;
+	ch = &historyChannels[channel];
+	if (ch->pushed == 0) return;
+
+	n = (ch->pushed < HISTORY_WINDOW) ? ch->pushed : HISTORY_WINDOW;
+	stats->count = (uint16_t)n;
+	stats->mean = (float)ch->sum / n;
+	// n * sum(x^2) - sum(x)^2 is exact in integers and never negative
+	stats->variance = (float)(n * ch->sumSq - ch->sum * ch->sum) / ((float)n * n);
+	stats->min = HISTORY_VALUE(ch, DEQUE_AT(&ch->minQ, 0));
+	stats->max = HISTORY_VALUE(ch, DEQUE_AT(&ch->maxQ, 0));
+}
+
+
+uint16_t history_count(uint8_t channel)
+{
+	if (channel >= HISTORY_CHANNELS) return 0;
+	return (historyChannels[channel].stored < HISTORY_DEPTH) ? historyChannels[channel].stored : HISTORY_DEPTH;
+}
+
+
+// FUNCTION      : history_get
+// DESCRIPTION   :
+//   Read back a stored sample (decodes part of one block).
+// PARAMETERS    :
+//   uint8_t channel          : channel to read
+//   uint16_t age             : 0 for the newest sample, 1 for the one before...
+//   history_sample_t *sample : where to store it
+// RETURNS       :
+//   1 if the sample exists, 0 if age is beyond what is stored
+uint8_t history_get(uint8_t channel, uint16_t age, history_sample_t *sample)
+{
+	history_channel_t *ch;
+	codec_reader_t reader;
+	uint8_t block;
+	uint16_t i;
+
+	if (age >= history_count(channel)) return 0;
+	ch = &historyChannels[channel];
+
+	// Find the block, newest first; age becomes the age within it
+	block = HISTORY_NEWEST(ch);
+	while (age >= ch->count[block]) {
+		age -= ch->count[block];
+		block = (block + HISTORY_BLOCKS - 1) % HISTORY_BLOCKS;
+	}
+
+	codec_reader_init(&reader, ch->data[block], ch->len[block], 1);
+	for (i = ch->count[block] - age; i > 0; i--) {
+		if (!codec_read(&reader, &sample->tick, &sample->value)) return 0;
+	}
+	return 1;
+}
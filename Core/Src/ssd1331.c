@@ -20,13 +20,15 @@
 
 #include <stdio.h>
 #include <stdint.h>
+#include <string.h>
 
 
 /* Includes ------------------------------------------------------------------*/
 //#include "common.h"
 #include "main.h"
 #include "ssd1331.h"
-#include "fonts.h"
+#include "fontAtlas.h"
+#include "profiler.h"
 
 extern SPI_HandleTypeDef hspi2;
 
@@ -34,6 +36,7 @@ extern SPI_HandleTypeDef hspi2;
 /* Private typedef -----------------------------------------------------------*/
 /* Private define ------------------------------------------------------------*/
 #define MIN(a,b)  (((a) < (b)) ? (a) : (b))
+#define MAX(a,b)  (((a) > (b)) ? (a) : (b))
 
 #define __SSD1331_RES_SET()     HAL_GPIO_WritePin(OLED_RES_GPIO_Port, OLED_RES_Pin, 1)
 #define __SSD1331_RES_CLR()     HAL_GPIO_WritePin(OLED_RES_GPIO_Port, OLED_RES_Pin, 0)
@@ -98,10 +101,149 @@ extern SPI_HandleTypeDef hspi2;
 #define SET_PRECHARGE_VOLTAGE           0xBB
 #define SET_V_VOLTAGE                   0xBE
 
+#ifdef SSD1331_USE_FRAMEBUFFER
+#define SSD1331_MAX_DIRTY_RECTS         4
+#endif
+
+#ifdef SSD1331_USE_HW_ACCEL
+/* The controller ignores the bus while it executes a graphic command. These
+ * are conservative execution times; a full-screen fill takes under 3 ms. */
+#define SSD1331_FILL_WAIT_US(__AREA)    (100 + (uint32_t)(__AREA) * 3000 / (OLED_WIDTH * OLED_HEIGHT))
+#define SSD1331_LINE_WAIT_US(__LEN)     (100 + (uint32_t)(__LEN) * 10)
+#endif
+
+#define SSD1331_GLYPH_CACHE_SIZE        8   // expanded 12/16 px characters kept ready to send
+
+#ifdef SSD1331_USE_DMA
+#define SSD1331_QUEUE_LEN               32  // pending transfers, a power of two
+#define SSD1331_INLINE_BYTES            8   // command bytes copied into the queue entry
+#endif
+
 /* Private variables ---------------------------------------------------------*/
+#ifdef SSD1331_USE_FRAMEBUFFER
+typedef struct {
+	int16_t iX0, iY0, iX1, iY1;   // inclusive bounds, already clipped to the panel
+} ssd1331_rect_t;
+
+/* Pixels are stored in panel byte order (high byte first), so any run of a row
+ * can be pushed to the controller without converting it first. */
+static uint16_t s_hwFrameBuffer[OLED_HEIGHT][OLED_WIDTH];
+static ssd1331_rect_t s_tDirtyRect[SSD1331_MAX_DIRTY_RECTS];
+static uint8_t s_chDirtyCount = 0;
+#ifdef SSD1331_USE_DMA
+/* Narrower regions are copied here by ssd1331_flush() so each goes out as one
+ * transfer; dirty regions never overlap, so together they always fit */
+static uint16_t s_hwFlushStage[OLED_HEIGHT * OLED_WIDTH];
+#endif
+#endif
+
+#ifndef SSD1331_USE_FRAMEBUFFER
+/* Staging area for one glyph (up to 16x32) in panel byte order */
+static uint16_t s_hwGlyph[16 * 32];
+#endif
+
+/* One character of FONT_1206 or FONT_1608 expanded to RGB565 in panel byte
+ * order, row by row, ready to be sent as a single window burst */
+typedef struct {
+	uint8_t chChr;
+	uint8_t chSize;          // 0 while the entry is unused
+	uint16_t hwColor;
+	uint32_t wLastUse;
+	uint16_t hwPixel[8 * 16];
+} ssd1331_glyph_t;
+
+static ssd1331_glyph_t s_tGlyphCache[SSD1331_GLYPH_CACHE_SIZE];
+static uint32_t s_wGlyphClock = 0;
+
+#ifdef SSD1331_USE_DMA
+/* One queued SPI transfer. Short command sequences are copied into the entry;
+ * longer payloads are referenced and must stay valid until sent. */
+typedef struct {
+	const uint8_t *pchData;
+	uint16_t hwLen;
+	uint8_t chDc;
+	uint8_t chInline[SSD1331_INLINE_BYTES];
+} ssd1331_xfer_t;
+
+static ssd1331_xfer_t s_tQueue[SSD1331_QUEUE_LEN];
+static volatile uint8_t s_chQueueHead = 0;   // next entry to send (advanced by the DMA callback)
+static volatile uint8_t s_chQueueTail = 0;   // next free entry (advanced by the caller)
+static volatile uint8_t s_chDmaBusy = 0;
+#endif
+
+#ifdef SSD1331_USE_HW_ACCEL
+static uint32_t s_wAccelStart = 0;   // DWT cycle count when the last graphic command was sent
+static uint32_t s_wAccelCycles = 0;  // how long the controller stays busy after it
+#endif
+
+/* Rows the controller is scrolling by itself, chRows == 0 while it isn't */
+static struct {
+	uint8_t chRow, chRows;
+} s_tScroll = { 0, 0 };
+
+/* Everything handed to HAL_SPI_Transmit(_DMA), for ssd1331_get_spi_counts() */
+static uint32_t s_wSpiBytes = 0;
+static uint32_t s_wSpiTransfers = 0;
+
+/* Power-on register setup, sent as one command transaction */
+static const uint8_t c_chInitSequence[] = {
+	DISPLAY_OFF,                    //Display Off
+	SET_CONTRAST_A,                 //Set contrast for color A
+	0xFF,                           //145 0x91
+	SET_CONTRAST_B,                 //Set contrast for color B
+	0xFF,                           //80 0x50
+	SET_CONTRAST_C,                 //Set contrast for color C
+	0xFF,                           //125 0x7D
+	MASTER_CURRENT_CONTROL,         //master current control
+	0x06,                           //6
+	SET_PRECHARGE_SPEED_A,          //Set Second Pre-change Speed For ColorA
+	0x64,                           //100
+	SET_PRECHARGE_SPEED_B,          //Set Second Pre-change Speed For ColorB
+	0x78,                           //120
+	SET_PRECHARGE_SPEED_C,          //Set Second Pre-change Speed For ColorC
+	0x64,                           //100
+	SET_REMAP,                      //set remap & data format
+	0x76,                           //0x72
+	SET_DISPLAY_START_LINE,         //Set display Start Line
+	0x0,
+	SET_DISPLAY_OFFSET,             //Set display offset
+	0x0,
+	NORMAL_DISPLAY,                 //Set display mode
+	SET_MULTIPLEX_RATIO,            //Set multiplex ratio
+	0x3F,
+	SET_MASTER_CONFIGURE,           //Set master configuration
+	0x8E,
+	POWER_SAVE_MODE,                //Set Power Save Mode
+	0x00,                           //0x00
+	PHASE_PERIOD_ADJUSTMENT,        //phase 1 and 2 period adjustment
+	0x31,                           //0x31
+	DISPLAY_CLOCK_DIV,              //display clock divider/oscillator frequency
+	0xF0,
+	SET_PRECHARGE_VOLTAGE,          //Set Pre-Change Level
+	0x3A,
+	SET_V_VOLTAGE,                  //Set vcomH
+	0x3E,
+	DEACTIVE_SCROLLING,             //disable scrolling
+	NORMAL_BRIGHTNESS_DISPLAY_ON,   //set display on
+};
+
 /* Private function prototypes -----------------------------------------------*/
 /* Private functions ---------------------------------------------------------*/
 
+#ifdef SSD1331_USE_HW_ACCEL
+/**
+  * @brief  Waits until the last graphic acceleration command has completed
+**/
+static void ssd1331_accel_wait(void)
+{
+	while ((DWT->CYCCNT - s_wAccelStart) < s_wAccelCycles) {
+	}
+	s_wAccelCycles = 0;
+}
+#else
+#define ssd1331_accel_wait()
+#endif
+
 /**
  * @brief
  * @param
@@ -109,7 +251,9 @@ extern SPI_HandleTypeDef hspi2;
  */
 
  /**
-   * @brief  Writes an byte to the display data ram or the command register
+   * @brief  Writes an byte to the display data ram or the command register.
+   *         Kept as the per-byte reference for ssd1331_benchmark(); everything
+   *         else goes through the transaction API below.
    *
    * @param  chData: Data to be writen to the display data ram or the command register
    * @param chCmd:
@@ -119,6 +263,9 @@ extern SPI_HandleTypeDef hspi2;
  **/
 static void ssd1331_write_byte(uint8_t chData, uint8_t chCmd)
 {
+	ssd1331_wait_idle(); // never interleave with a queued DMA transfer
+	ssd1331_accel_wait();
+
 	if (chCmd) {
 	 	__SSD1331_DC_SET();
 	} else {
@@ -127,29 +274,498 @@ static void ssd1331_write_byte(uint8_t chData, uint8_t chCmd)
 
 	__SSD1331_CS_CLR();
 	__SSD1331_WRITE_BYTE(chData);
+	s_wSpiBytes ++;
+	s_wSpiTransfers ++;
 
 	__SSD1331_CS_SET();
 	__SSD1331_DC_SET();
 }
 
+#ifdef SSD1331_USE_DMA
+/**
+  * @brief  Starts the transfer at the head of the queue, or releases CS when
+  *         the queue has drained. Called with interrupts masked or from the
+  *         DMA completion callback.
+**/
+static void ssd1331_dma_start_next(void)
+{
+	ssd1331_xfer_t *ptXfer;
+
+	if (s_chQueueHead == s_chQueueTail) {
+		__SSD1331_CS_SET();
+		s_chDmaBusy = 0;
+		return;
+	}
+
+	ptXfer = &s_tQueue[s_chQueueHead];
+	s_chDmaBusy = 1;
+	if (ptXfer->chDc) {
+		__SSD1331_DC_SET();
+	} else {
+		__SSD1331_DC_CLR();
+	}
+	__SSD1331_CS_CLR();
+	if (HAL_SPI_Transmit_DMA(&hspi2, ptXfer->pchData ? ptXfer->pchData : ptXfer->chInline, ptXfer->hwLen) != HAL_OK) {
+		// Drop the transfer rather than stalling the queue forever
+		s_chQueueHead = (s_chQueueHead + 1) & (SSD1331_QUEUE_LEN - 1);
+		ssd1331_dma_start_next();
+	}
+}
+
+/**
+  * @brief  Appends a transfer to the DMA queue and starts the queue if idle.
+  *         Spins only if the queue is full.
+  *
+  * @param  pchData: bytes to send
+  * @param  hwLen: number of bytes
+  * @param  chDc: SSD1331_CMD or SSD1331_DATA
+  * @param  chCopy: 1 to copy the bytes into the queue entry (at most
+  *                 SSD1331_INLINE_BYTES), 0 to reference them in place
+  * @retval None
+**/
+static void ssd1331_dma_enqueue(const uint8_t *pchData, uint16_t hwLen, uint8_t chDc, uint8_t chCopy)
+{
+	ssd1331_xfer_t *ptXfer;
+	uint8_t chNext = (s_chQueueTail + 1) & (SSD1331_QUEUE_LEN - 1);
+	uint32_t wPrimask;
+
+	if (hwLen == 0) {
+		return;
+	}
+	if (!s_chDmaBusy) {
+		ssd1331_accel_wait(); // the queue is about to restart the bus
+	}
+	while (chNext == s_chQueueHead) {
+		// queue full: wait for the DMA callback to retire an entry
+	}
+
+	ptXfer = &s_tQueue[s_chQueueTail];
+	ptXfer->hwLen = hwLen;
+	ptXfer->chDc = chDc;
+	if (chCopy) {
+		memcpy(ptXfer->chInline, pchData, hwLen);
+		ptXfer->pchData = NULL;
+	} else {
+		ptXfer->pchData = pchData;
+	}
+
+	wPrimask = __get_PRIMASK();
+	__disable_irq();
+	s_chQueueTail = chNext;
+	if (!s_chDmaBusy) {
+		ssd1331_dma_start_next();
+	}
+	__set_PRIMASK(wPrimask);
+}
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+	if (hspi->Instance == SPI2) {
+		s_chQueueHead = (s_chQueueHead + 1) & (SSD1331_QUEUE_LEN - 1);
+		ssd1331_dma_start_next();
+	}
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+	if (hspi->Instance == SPI2) {
+		s_chQueueHead = (s_chQueueHead + 1) & (SSD1331_QUEUE_LEN - 1);
+		ssd1331_dma_start_next();
+	}
+}
+#endif
+
+#ifndef SSD1331_USE_DMA
+static uint8_t s_chDcLevel = 0xFF;  // level DC was last driven to inside a transaction, 0xFF outside
+#endif
+
+/**
+  * @brief  Sends a run of command or data bytes inside a transaction. DC is
+  *         only switched when the kind of byte changes.
+**/
+static void ssd1331_send(const uint8_t *pchData, uint16_t hwLen, uint8_t chDc)
+{
+	if (hwLen == 0) {
+		return;
+	}
+	s_wSpiBytes += hwLen;
+	s_wSpiTransfers ++;
+#ifdef SSD1331_USE_DMA
+	// Short runs usually live on the caller's stack, so they are copied
+	ssd1331_dma_enqueue(pchData, hwLen, chDc, hwLen <= SSD1331_INLINE_BYTES);
+#else
+	if (chDc != s_chDcLevel) {
+		if (chDc) {
+			__SSD1331_DC_SET();
+		} else {
+			__SSD1331_DC_CLR();
+		}
+		s_chDcLevel = chDc;
+	}
+	HAL_SPI_Transmit(&hspi2, pchData, hwLen, 100);
+#endif
+}
+
+/**
+  * @brief  Starts a transaction. CS stays low until ssd1331_end(), so any
+  *         number of command and data runs can follow without toggling it.
+  *
+  * @retval None
+**/
+void ssd1331_begin(void)
+{
+#ifndef SSD1331_USE_DMA
+	ssd1331_accel_wait();
+	__SSD1331_CS_CLR();
+	s_chDcLevel = 0xFF;
+#endif
+}
+
+/**
+  * @brief  Sends command bytes inside a transaction
+  *
+  * @param  pchCmd: command bytes, including their parameters
+  * @param  hwLen: number of bytes
+  * @retval None
+**/
+void ssd1331_write_cmd(const uint8_t *pchCmd, uint16_t hwLen)
+{
+	ssd1331_send(pchCmd, hwLen, SSD1331_CMD);
+}
+
+/**
+  * @brief  Sends display data inside a transaction. With DMA enabled, buffers
+  *         longer than SSD1331_INLINE_BYTES are sent in place and must not
+  *         change until ssd1331_is_busy() returns 0.
+  *
+  * @param  pchData: pixel data, high byte first
+  * @param  hwLen: number of bytes
+  * @retval None
+**/
+void ssd1331_write_data(const uint8_t *pchData, uint16_t hwLen)
+{
+	ssd1331_send(pchData, hwLen, SSD1331_DATA);
+}
+
+/**
+  * @brief  Ends a transaction. The DMA queue releases CS by itself once it
+  *         drains, so this returns before the bytes are sent in that build.
+  *
+  * @retval None
+**/
+void ssd1331_end(void)
+{
+#ifndef SSD1331_USE_DMA
+	__SSD1331_CS_SET();
+	__SSD1331_DC_SET();
+	s_chDcLevel = 0xFF;
+#endif
+}
+
+/* Points the controller's write window at an inclusive, on-screen region */
+static void ssd1331_set_window(uint8_t chX0, uint8_t chY0, uint8_t chX1, uint8_t chY1)
+{
+	uint8_t chCmd[6] = { SET_COLUMN_ADDRESS, chX0, chX1, SET_ROW_ADDRESS, chY0, chY1 };
+
+	ssd1331_write_cmd(chCmd, sizeof(chCmd));
+}
+
+/**
+  * @brief  Returns 1 while queued transfers are still being sent to the panel
+  *         or the controller is still executing a graphic acceleration command
+  *         (the latter is timed in core cycles, so don't change clocks meanwhile)
+**/
+uint8_t ssd1331_is_busy(void)
+{
+#ifdef SSD1331_USE_HW_ACCEL
+	if ((DWT->CYCCNT - s_wAccelStart) < s_wAccelCycles) {
+		return 1;
+	}
+#endif
+#ifdef SSD1331_USE_DMA
+	return s_chDmaBusy || s_chQueueHead != s_chQueueTail;
+#else
+	return 0;
+#endif
+}
+
+/**
+  * @brief  Blocks until every queued transfer has been sent
+**/
+void ssd1331_wait_idle(void)
+{
+	while (ssd1331_is_busy()) {
+	}
+}
+
+#ifdef SSD1331_USE_FRAMEBUFFER
+static int32_t ssd1331_rect_area(const ssd1331_rect_t *ptRect)
+{
+	return (int32_t)(ptRect->iX1 - ptRect->iX0 + 1) * (ptRect->iY1 - ptRect->iY0 + 1);
+}
+
+static void ssd1331_rect_union(ssd1331_rect_t *ptDst, const ssd1331_rect_t *ptSrc)
+{
+	if (ptSrc->iX0 < ptDst->iX0) ptDst->iX0 = ptSrc->iX0;
+	if (ptSrc->iY0 < ptDst->iY0) ptDst->iY0 = ptSrc->iY0;
+	if (ptSrc->iX1 > ptDst->iX1) ptDst->iX1 = ptSrc->iX1;
+	if (ptSrc->iY1 > ptDst->iY1) ptDst->iY1 = ptSrc->iY1;
+}
+
+/* Overlapping or edge-adjacent rectangles are cheaper to send as one window */
+static uint8_t ssd1331_rect_touches(const ssd1331_rect_t *ptA, const ssd1331_rect_t *ptB)
+{
+	return ptA->iX0 <= ptB->iX1 + 1 && ptB->iX0 <= ptA->iX1 + 1 &&
+	       ptA->iY0 <= ptB->iY1 + 1 && ptB->iY0 <= ptA->iY1 + 1;
+}
+
+/**
+  * @brief  Records a region of the framebuffer that differs from the panel
+  *
+  * @param  iX0, iY0: top-left corner (may lie outside the panel)
+  * @param  iX1, iY1: bottom-right corner, inclusive
+  * @retval None
+**/
+static void ssd1331_mark_dirty(int16_t iX0, int16_t iY0, int16_t iX1, int16_t iY1)
+{
+	ssd1331_rect_t tRect;
+	uint8_t i, chBest = 0;
+	int32_t wGrowth, wBestGrowth = INT32_MAX;
+
+	if (iX0 < 0) iX0 = 0;
+	if (iY0 < 0) iY0 = 0;
+	if (iX1 > OLED_WIDTH - 1) iX1 = OLED_WIDTH - 1;
+	if (iY1 > OLED_HEIGHT - 1) iY1 = OLED_HEIGHT - 1;
+	if (iX0 > iX1 || iY0 > iY1) {
+		return;
+	}
+	tRect.iX0 = iX0; tRect.iY0 = iY0; tRect.iX1 = iX1; tRect.iY1 = iY1;
+
+	// Grow an existing rectangle if the new one overlaps it, then fold any
+	// rectangles the grown one now reaches into it as well
+	for (i = 0; i < s_chDirtyCount; i ++) {
+		if (ssd1331_rect_touches(&s_tDirtyRect[i], &tRect)) {
+			ssd1331_rect_union(&tRect, &s_tDirtyRect[i]);
+			s_tDirtyRect[i] = s_tDirtyRect[-- s_chDirtyCount];
+			i = (uint8_t)-1; // restart the scan with the grown rectangle
+		}
+	}
+
+	if (s_chDirtyCount < SSD1331_MAX_DIRTY_RECTS) {
+		s_tDirtyRect[s_chDirtyCount ++] = tRect;
+		return;
+	}
+
+	// List is full: merge into whichever rectangle grows the least
+	for (i = 0; i < s_chDirtyCount; i ++) {
+		ssd1331_rect_t tMerged = s_tDirtyRect[i];
+		ssd1331_rect_union(&tMerged, &tRect);
+		wGrowth = ssd1331_rect_area(&tMerged) - ssd1331_rect_area(&s_tDirtyRect[i]);
+		if (wGrowth < wBestGrowth) {
+			wBestGrowth = wGrowth;
+			chBest = i;
+		}
+	}
+	ssd1331_rect_union(&s_tDirtyRect[chBest], &tRect);
+}
+#else
+#define ssd1331_mark_dirty(iX0, iY0, iX1, iY1)
+#endif
+
+/**
+  * @brief  Sets one pixel without touching the dirty list (framebuffer build)
+  *         or writes it straight to the panel (direct build)
+**/
+static void ssd1331_plot(uint8_t chXpos, uint8_t chYpos, uint16_t hwColor)
+{
+	if (chXpos >= OLED_WIDTH || chYpos >= OLED_HEIGHT) {
+		return;
+	}
+
+#ifdef SSD1331_USE_FRAMEBUFFER
+	s_hwFrameBuffer[chYpos][chXpos] = (uint16_t)((hwColor >> 8) | (hwColor << 8));
+#else
+	uint8_t chPixel[2] = { hwColor >> 8, hwColor };
+
+	ssd1331_begin();
+	ssd1331_set_window(chXpos, chYpos, OLED_WIDTH - 1, OLED_HEIGHT - 1);
+	ssd1331_write_data(chPixel, sizeof(chPixel));
+	ssd1331_end();
+#endif
+}
+
 void ssd1331_draw_point(uint8_t chXpos, uint8_t chYpos, uint16_t hwColor)
 {
 	if (chXpos >= OLED_WIDTH || chYpos >= OLED_HEIGHT) {
 		return;
 	}
 
-    //set column point
-    ssd1331_write_byte(SET_COLUMN_ADDRESS, SSD1331_CMD);
-    ssd1331_write_byte(chXpos, SSD1331_CMD);
-    ssd1331_write_byte(OLED_WIDTH - 1, SSD1331_CMD);
-    //set row point
-    ssd1331_write_byte(SET_ROW_ADDRESS, SSD1331_CMD);
-    ssd1331_write_byte(chYpos, SSD1331_CMD);
-    ssd1331_write_byte(OLED_HEIGHT - 1, SSD1331_CMD);
+	ssd1331_plot(chXpos, chYpos, hwColor);
+	ssd1331_mark_dirty(chXpos, chYpos, chXpos, chYpos);
+}
+
+#ifdef SSD1331_USE_FRAMEBUFFER
+/* Fills an inclusive, on-screen region of the framebuffer */
+static void ssd1331_fb_fill(uint8_t chX0, uint8_t chY0, uint8_t chX1, uint8_t chY1, uint16_t hwColor)
+{
+	uint16_t hwPixel = (uint16_t)((hwColor >> 8) | (hwColor << 8));
+	uint8_t i, j;
+
+	for (i = chY0; i <= chY1; i ++) {
+		for (j = chX0; j <= chX1; j ++) {
+			s_hwFrameBuffer[i][j] = hwPixel;
+		}
+	}
+}
+
+/**
+  * @brief  Sends one run of a framebuffer row straight to the panel, clipped.
+  *         Outlines go out this way instead of through the dirty list, which
+  *         merges touching regions: the runs of a circle would end up as its
+  *         whole bounding box, mostly pixels that didn't change.
+**/
+static void ssd1331_send_run(int16_t iX0, int16_t iX1, int16_t iY)
+{
+	iX0 = MAX(iX0, 0);
+	iX1 = MIN(iX1, OLED_WIDTH - 1);
+	if (iY < 0 || iY >= OLED_HEIGHT || iX0 > iX1) {
+		return;
+	}
+
+	ssd1331_stop_scroll();
+	ssd1331_begin();
+	ssd1331_set_window(iX0, iY, iX1, iY);
+	ssd1331_write_data((const uint8_t *)&s_hwFrameBuffer[iY][iX0], (uint16_t)(iX1 - iX0 + 1) * 2);
+	ssd1331_end();
+}
+
+/* Sends the runs of one row offset of a circle, at iDy above and below the
+ * centre, iLo..iHi pixels either side of it */
+static void ssd1331_send_circle_row(int16_t iX, int16_t iY, int16_t iDy, int16_t iLo, int16_t iHi)
+{
+	int16_t iRow = iY - iDy;
+
+	for (;;) {
+		if (iLo <= 2) {
+			// Resending a gap this narrow is cheaper than a second window setup
+			ssd1331_send_run(iX - iHi, iX + iHi, iRow);
+		} else {
+			ssd1331_send_run(iX - iHi, iX - iLo, iRow);
+			ssd1331_send_run(iX + iLo, iX + iHi, iRow);
+		}
+		if (iDy == 0 || iRow == iY + iDy) {
+			break;
+		}
+		iRow = iY + iDy;
+	}
+}
+#else
+#define ssd1331_send_run(iX0, iX1, iY)                          ((void)(iX0), (void)(iX1), (void)(iY))
+#define ssd1331_send_circle_row(iX, iY, iDy, iLo, iHi)          ((void)(iLo), (void)(iHi))
+#endif
+
+#ifdef SSD1331_USE_HW_ACCEL
+/**
+  * @brief  Sends one graphic acceleration command and notes how long the
+  *         controller will be busy with it. The wait happens lazily, right
+  *         before the next access to the panel.
+**/
+static void ssd1331_accel_cmd(const uint8_t *pchCmd, uint8_t chLen, uint32_t wWaitUs)
+{
+	ssd1331_stop_scroll();
+	ssd1331_wait_idle();
+	ssd1331_accel_wait();
+
+	__SSD1331_DC_CLR();
+	__SSD1331_CS_CLR();
+	HAL_SPI_Transmit(&hspi2, pchCmd, chLen, 100);
+	__SSD1331_CS_SET();
+	__SSD1331_DC_SET();
+	s_wSpiBytes += chLen;
+	s_wSpiTransfers ++;
+
+	s_wAccelStart = DWT->CYCCNT;
+	s_wAccelCycles = wWaitUs * (SystemCoreClock / 1000000);
+}
+
+/* Graphic commands take colours as three 6-bit components (C, B, A) */
+static uint8_t *ssd1331_accel_color(uint8_t *pchDst, uint16_t hwColor)
+{
+	*pchDst ++ = (uint8_t)((hwColor >> 11) << 1);
+	*pchDst ++ = (uint8_t)((hwColor >> 5) & 0x3F);
+	*pchDst ++ = (uint8_t)((hwColor << 1) & 0x3F);
+	return pchDst;
+}
+
+/* Draws an inclusive, on-screen rectangle, either filled or as an outline */
+static void ssd1331_accel_rect(uint8_t chX0, uint8_t chY0, uint8_t chX1, uint8_t chY1, uint16_t hwColor, uint8_t chFill)
+{
+	uint8_t chCmd[13], *pchCmd = chCmd;
+	uint32_t wArea = (uint32_t)(chX1 - chX0 + 1) * (chY1 - chY0 + 1);
+
+	if (chFill && hwColor == BLACK) {
+		// Clearing needs no colour bytes
+		*pchCmd ++ = CLEAR_WINDOW;
+	} else {
+		*pchCmd ++ = FILL_WINDOW;
+		*pchCmd ++ = chFill ? ENABLE_FILL : DISABLE_FILL;
+		*pchCmd ++ = DRAW_RECTANGLE;
+	}
+	*pchCmd ++ = chX0;
+	*pchCmd ++ = chY0;
+	*pchCmd ++ = chX1;
+	*pchCmd ++ = chY1;
+	if (chCmd[0] != CLEAR_WINDOW) {
+		pchCmd = ssd1331_accel_color(pchCmd, hwColor); // outline
+		pchCmd = ssd1331_accel_color(pchCmd, hwColor); // fill
+	}
+	ssd1331_accel_cmd(chCmd, pchCmd - chCmd, SSD1331_FILL_WAIT_US(chFill ? wArea : (chX1 - chX0 + chY1 - chY0) * 2));
+}
+
+#ifdef SSD1331_USE_FRAMEBUFFER
+/* Drops dirty rectangles that a hardware fill has just overwritten */
+static void ssd1331_forget_dirty(uint8_t chX0, uint8_t chY0, uint8_t chX1, uint8_t chY1)
+{
+	uint8_t i = 0;
+
+	while (i < s_chDirtyCount) {
+		const ssd1331_rect_t *ptRect = &s_tDirtyRect[i];
+		if (ptRect->iX0 >= chX0 && ptRect->iX1 <= chX1 && ptRect->iY0 >= chY0 && ptRect->iY1 <= chY1) {
+			s_tDirtyRect[i] = s_tDirtyRect[-- s_chDirtyCount];
+		} else {
+			i ++;
+		}
+	}
+}
+#endif
+#endif
+
+/**
+  * @brief  Paints an inclusive, on-screen region a single colour using
+  *         whichever backend is enabled
+**/
+static void ssd1331_solid(uint8_t chX0, uint8_t chY0, uint8_t chX1, uint8_t chY1, uint16_t hwColor)
+{
+#ifdef SSD1331_USE_FRAMEBUFFER
+	ssd1331_fb_fill(chX0, chY0, chX1, chY1, hwColor);
+#ifdef SSD1331_USE_HW_ACCEL
+	// The controller produces the same pixels, so the region is clean afterwards
+	ssd1331_forget_dirty(chX0, chY0, chX1, chY1);
+	ssd1331_accel_rect(chX0, chY0, chX1, chY1, hwColor, 1);
+#else
+	ssd1331_mark_dirty(chX0, chY0, chX1, chY1);
+#endif
+#elif defined(SSD1331_USE_HW_ACCEL)
+	ssd1331_accel_rect(chX0, chY0, chX1, chY1, hwColor, 1);
+#else
+	uint8_t i, j;
 
-    //fill 16bit colour
-	ssd1331_write_byte(hwColor >> 8, SSD1331_DATA);
-	ssd1331_write_byte(hwColor, SSD1331_DATA);
+	for (i = chY0; i <= chY1; i ++) {
+		for (j = chX0; j <= chX1; j ++) {
+			ssd1331_plot(j, i, hwColor);
+		}
+	}
+#endif
 }
 
 void ssd1331_draw_line(uint8_t chXpos0, uint8_t chYpos0, uint8_t chXpos1, uint8_t chYpos1, uint16_t hwColor)
@@ -164,8 +780,42 @@ void ssd1331_draw_line(uint8_t chXpos0, uint8_t chYpos0, uint8_t chXpos1, uint8_
 		return;
 	}
 
+	if (chXpos0 == chXpos1 || chYpos0 == chYpos1) {
+		ssd1331_solid(MIN(chXpos0, chXpos1), MIN(chYpos0, chYpos1), MAX(chXpos0, chXpos1), MAX(chYpos0, chYpos1), hwColor);
+		return;
+	}
+
+#ifdef SSD1331_USE_HW_ACCEL
+	uint8_t chCmd[8] = { DRAW_LINE, chXpos0, chYpos0, chXpos1, chYpos1 };
+	ssd1331_accel_color(&chCmd[5], hwColor);
+	ssd1331_accel_cmd(chCmd, sizeof(chCmd), SSD1331_LINE_WAIT_US(MAX(dx, -dy)));
+#ifdef SSD1331_USE_FRAMEBUFFER
+	// Keep the RAM copy in step without marking it dirty, as for fills. The
+	// controller's rasteriser may place a pixel differently from ours; the next
+	// flush that covers it puts the RAM copy's one back.
+    for (;;){
+        ssd1331_plot(chXpos0, chYpos0 , hwColor);
+        ssd1331_forget_dirty(chXpos0, chYpos0, chXpos0, chYpos0);
+        e2 = 2 * err;
+        if (e2 >= dy) {
+            if (chXpos0 == chXpos1) break;
+            err += dy; chXpos0 += sx;
+        }
+        if (e2 <= dx) {
+            if (chYpos0 == chYpos1) break;
+            err += dx; chYpos0 += sy;
+        }
+    }
+#else
+	(void)sx; (void)sy; (void)err; (void)e2;
+#endif
+#else
+	// Each row's run goes to the panel once the line leaves that row
+	uint8_t chRunX = chXpos0, chLastX;
+
     for (;;){
-        ssd1331_draw_point(chXpos0, chYpos0 , hwColor);
+        ssd1331_plot(chXpos0, chYpos0 , hwColor);
+        chLastX = chXpos0;
         e2 = 2 * err;
         if (e2 >= dy) {
             if (chXpos0 == chXpos1) break;
@@ -173,35 +823,35 @@ void ssd1331_draw_line(uint8_t chXpos0, uint8_t chYpos0, uint8_t chXpos1, uint8_
         }
         if (e2 <= dx) {
             if (chYpos0 == chYpos1) break;
+            ssd1331_send_run(MIN(chRunX, chLastX), MAX(chRunX, chLastX), chYpos0);
             err += dx; chYpos0 += sy;
+            chRunX = chXpos0;
         }
     }
+    ssd1331_send_run(MIN(chRunX, chLastX), MAX(chRunX, chLastX), chYpos0);
+#endif
 }
 
 void ssd1331_draw_v_line(uint8_t chXpos, uint8_t chYpos, uint8_t chHeight, uint16_t hwColor)
 {
-  uint16_t i, y1 = MIN(chYpos + chHeight, OLED_HEIGHT - 1);
+  uint16_t y1 = MIN(chYpos + chHeight, OLED_HEIGHT - 1);
 
-	if (chXpos >= OLED_WIDTH || chYpos >= OLED_HEIGHT) {
+	if (chXpos >= OLED_WIDTH || chYpos >= OLED_HEIGHT || y1 <= chYpos) {
 		return;
 	}
 
-    for (i = chYpos; i < y1; i ++) {
-        ssd1331_draw_point(chXpos, i, hwColor);
-    }
+	ssd1331_solid(chXpos, chYpos, chXpos, y1 - 1, hwColor);
 }
 
 void ssd1331_draw_h_line(uint8_t chXpos, uint8_t chYpos, uint8_t chWidth, uint16_t hwColor)
 {
-	uint16_t i, x1 = MIN(chXpos + chWidth, OLED_WIDTH- 1);
+	uint16_t x1 = MIN(chXpos + chWidth, OLED_WIDTH- 1);
 
-	if (chXpos >= OLED_WIDTH || chYpos >= OLED_HEIGHT) {
+	if (chXpos >= OLED_WIDTH || chYpos >= OLED_HEIGHT || x1 <= chXpos) {
 		return;
 	}
 
-    for (i = chXpos; i < x1; i ++) {
-        ssd1331_draw_point(i, chYpos, hwColor);
-    }
+	ssd1331_solid(chXpos, chYpos, x1 - 1, chYpos, hwColor);
 }
 
 void ssd1331_draw_rect(uint8_t chXpos, uint8_t chYpos, uint8_t chWidth, uint8_t chHeight, uint16_t hwColor)
@@ -210,6 +860,20 @@ void ssd1331_draw_rect(uint8_t chXpos, uint8_t chYpos, uint8_t chWidth, uint8_t
 		return;
 	}
 
+#ifdef SSD1331_USE_HW_ACCEL
+	// One outline command when nothing needs clipping
+	if (chXpos + chWidth < OLED_WIDTH - 1 && chYpos + chHeight < OLED_HEIGHT - 1) {
+#ifdef SSD1331_USE_FRAMEBUFFER
+		ssd1331_fb_fill(chXpos, chYpos, chXpos + chWidth, chYpos, hwColor);
+		ssd1331_fb_fill(chXpos, chYpos + chHeight, chXpos + chWidth, chYpos + chHeight, hwColor);
+		ssd1331_fb_fill(chXpos, chYpos, chXpos, chYpos + chHeight, hwColor);
+		ssd1331_fb_fill(chXpos + chWidth, chYpos, chXpos + chWidth, chYpos + chHeight, hwColor);
+#endif
+		ssd1331_accel_rect(chXpos, chYpos, chXpos + chWidth, chYpos + chHeight, hwColor, 0);
+		return;
+	}
+#endif
+
 	ssd1331_draw_h_line(chXpos, chYpos, chWidth, hwColor);
 	ssd1331_draw_h_line(chXpos, chYpos + chHeight, chWidth, hwColor);
 	ssd1331_draw_v_line(chXpos, chYpos, chHeight, hwColor);
@@ -218,32 +882,36 @@ void ssd1331_draw_rect(uint8_t chXpos, uint8_t chYpos, uint8_t chWidth, uint8_t
 
 void ssd1331_fill_rect(uint8_t chXpos, uint8_t chYpos, uint8_t chWidth, uint8_t chHeight, uint16_t hwColor)
 {
-	uint16_t i, j;
-
-	if (chXpos >= OLED_WIDTH || chYpos >= OLED_HEIGHT) {
+	if (chXpos >= OLED_WIDTH || chYpos >= OLED_HEIGHT || chWidth == 0 || chHeight == 0) {
 		return;
 	}
 
-	for(i = 0; i < chHeight; i ++){
-		for(j = 0; j < chWidth; j ++){
-			ssd1331_draw_point(chXpos + j, chYpos + i, hwColor);
-		}
-	}
+	PROF_BEGIN(PROF_OLED_FILL);
+	ssd1331_solid(chXpos, chYpos, MIN(chXpos + chWidth, OLED_WIDTH) - 1, MIN(chYpos + chHeight, OLED_HEIGHT) - 1, hwColor);
+	PROF_END(PROF_OLED_FILL);
 }
 
 void ssd1331_draw_circle(uint8_t chXpos, uint8_t chYpos, uint8_t chRadius, uint16_t hwColor)
 {
 	int x = -chRadius, y = 0, err = 2 - 2 * chRadius, e2;
+	int iRowY = 0, iRowHi = chRadius, iRowLo = chRadius;  // span of |x| plotted at the current y
 
 	if (chXpos >= OLED_WIDTH || chYpos >= OLED_HEIGHT) {
 		return;
 	}
 
     do {
-        ssd1331_draw_point(chXpos - x, chYpos + y, hwColor);
-        ssd1331_draw_point(chXpos + x, chYpos + y, hwColor);
-        ssd1331_draw_point(chXpos + x, chYpos - y, hwColor);
-        ssd1331_draw_point(chXpos - x, chYpos - y, hwColor);
+        if (y != iRowY) {
+            // y only grows, so that row offset is complete: send its runs
+            ssd1331_send_circle_row(chXpos, chYpos, iRowY, iRowLo, iRowHi);
+            iRowY = y;
+            iRowHi = -x;
+        }
+        iRowLo = -x;
+        ssd1331_plot(chXpos - x, chYpos + y, hwColor);
+        ssd1331_plot(chXpos + x, chYpos + y, hwColor);
+        ssd1331_plot(chXpos + x, chYpos - y, hwColor);
+        ssd1331_plot(chXpos - x, chYpos - y, hwColor);
         e2 = err;
         if (e2 <= y) {
             err += ++ y * 2 + 1;
@@ -251,6 +919,142 @@ void ssd1331_draw_circle(uint8_t chXpos, uint8_t chYpos, uint8_t chRadius, uint1
         }
         if(e2 > x) err += ++ x * 2 + 1;
     } while(x <= 0);
+    ssd1331_send_circle_row(chXpos, chYpos, iRowY, iRowLo, iRowHi);
+}
+
+#define NIBBLE_LANES(__N)  ((((__N) & 8) ? 0xFFFFULL : 0) | (((__N) & 4) ? 0xFFFFULL << 16 : 0) | \
+                            (((__N) & 2) ? 0xFFFFULL << 32 : 0) | (((__N) & 1) ? 0xFFFFULL << 48 : 0))
+
+/* Masks for the four pixels of an atlas nibble, leftmost pixel in the lowest
+ * 16 bits (the first in memory, the core is little-endian) */
+static const uint64_t c_wNibbleLanes[16] = {
+	NIBBLE_LANES(0),  NIBBLE_LANES(1),  NIBBLE_LANES(2),  NIBBLE_LANES(3),
+	NIBBLE_LANES(4),  NIBBLE_LANES(5),  NIBBLE_LANES(6),  NIBBLE_LANES(7),
+	NIBBLE_LANES(8),  NIBBLE_LANES(9),  NIBBLE_LANES(10), NIBBLE_LANES(11),
+	NIBBLE_LANES(12), NIBBLE_LANES(13), NIBBLE_LANES(14), NIBBLE_LANES(15),
+};
+
+/**
+  * @brief  Expands the first chWidth pixels of an atlas row (at most 16):
+  *         set bits become hwPixel, clear ones 0. Two table lookups per
+  *         byte instead of a test per pixel.
+**/
+static void ssd1331_expand_row(uint16_t *phwDst, const uint8_t *pchRow, uint8_t chRowBytes, uint8_t chWidth, uint16_t hwPixel)
+{
+	uint64_t wLanes[4], wColor = hwPixel * 0x0001000100010001ULL;
+	uint8_t i;
+
+	for (i = 0; i < chRowBytes; i ++) {
+		wLanes[2 * i] = c_wNibbleLanes[pchRow[i] >> 4] & wColor;
+		wLanes[2 * i + 1] = c_wNibbleLanes[pchRow[i] & 0x0F] & wColor;
+	}
+	memcpy(phwDst, wLanes, chWidth * sizeof(uint16_t));
+}
+
+static const font_atlas_t *ssd1331_font(uint8_t chSize)
+{
+	return (FONT_1206 == chSize) ? &c_tFontAtlas1206 : &c_tFontAtlas1608;
+}
+
+/**
+  * @brief  Draws one glyph of the atlas (see fontAtlas.h), clipped to the
+  *         panel. In the direct build the glyph goes out as a single
+  *         transaction.
+  *
+  * @param  ptFont: font the glyph belongs to
+  * @param  chGlyph: index of the glyph in the font, not the character
+  * @param  chOpaque: 1 to paint clear bits black, 0 to leave them untouched
+  * @retval None
+**/
+static void ssd1331_draw_glyph(uint8_t chXpos, uint8_t chYpos, const font_atlas_t *ptFont, uint8_t chGlyph, uint16_t hwColor, uint8_t chOpaque)
+{
+	const uint8_t *pchRow = ptFont->pchRows + (uint16_t)chGlyph * ptFont->chHeight * ptFont->chRowBytes;
+	uint16_t hwPixel = (uint16_t)((hwColor >> 8) | (hwColor << 8)), hwMask[16];
+	uint8_t chW, chH, i, j;
+
+	if (chXpos >= OLED_WIDTH || chYpos >= OLED_HEIGHT) {
+		return;
+	}
+	chW = MIN(ptFont->chWidth, OLED_WIDTH - chXpos);
+	chH = MIN(ptFont->chHeight, OLED_HEIGHT - chYpos);
+	ssd1331_mark_dirty(chXpos, chYpos, chXpos + chW - 1, chYpos + chH - 1);
+
+#ifdef SSD1331_USE_FRAMEBUFFER
+	for (j = 0; j < chH; j ++, pchRow += ptFont->chRowBytes) {
+		uint16_t *phwDst = &s_hwFrameBuffer[chYpos + j][chXpos];
+
+		ssd1331_expand_row(hwMask, pchRow, ptFont->chRowBytes, chW, 0xFFFF);
+		for (i = 0; i < chW; i ++) {
+			phwDst[i] = (chOpaque ? 0 : (phwDst[i] & ~hwMask[i])) | (hwPixel & hwMask[i]);
+		}
+	}
+#else
+	uint16_t *phwRow;
+	uint8_t chStart;
+
+	ssd1331_wait_idle(); // the previous glyph may still be queued from s_hwGlyph
+	ssd1331_begin();
+	if (chOpaque) {
+		for (j = 0; j < chH; j ++, pchRow += ptFont->chRowBytes) {
+			ssd1331_expand_row(&s_hwGlyph[j * chW], pchRow, ptFont->chRowBytes, chW, hwPixel);
+		}
+		ssd1331_set_window(chXpos, chYpos, chXpos + chW - 1, chYpos + chH - 1);
+		ssd1331_write_data((const uint8_t *)s_hwGlyph, (uint16_t)chW * chH * 2);
+	} else {
+		// The panel cannot be read back, so only runs of set pixels are sent
+		for (j = 0; j < chH; j ++, pchRow += ptFont->chRowBytes) {
+			phwRow = &s_hwGlyph[j * chW];
+			ssd1331_expand_row(hwMask, pchRow, ptFont->chRowBytes, chW, 0xFFFF);
+			for (i = 0; i < chW; ) {
+				if (!hwMask[i]) {
+					i ++;
+					continue;
+				}
+				for (chStart = i; i < chW && hwMask[i]; i ++) {
+					phwRow[i] = hwPixel;
+				}
+				ssd1331_set_window(chXpos + chStart, chYpos + j, chXpos + i - 1, chYpos + j);
+				ssd1331_write_data((const uint8_t *)&phwRow[chStart], (i - chStart) * 2);
+			}
+		}
+	}
+	ssd1331_end();
+#endif
+}
+
+/**
+  * @brief  Returns the expanded pixels of a character, expanding it into the
+  *         least recently used cache entry on a miss
+**/
+static const ssd1331_glyph_t *ssd1331_glyph_lookup(uint8_t chChr, uint8_t chSize, uint16_t hwColor)
+{
+	const font_atlas_t *ptFont = ssd1331_font(chSize);
+	const uint8_t *pchRow = ptFont->pchRows + (uint16_t)(chChr - ptFont->chFirst) * ptFont->chHeight * ptFont->chRowBytes;
+	uint16_t hwPixel = (uint16_t)((hwColor >> 8) | (hwColor << 8));
+	ssd1331_glyph_t *ptGlyph = &s_tGlyphCache[0];
+	uint8_t i, j;
+
+	for (i = 0; i < SSD1331_GLYPH_CACHE_SIZE; i ++) {
+		ssd1331_glyph_t *ptEntry = &s_tGlyphCache[i];
+		if (ptEntry->chSize == chSize && ptEntry->chChr == chChr && ptEntry->hwColor == hwColor) {
+			ptEntry->wLastUse = ++ s_wGlyphClock;
+			return ptEntry;
+		}
+		if (ptEntry->wLastUse < ptGlyph->wLastUse) {
+			ptGlyph = ptEntry;
+		}
+	}
+
+	// A queued burst may still be reading the entry about to be replaced
+	ssd1331_wait_idle();
+	ptGlyph->chChr = chChr;
+	ptGlyph->chSize = chSize;
+	ptGlyph->hwColor = hwColor;
+	ptGlyph->wLastUse = ++ s_wGlyphClock;
+	for (j = 0; j < ptFont->chHeight; j ++, pchRow += ptFont->chRowBytes) {
+		ssd1331_expand_row(&ptGlyph->hwPixel[j * ptFont->chWidth], pchRow, ptFont->chRowBytes, ptFont->chWidth, hwPixel);
+	}
+	return ptGlyph;
 }
 
 /**
@@ -264,36 +1068,127 @@ void ssd1331_draw_circle(uint8_t chXpos, uint8_t chYpos, uint8_t chRadius, uint1
 **/
 void ssd1331_display_char(uint8_t chXpos, uint8_t chYpos, uint8_t chChr, uint8_t chSize, uint16_t hwColor)
 {
-	uint8_t i, j, chTemp;
-	uint8_t chYpos0 = chYpos;
+	const ssd1331_glyph_t *ptGlyph;
+	uint8_t chWidth = chSize / 2;
 
-	chTemp = 0;
-	if (chXpos >= OLED_WIDTH || chYpos >= OLED_HEIGHT) {
+	if (chXpos >= OLED_WIDTH || chYpos >= OLED_HEIGHT || chChr < 0x20 || chChr > 0x7E) {
+		return;
+	}
+	if (FONT_1206 != chSize && FONT_1608 != chSize) {
 		return;
 	}
 
-    for (i = 0; i < chSize; i ++) {
-		if (FONT_1206 == chSize) {
-			chTemp = c_chFont1206[chChr - 0x20][i];
-		} else if (FONT_1608 == chSize) {
-			chTemp = c_chFont1608[chChr - 0x20][i];
+#ifdef SSD1331_USE_FRAMEBUFFER
+	ptGlyph = ssd1331_glyph_lookup(chChr, chSize, hwColor);
+
+	uint8_t chW = MIN(chWidth, OLED_WIDTH - chXpos), chH = MIN(chSize, OLED_HEIGHT - chYpos), j;
+
+	for (j = 0; j < chH; j ++) {
+		memcpy(&s_hwFrameBuffer[chYpos + j][chXpos], &ptGlyph->hwPixel[j * chWidth], chW * sizeof(uint16_t));
+	}
+	ssd1331_mark_dirty(chXpos, chYpos, chXpos + chW - 1, chYpos + chH - 1);
+#else
+	if (chXpos + chWidth > OLED_WIDTH || chYpos + chSize > OLED_HEIGHT) {
+		// Clipped glyphs do not fit a single burst of the cached rows
+		ssd1331_draw_glyph(chXpos, chYpos, ssd1331_font(chSize), chChr - 0x20, hwColor, 1);
+		return;
+	}
+	ptGlyph = ssd1331_glyph_lookup(chChr, chSize, hwColor);
+	ssd1331_begin();
+	ssd1331_set_window(chXpos, chYpos, chXpos + chWidth - 1, chYpos + chSize - 1);
+	ssd1331_write_data((const uint8_t *)ptGlyph->hwPixel, (uint16_t)chWidth * chSize * 2);
+	ssd1331_end();
+#endif
+}
+
+/* Columns a character takes in proportional text: its ink and one blank
+ * column, or half a cell for a blank glyph such as the space */
+static uint8_t ssd1331_advance(const font_atlas_t *ptFont, uint8_t chChr)
+{
+	uint8_t chInk = ptFont->pchInkWidth[chChr - ptFont->chFirst];
+
+	return chInk ? chInk + 1 : ptFont->chWidth / 2;
+}
+
+/**
+  * @brief  Returns how many columns ssd1331_display_text() takes for a string
+  *         (255 at most), characters outside ' '-'~' not counted
+**/
+uint8_t ssd1331_text_width(const char *pchString, uint8_t chSize)
+{
+	const font_atlas_t *ptFont = ssd1331_font(chSize);
+	uint16_t hwWidth = 0;
+
+	for (; *pchString != '\0'; pchString ++) {
+		if (*pchString >= 0x20 && *pchString <= 0x7E) {
+			hwWidth += ssd1331_advance(ptFont, *pchString);
 		}
+	}
+	return (hwWidth > 0xFF) ? 0xFF : (uint8_t)hwWidth;
+}
 
-        for (j = 0; j < 8; j ++) {
-    		if (chTemp & 0x80) {
-		  ssd1331_draw_point(chXpos, chYpos, hwColor);
-    		} else {
-		  ssd1331_draw_point(chXpos, chYpos, 0);
+/**
+  * @brief  Displays a string with proportional spacing: each character takes
+  *         its ink width plus one blank column, so more text fits a line than
+  *         with ssd1331_display_string(). Every column it covers is painted,
+  *         blank ones black. Doesn't wrap; text past the right edge is cut.
+  *
+  * @param  chXpos: Specifies the X position
+  * @param  chYpos: Specifies the Y position
+  * @param  pchString: Pointer to a string to display on the screen
+  * @param  chSize: FONT_1206 or FONT_1608
+  * @retval The column after the text
+**/
+uint8_t ssd1331_display_text(uint8_t chXpos, uint8_t chYpos, const char *pchString, uint8_t chSize, uint16_t hwColor)
+{
+	const font_atlas_t *ptFont = ssd1331_font(chSize);
+	const ssd1331_glyph_t *ptGlyph;
+	uint8_t chStart = chXpos, chInk, chLeft, chW, chH, i, j;
+	uint16_t *phwDst;
+
+	if (chYpos >= OLED_HEIGHT || (FONT_1206 != chSize && FONT_1608 != chSize)) {
+		return chXpos;
+	}
+	chH = MIN(chSize, OLED_HEIGHT - chYpos);
+
+	PROF_BEGIN(PROF_OLED_STRING);
+	for (; *pchString != '\0' && chXpos < OLED_WIDTH; pchString ++) {
+		if (*pchString < 0x20 || *pchString > 0x7E) {
+			continue;
 		}
-			chTemp <<= 1;
-			chYpos ++;
-			if ((chYpos - chYpos0) == chSize) {
-				chYpos = chYpos0;
-				chXpos ++;
-				break;
+		chInk = ptFont->pchInkWidth[*pchString - ptFont->chFirst];
+		chLeft = ptFont->pchInkLeft[*pchString - ptFont->chFirst];
+		chW = MIN(ssd1331_advance(ptFont, *pchString), OLED_WIDTH - chXpos);
+		ptGlyph = ssd1331_glyph_lookup(*pchString, chSize, hwColor);
+
+#ifndef SSD1331_USE_FRAMEBUFFER
+		ssd1331_wait_idle(); // the previous character may still be queued from s_hwGlyph
+#endif
+		for (j = 0; j < chH; j ++) {
+#ifdef SSD1331_USE_FRAMEBUFFER
+			phwDst = &s_hwFrameBuffer[chYpos + j][chXpos];
+#else
+			phwDst = &s_hwGlyph[j * chW];
+#endif
+			i = MIN(chInk, chW);
+			memcpy(phwDst, &ptGlyph->hwPixel[j * ptFont->chWidth + chLeft], i * sizeof(uint16_t));
+			for (; i < chW; i ++) {
+				phwDst[i] = 0;
 			}
 		}
-    }
+#ifndef SSD1331_USE_FRAMEBUFFER
+		ssd1331_begin();
+		ssd1331_set_window(chXpos, chYpos, chXpos + chW - 1, chYpos + chH - 1);
+		ssd1331_write_data((const uint8_t *)s_hwGlyph, (uint16_t)chW * chH * 2);
+		ssd1331_end();
+#endif
+		chXpos += chW;
+	}
+	if (chXpos > chStart) {
+		ssd1331_mark_dirty(chStart, chYpos, chXpos - 1, chYpos + chH - 1);
+	}
+	PROF_END(PROF_OLED_STRING);
+	return chXpos;
 }
 
 static uint32_t _pow(uint8_t m, uint8_t n)
@@ -344,6 +1239,7 @@ void ssd1331_display_string(uint8_t chXpos, uint8_t chYpos, const char *pchStrin
 		return;
 	}
 
+	PROF_BEGIN(PROF_OLED_STRING);
     while (*pchString != '\0') {
         if (chXpos > (OLED_WIDTH - chSize / 2)) {
 			chXpos = 0;
@@ -358,60 +1254,34 @@ void ssd1331_display_string(uint8_t chXpos, uint8_t chYpos, const char *pchStrin
         chXpos += chSize / 2;
         pchString ++;
     }
+	PROF_END(PROF_OLED_STRING);
 }
 
 void ssd1331_draw_1616char(uint8_t chXpos, uint8_t chYpos, uint8_t chChar, uint16_t hwColor)
 {
-	uint8_t i, j;
-	uint8_t chTemp = 0, chYpos0 = chYpos;
-
-	for (i = 0; i < 32; i ++) {
-		chTemp = c_chFont1612[chChar - 0x30][i];
-		for (j = 0; j < 8; j ++) {
-			if (chTemp & 0x80) {
-				ssd1331_draw_point(chXpos, chYpos, hwColor);
-    		}
-			chTemp <<= 1;
-			chYpos ++;
-			if ((chYpos - chYpos0) == 16) {
-				chYpos = chYpos0;
-				chXpos ++;
-				break;
-			}
-		}
+	if (chChar < '0' || chChar > ':') {
+		return;
 	}
+	ssd1331_draw_glyph(chXpos, chYpos, &c_tFontAtlas1612, chChar - '0', hwColor, 0);
 }
 
 void ssd1331_draw_3216char(uint8_t chXpos, uint8_t chYpos, uint8_t chChar, uint16_t hwColor)
 {
-	uint8_t i, j;
-	uint8_t chTemp = 0, chYpos0 = chYpos;
-
-	for (i = 0; i < 64; i ++) {
-		chTemp = c_chFont3216[chChar - 0x30][i];
-		for (j = 0; j < 8; j ++) {
-			if (chTemp & 0x80) {
-				ssd1331_draw_point(chXpos, chYpos, hwColor);
-    		}
-			chTemp <<= 1;
-			chYpos ++;
-			if ((chYpos - chYpos0) == 32) {
-				chYpos = chYpos0;
-				chXpos ++;
-				break;
-			}
-		}
+	if (chChar < '0' || chChar > ':') {
+		return;
 	}
+	ssd1331_draw_glyph(chXpos, chYpos, &c_tFontAtlas3216, chChar - '0', hwColor, 0);
 }
 
 void ssd1331_draw_bitmap(uint8_t chXpos, uint8_t chYpos, const uint8_t *pchBmp, uint8_t chWidth, uint8_t chHeight, uint16_t hwColor)
 {
 	uint16_t i, j, byteWidth = (chWidth + 7) / 8;
 
+	ssd1331_mark_dirty(chXpos, chYpos, chXpos + chWidth - 1, chYpos + chHeight - 1);
     for(j = 0; j < chHeight; j ++){
         for(i = 0; i < chWidth; i ++ ) {
             if(*(pchBmp + j * byteWidth + i / 8) & (128 >> (i & 7))) {
-                ssd1331_draw_point(chXpos + i, chYpos + j, hwColor);
+                ssd1331_plot(chXpos + i, chYpos + j, hwColor);
             }
         }
     }
@@ -419,62 +1289,264 @@ void ssd1331_draw_bitmap(uint8_t chXpos, uint8_t chYpos, const uint8_t *pchBmp,
 
 void ssd1331_clear_screen(uint16_t hwColor)
 {
-	uint16_t i, j;
+	ssd1331_solid(0, 0, OLED_WIDTH - 1, OLED_HEIGHT - 1, hwColor);
+}
+
+/**
+  * @brief  Copies a window of the panel to another position. Parts of the
+  *         destination that would fall off the panel are dropped. With the
+  *         RAM copy and acceleration both on, pending drawing is flushed
+  *         first, since the controller copies what the panel shows.
+  *
+  * @param  chXpos0, chYpos0: top-left corner of the source window
+  * @param  chXpos1, chYpos1: bottom-right corner of the source window, inclusive
+  * @param  chXdest, chYdest: new position of the top-left corner
+  * @retval None
+**/
+void ssd1331_copy_window(uint8_t chXpos0, uint8_t chYpos0, uint8_t chXpos1, uint8_t chYpos1, uint8_t chXdest, uint8_t chYdest)
+{
+	if (chXpos1 >= OLED_WIDTH) chXpos1 = OLED_WIDTH - 1;
+	if (chYpos1 >= OLED_HEIGHT) chYpos1 = OLED_HEIGHT - 1;
+	if (chXpos0 > chXpos1 || chYpos0 > chYpos1 || chXdest >= OLED_WIDTH || chYdest >= OLED_HEIGHT) {
+		return;
+	}
+	// Clip the source so the destination stays on the panel
+	if (chXdest + (chXpos1 - chXpos0) >= OLED_WIDTH) chXpos1 = chXpos0 + (OLED_WIDTH - 1 - chXdest);
+	if (chYdest + (chYpos1 - chYpos0) >= OLED_HEIGHT) chYpos1 = chYpos0 + (OLED_HEIGHT - 1 - chYdest);
+
+#ifdef SSD1331_USE_FRAMEBUFFER
+	uint8_t chRows = chYpos1 - chYpos0 + 1, i;
+	size_t tRowBytes = (size_t)(chXpos1 - chXpos0 + 1) * sizeof(uint16_t);
+
+#ifdef SSD1331_USE_HW_ACCEL
+	// Sent in place, so it has to be out before the memmove changes the rows
+	ssd1331_flush();
+	ssd1331_wait_idle();
+#endif
+	// Walk rows in the direction that never overwrites unread source rows
+	for (i = 0; i < chRows; i ++) {
+		uint8_t chRow = (chYdest > chYpos0) ? (chRows - 1 - i) : i;
+		memmove(&s_hwFrameBuffer[chYdest + chRow][chXdest], &s_hwFrameBuffer[chYpos0 + chRow][chXpos0], tRowBytes);
+	}
+#endif
+
+#ifdef SSD1331_USE_HW_ACCEL
+	uint8_t chCmd[7] = { COPY_WINDOW, chXpos0, chYpos0, chXpos1, chYpos1, chXdest, chYdest };
+	ssd1331_accel_cmd(chCmd, sizeof(chCmd), SSD1331_FILL_WAIT_US((uint32_t)(chXpos1 - chXpos0 + 1) * (chYpos1 - chYpos0 + 1)));
+#elif defined(SSD1331_USE_FRAMEBUFFER)
+	ssd1331_mark_dirty(chXdest, chYdest, chXdest + (chXpos1 - chXpos0), chYdest + (chYpos1 - chYpos0));
+#else
+	// Without acceleration or a RAM copy the panel cannot be read back
+	(void)chXdest; (void)chYdest;
+#endif
+}
+
+/**
+  * @brief  Lets the controller scroll a band of full-width rows to the left
+  *         on its own, chColumns per step, until ssd1331_stop_scroll(). The
+  *         panel RAM must not be written meanwhile, so the next flush or
+  *         graphic command stops the scroll first.
+  *
+  * @param  chColumns: columns per step, 1 to OLED_WIDTH - 1
+  * @param  chRow, chRows: first row of the band and its height
+  * @param  chInterval: time between steps, 0 to 3 for 6, 10, 100 or 200 frames
+  * @retval None
+**/
+void ssd1331_start_scroll(uint8_t chColumns, uint8_t chRow, uint8_t chRows, uint8_t chInterval)
+{
+	if (chColumns == 0 || chColumns >= OLED_WIDTH || chRow >= OLED_HEIGHT || chRows == 0) {
+		return;
+	}
+	if (chRows > OLED_HEIGHT - chRow) {
+		chRows = OLED_HEIGHT - chRow;
+	}
+
+	uint8_t chCmd[7] = { CONTINUOUS_SCROLLING_SETUP, chColumns, chRow, chRows, 0, chInterval & 0x03, ACTIVE_SCROLLING };
+
+	ssd1331_stop_scroll();
+	ssd1331_flush(); // the band scrolls what the panel shows, so bring it up to date
+	ssd1331_accel_wait();
+	ssd1331_begin();
+	ssd1331_write_cmd(chCmd, sizeof(chCmd));
+	ssd1331_end();
+	s_tScroll.chRow = chRow;
+	s_tScroll.chRows = chRows;
+}
+
+/**
+  * @brief  Stops a scroll started by ssd1331_start_scroll(). The controller
+  *         leaves the band's RAM in a shifted state, so in the framebuffer
+  *         build the band is marked dirty and the next flush restores it.
+  *         Does nothing if no scroll is running.
+  *
+  * @retval None
+**/
+void ssd1331_stop_scroll(void)
+{
+	static const uint8_t c_chStop = DEACTIVE_SCROLLING;
 
-	for(i = 0; i < OLED_HEIGHT; i ++){
-		for(j = 0; j < OLED_WIDTH; j ++){
-			ssd1331_draw_point(j, i, hwColor);
+	if (s_tScroll.chRows == 0) {
+		return;
+	}
+	ssd1331_begin();
+	ssd1331_write_cmd(&c_chStop, 1);
+	ssd1331_end();
+	ssd1331_mark_dirty(0, s_tScroll.chRow, OLED_WIDTH - 1, s_tScroll.chRow + s_tScroll.chRows - 1);
+	s_tScroll.chRows = 0;
+}
+
+/**
+  * @brief  Pushes every dirty region of the framebuffer to the panel. Each
+  *         region costs one column/row window setup followed by one burst of
+  *         pixel data with CS held low. With DMA enabled the bursts are only
+  *         queued and this returns immediately, unless regions narrower than
+  *         the panel have to wait for the previous flush to leave the staging
+  *         area. Does nothing in the direct build.
+  *
+  * @retval None
+**/
+void ssd1331_flush(void)
+{
+#ifdef SSD1331_USE_FRAMEBUFFER
+	uint8_t i;
+	int16_t iRow;
+#ifdef SSD1331_USE_DMA
+	uint16_t *phwStage = s_hwFlushStage;
+#endif
+
+	ssd1331_stop_scroll(); // RAM can't be written while the panel scrolls
+#ifdef SSD1331_USE_DMA
+	for (i = 0; i < s_chDirtyCount; i ++) {
+		if (s_tDirtyRect[i].iX1 - s_tDirtyRect[i].iX0 + 1 < OLED_WIDTH) {
+			ssd1331_wait_idle(); // the last flush may still be sending from the staging area
+			break;
 		}
 	}
+#endif
+
+	for (i = 0; i < s_chDirtyCount; i ++) {
+		const ssd1331_rect_t *ptRect = &s_tDirtyRect[i];
+		uint16_t hwRowBytes = (uint16_t)(ptRect->iX1 - ptRect->iX0 + 1) * 2;
+
+
+		ssd1331_begin();
+		ssd1331_set_window(ptRect->iX0, ptRect->iY0, ptRect->iX1, ptRect->iY1);
+		if (hwRowBytes == OLED_WIDTH * 2) {
+			// Full-width rows are contiguous in the framebuffer
+			ssd1331_write_data((const uint8_t *)&s_hwFrameBuffer[ptRect->iY0][0],
+					hwRowBytes * (ptRect->iY1 - ptRect->iY0 + 1));
+		} else {
+#ifdef SSD1331_USE_DMA
+			// One queue entry per row would fill the queue with any region
+			// taller than it and stall here, so the rows are packed first
+			const uint16_t *phwData = phwStage;
+
+			for (iRow = ptRect->iY0; iRow <= ptRect->iY1; iRow ++) {
+				memcpy(phwStage, &s_hwFrameBuffer[iRow][ptRect->iX0], hwRowBytes);
+				phwStage += hwRowBytes / 2;
+			}
+			ssd1331_write_data((const uint8_t *)phwData, (uint16_t)((phwStage - phwData) * 2));
+#else
+			for (iRow = ptRect->iY0; iRow <= ptRect->iY1; iRow ++) {
+				ssd1331_write_data((const uint8_t *)&s_hwFrameBuffer[iRow][ptRect->iX0], hwRowBytes);
+			}
+#endif
+		}
+		ssd1331_end();
+	}
+	s_chDirtyCount = 0;
+#endif
+}
+
+
+/**
+  * @brief  Reports the SPI traffic sent to the panel since the last
+  *         ssd1331_reset_spi_counts(). A queued DMA transfer counts as soon
+  *         as it is queued.
+  *
+  * @param  pwBytes: bytes, command and data alike
+  * @param  pwTransfers: HAL_SPI_Transmit / HAL_SPI_Transmit_DMA calls
+  * @retval None
+**/
+void ssd1331_get_spi_counts(uint32_t *pwBytes, uint32_t *pwTransfers)
+{
+	*pwBytes = s_wSpiBytes;
+	*pwTransfers = s_wSpiTransfers;
+}
+
+void ssd1331_reset_spi_counts(void)
+{
+	s_wSpiBytes = 0;
+	s_wSpiTransfers = 0;
 }
 
 
+/**
+  * @brief  Measures how fast full-screen pixel data reaches the panel, either
+  *         through the original one-byte-per-call writer or through a single
+  *         transaction. Leaves the panel black; in the framebuffer build the
+  *         next ssd1331_flush() repaints it.
+  *
+  * @param  chLegacy: 1 to time ssd1331_write_byte(), 0 to time the transaction API
+  * @retval Bytes per second, command bytes included
+**/
+uint32_t ssd1331_benchmark(uint8_t chLegacy)
+{
+	static const uint8_t c_chBlackRow[OLED_WIDTH * 2] = { 0 };
+	uint32_t wStart, wElapsed, wBytes = 0;
+	uint16_t i;
+	uint8_t chRow;
+
+	ssd1331_wait_idle();
+	wStart = HAL_GetTick();
+	do {
+		if (chLegacy) {
+			ssd1331_write_byte(SET_COLUMN_ADDRESS, SSD1331_CMD);
+			ssd1331_write_byte(0, SSD1331_CMD);
+			ssd1331_write_byte(OLED_WIDTH - 1, SSD1331_CMD);
+			ssd1331_write_byte(SET_ROW_ADDRESS, SSD1331_CMD);
+			ssd1331_write_byte(0, SSD1331_CMD);
+			ssd1331_write_byte(OLED_HEIGHT - 1, SSD1331_CMD);
+			for (i = 0; i < OLED_WIDTH * OLED_HEIGHT * 2; i ++) {
+				ssd1331_write_byte(0, SSD1331_DATA);
+			}
+		} else {
+			ssd1331_begin();
+			ssd1331_set_window(0, 0, OLED_WIDTH - 1, OLED_HEIGHT - 1);
+			for (chRow = 0; chRow < OLED_HEIGHT; chRow ++) {
+				ssd1331_write_data(c_chBlackRow, sizeof(c_chBlackRow));
+			}
+			ssd1331_end();
+			ssd1331_wait_idle();
+		}
+		wBytes += 6 + OLED_WIDTH * OLED_HEIGHT * 2;
+		wElapsed = HAL_GetTick() - wStart;
+	} while (wElapsed < 250); // long enough for the 1 ms tick to be accurate
+
+#ifdef SSD1331_USE_FRAMEBUFFER
+	ssd1331_mark_dirty(0, 0, OLED_WIDTH - 1, OLED_HEIGHT - 1);
+#endif
+	return (uint32_t)((uint64_t)wBytes * 1000 / wElapsed);
+}
+
 void ssd1331_init(void)
 {
   __SSD1331_RES_SET();  //RES set
   __SSD1331_CS_SET();
 
-  ssd1331_write_byte(DISPLAY_OFF, SSD1331_CMD);          //Display Off
-  ssd1331_write_byte(SET_CONTRAST_A, SSD1331_CMD);       //Set contrast for color A
-  ssd1331_write_byte(0xFF, SSD1331_CMD);                     //145 0x91
-  ssd1331_write_byte(SET_CONTRAST_B, SSD1331_CMD);       //Set contrast for color B
-  ssd1331_write_byte(0xFF, SSD1331_CMD);                     //80 0x50
-  ssd1331_write_byte(SET_CONTRAST_C, SSD1331_CMD);       //Set contrast for color C
-  ssd1331_write_byte(0xFF, SSD1331_CMD);                     //125 0x7D
-  ssd1331_write_byte(MASTER_CURRENT_CONTROL, SSD1331_CMD);//master current control
-  ssd1331_write_byte(0x06, SSD1331_CMD);                     //6
-  ssd1331_write_byte(SET_PRECHARGE_SPEED_A, SSD1331_CMD);//Set Second Pre-change Speed For ColorA
-  ssd1331_write_byte(0x64, SSD1331_CMD);                     //100
-  ssd1331_write_byte(SET_PRECHARGE_SPEED_B, SSD1331_CMD);//Set Second Pre-change Speed For ColorB
-  ssd1331_write_byte(0x78, SSD1331_CMD);                     //120
-  ssd1331_write_byte(SET_PRECHARGE_SPEED_C, SSD1331_CMD);//Set Second Pre-change Speed For ColorC
-  ssd1331_write_byte(0x64, SSD1331_CMD);                     //100
-  ssd1331_write_byte(SET_REMAP, SSD1331_CMD);            //set remap & data format
-  ssd1331_write_byte(0x76, SSD1331_CMD);                     //0x72
-  ssd1331_write_byte(SET_DISPLAY_START_LINE, SSD1331_CMD);//Set display Start Line
-  ssd1331_write_byte(0x0, SSD1331_CMD);
-  ssd1331_write_byte(SET_DISPLAY_OFFSET, SSD1331_CMD);   //Set display offset
-  ssd1331_write_byte(0x0, SSD1331_CMD);
-  ssd1331_write_byte(NORMAL_DISPLAY, SSD1331_CMD);       //Set display mode
-  ssd1331_write_byte(SET_MULTIPLEX_RATIO, SSD1331_CMD);  //Set multiplex ratio
-  ssd1331_write_byte(0x3F, SSD1331_CMD);
-  ssd1331_write_byte(SET_MASTER_CONFIGURE, SSD1331_CMD); //Set master configuration
-  ssd1331_write_byte(0x8E, SSD1331_CMD);
-  ssd1331_write_byte(POWER_SAVE_MODE, SSD1331_CMD);      //Set Power Save Mode
-  ssd1331_write_byte(0x00, SSD1331_CMD);                     //0x00
-  ssd1331_write_byte(PHASE_PERIOD_ADJUSTMENT, SSD1331_CMD);//phase 1 and 2 period adjustment
-  ssd1331_write_byte(0x31, SSD1331_CMD);                     //0x31
-  ssd1331_write_byte(DISPLAY_CLOCK_DIV, SSD1331_CMD);    //display clock divider/oscillator frequency
-  ssd1331_write_byte(0xF0, SSD1331_CMD);
-  ssd1331_write_byte(SET_PRECHARGE_VOLTAGE, SSD1331_CMD);//Set Pre-Change Level
-  ssd1331_write_byte(0x3A, SSD1331_CMD);
-  ssd1331_write_byte(SET_V_VOLTAGE, SSD1331_CMD);        //Set vcomH
-  ssd1331_write_byte(0x3E, SSD1331_CMD);
-  ssd1331_write_byte(DEACTIVE_SCROLLING, SSD1331_CMD);   //disable scrolling
-  ssd1331_write_byte(NORMAL_BRIGHTNESS_DISPLAY_ON, SSD1331_CMD);//set display on
+  ssd1331_begin();
+  ssd1331_write_cmd(c_chInitSequence, sizeof(c_chInitSequence));
+  ssd1331_end();
+
+#ifdef SSD1331_USE_HW_ACCEL
+  // The graphic commands are timed with the DWT cycle counter
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
 
   //ssd1331_fill_rect(0, 0, 96, 64, 0x0000);
   ssd1331_clear_screen(0x0000);
+  ssd1331_flush();
 }
 
 
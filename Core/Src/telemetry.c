@@ -0,0 +1,265 @@
+/**
+  ******************************************************************************
+  * @file           : telemetry.c
+
+  * @brief          : binary sample frames on USART2 (COBS framed, CRC-16)
+  * @date           : 17-10-2026
+  *
+  * A frame is laid out little-endian as
+  *   type (1) | seq (2) | tick (4) | payload | CRC-16 (2)
+  * with the payload depending on the type:
+  *   TELEMETRY_FRAME_SENSORS : humidity (1) | temperature (1, signed) |
+  *                             light (2) | risk (1, signed)
+  *   TELEMETRY_FRAME_ADC     : rate Hz (2) | scans (1) | channels (1) |
+  *                             scans x channels samples (2 each, rank order)
+  *   TELEMETRY_FRAME_LOG     : format id (2) | level (1) | module (1) |
+  *                             arguments (4 each)
+  * seq counts frames of each type separately, so the host can tell how many
+  * were lost. The tick of an ADC frame is when its last scan finished. The
+  * CRC is CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF) over everything
+  * before it. The frame is then COBS encoded, which removes every zero byte,
+  * and followed by a single 0x00, so a receiver that starts mid-stream (or
+  * sees printf text) resynchronises at the next zero.
+  *
+  * The ADC half-buffer callback copies raw scans into a small queue and
+  * posts EVENT_TELEMETRY; telemetry_task() frames and sends them. A frame is
+  * only handed to uartTx if it fits whole, otherwise it's counted as skipped.
+  * At 115200 baud an ADC frame (~110 bytes per ADC_SCAN_DEPTH scans) keeps
+  * up with scan rates up to ~1.5 kHz.
+
+  ******************************************************************************
+  */
+
+#include <string.h>
+
+#include "telemetry.h"
+#include "uartTx.h"
+#include "scheduler.h"
+#include "main.h"
+
+#define TELEMETRY_HEADER      7
+#define TELEMETRY_ADC_SAMPLES (ADC_SCAN_DEPTH * ADC_SCAN_CHANNELS)
+#define TELEMETRY_MAX_FRAME   (TELEMETRY_HEADER + 4 + TELEMETRY_ADC_SAMPLES * 2 + 2)
+#define TELEMETRY_MAX_COBS    (TELEMETRY_MAX_FRAME + TELEMETRY_MAX_FRAME / 254 + 2)
+
+static telemetry_mode_t telemetryMode = TELEMETRY_OFF;
+static telemetry_stats_t telemetryStats;
+static uint16_t telemetrySensorSeq = 0;
+static uint16_t telemetryLogSeq = 0;
+
+// Raw ADC blocks, filled by the DMA callback and emptied by telemetry_task
+static uint16_t telemetryAdcBlock[TELEMETRY_ADC_QUEUE][TELEMETRY_ADC_SAMPLES];
+static uint32_t telemetryAdcTick[TELEMETRY_ADC_QUEUE];
+static uint16_t telemetryAdcSeq[TELEMETRY_ADC_QUEUE];
+static volatile uint8_t telemetryAdcHead = 0;  // next slot to fill
+static volatile uint8_t telemetryAdcTail = 0;  // oldest filled slot
+static uint16_t telemetryAdcNextSeq = 0;
+static volatile uint32_t telemetryAdcLost = 0; // blocks that found the queue full
+
+
+static uint16_t telemetry_crc16(const uint8_t *data, uint16_t len)
+{
+	uint16_t crc = 0xFFFF;
+	uint8_t bit;
+
+	while (len--) {
+		crc ^= (uint16_t)*data++ << 8;
+		for (bit = 0; bit < 8; bit++) {
+			crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+		}
+	}
+	return crc;
+}
+
+
+// COBS: every zero is replaced by the distance to the next one, in blocks of
+// at most 254 bytes. Returns the encoded length (without the delimiter).
+static uint16_t telemetry_cobs(const uint8_t *in, uint16_t len, uint8_t *out)
+{
+	uint16_t code = 0, pos = 1, i;
+
+	for (i = 0; i < len; i++) {
+		if (in[i] != 0) {
+			out[pos++] = in[i];
+		}
+		if (in[i] == 0 || pos - code == 0xFF) {
+			out[code] = (uint8_t)(pos - code);
+			code = pos++;
+		}
+	}
+	out[code] = (uint8_t)(pos - code);
+	return pos;
+}
+
+
+static void telemetry_put16(uint8_t *out, uint16_t value)
+{
+	out[0] = (uint8_t)value;
+	out[1] = (uint8_t)(value >> 8);
+}
+
+
+static void telemetry_put32(uint8_t *out, uint32_t value)
+{
+	telemetry_put16(out, (uint16_t)value);
+	telemetry_put16(out + 2, (uint16_t)(value >> 16));
+}
+
+
+// FUNCTION      : telemetry_send
+// DESCRIPTION   :
+//   Add the CRC to a frame (header + payload), COBS encode it and queue it
+//   on the UART, or count it as skipped if the whole frame doesn't fit.
+// PARAMETERS    :
+//   uint8_t *frame : header and payload, with 2 spare bytes at the end
+//   uint16_t len   : bytes of header and payload
+// RETURNS       :
+//   nothing
+static void telemetry_send(uint8_t *frame, uint16_t len)
+{
+	uint8_t encoded[TELEMETRY_MAX_COBS];
+	uint16_t n;
+
+	telemetry_put16(frame + len, telemetry_crc16(frame, len));
+	n = telemetry_cobs(frame, len + 2, encoded);
+	encoded[n++] = 0;
+
+	if (uart_tx_space() < n) {
+		telemetryStats.skipped++;
+		return;
+	}
+	uart_tx_write((const char *)encoded, n);
+	telemetryStats.frames++;
+}
+
+
+static void telemetry_header(uint8_t *frame, uint8_t type, uint16_t seq, uint32_t tick)
+{
+	frame[0] = type;
+	telemetry_put16(frame + 1, seq);
+	telemetry_put32(frame + 3, tick);
+}
+
+
+void telemetry_set_mode(telemetry_mode_t mode)
+{
+	telemetryAdcTail = telemetryAdcHead;   // drop blocks from an earlier session
+	telemetryMode = mode;
+}
+
+
+telemetry_mode_t telemetry_get_mode(void)
+{
+	return telemetryMode;
+}
+
+
+void telemetry_stats(telemetry_stats_t *stats)
+{
+	*stats = telemetryStats;
+	stats->skipped += telemetryAdcLost;
+}
+
+
+// FUNCTION      : telemetry_send_sensors
+// DESCRIPTION   :
+//   Send a TELEMETRY_FRAME_SENSORS frame, unless telemetry is off.
+// PARAMETERS    :
+//   const telemetry_sensors_t *sensors : the reading
+// RETURNS       :
+//   nothing
+void telemetry_send_sensors(const telemetry_sensors_t *sensors)
+{
+	uint8_t frame[TELEMETRY_HEADER + 5 + 2];
+
+	if (telemetryMode == TELEMETRY_OFF) return;
+
+	telemetry_header(frame, TELEMETRY_FRAME_SENSORS, telemetrySensorSeq++, sensors->tick);
+	frame[TELEMETRY_HEADER] = sensors->humidity;
+	frame[TELEMETRY_HEADER + 1] = (uint8_t)sensors->temperature;
+	telemetry_put16(frame + TELEMETRY_HEADER + 2, sensors->light);
+	frame[TELEMETRY_HEADER + 4] = (uint8_t)sensors->risk;
+	telemetry_send(frame, TELEMETRY_HEADER + 5);
+}
+
+
+// FUNCTION      : telemetry_send_log
+// DESCRIPTION   :
+//   Send a log entry as a TELEMETRY_FRAME_LOG frame (called by log_task,
+//   whatever the telemetry mode).
+// PARAMETERS    :
+//   uint32_t tick        : when the entry was logged
+//   uint16_t id          : offset of its format string in .log_fmt
+//   uint8_t level        : LOG_LEVEL_*
+//   uint8_t module       : LOG_MODULE_*
+//   const uint32_t *args : arguments
+//   uint8_t count        : number of arguments
+// RETURNS       :
+//   nothing
+void telemetry_send_log(uint32_t tick, uint16_t id, uint8_t level, uint8_t module, const uint32_t *args, uint8_t count)
+{
+	uint8_t frame[TELEMETRY_MAX_FRAME];
+	uint8_t i;
+
+	if (TELEMETRY_HEADER + 4 + 4 * count + 2 > TELEMETRY_MAX_FRAME) return;
+
+	telemetry_header(frame, TELEMETRY_FRAME_LOG, telemetryLogSeq++, tick);
+	telemetry_put16(frame + TELEMETRY_HEADER, id);
+	frame[TELEMETRY_HEADER + 2] = level;
+	frame[TELEMETRY_HEADER + 3] = module;
+	for (i = 0; i < count; i++) {
+		telemetry_put32(frame + TELEMETRY_HEADER + 4 + 4 * i, args[i]);
+	}
+	telemetry_send(frame, TELEMETRY_HEADER + 4 + 4 * count);
+}
+
+
+// FUNCTION      : telemetry_task
+// DESCRIPTION   :
+//   Scheduler task for EVENT_TELEMETRY: sends every queued raw ADC block as
+//   a TELEMETRY_FRAME_ADC frame.
+// PARAMETERS    :
+//   none
+// RETURNS       :
+//   nothing
+void telemetry_task(void)
+{
+	static uint8_t frame[TELEMETRY_MAX_FRAME];
+	uint8_t slot;
+	uint16_t i;
+
+	while (telemetryAdcTail != telemetryAdcHead) {
+		slot = telemetryAdcTail;
+		telemetry_header(frame, TELEMETRY_FRAME_ADC, telemetryAdcSeq[slot], telemetryAdcTick[slot]);
+		telemetry_put16(frame + TELEMETRY_HEADER, (uint16_t)adc_scan_get_rate());
+		frame[TELEMETRY_HEADER + 2] = ADC_SCAN_DEPTH;
+		frame[TELEMETRY_HEADER + 3] = ADC_SCAN_CHANNELS;
+		for (i = 0; i < TELEMETRY_ADC_SAMPLES; i++) {
+			telemetry_put16(frame + TELEMETRY_HEADER + 4 + 2 * i, telemetryAdcBlock[slot][i]);
+		}
+		telemetryAdcTail = (slot + 1) % TELEMETRY_ADC_QUEUE;
+		telemetry_send(frame, TELEMETRY_HEADER + 4 + TELEMETRY_ADC_SAMPLES * 2);
+	}
+}
+
+
+// Raw scans from the ADC DMA interrupt (see adcScan.c). A block that finds
+// the queue full is lost, but still uses up a sequence number.
+void adc_scan_block_ready(const uint16_t *samples, uint16_t scans)
+{
+	uint8_t next;
+
+	if (telemetryMode != TELEMETRY_RAW || scans * ADC_SCAN_CHANNELS != TELEMETRY_ADC_SAMPLES) return;
+
+	next = (telemetryAdcHead + 1) % TELEMETRY_ADC_QUEUE;
+	if (next == telemetryAdcTail) {
+		telemetryAdcNextSeq++;
+		telemetryAdcLost++;
+		return;
+	}
+	memcpy(telemetryAdcBlock[telemetryAdcHead], samples, sizeof(telemetryAdcBlock[0]));
+	telemetryAdcTick[telemetryAdcHead] = HAL_GetTick();
+	telemetryAdcSeq[telemetryAdcHead] = telemetryAdcNextSeq++;
+	telemetryAdcHead = next;
+	sched_post(EVENT_TELEMETRY);
+}
@@ -0,0 +1,109 @@
+/**
+  ******************************************************************************
+  * @file           : uartRx.c
+
+  * @brief          : interrupt-driven USART2 (VCP) receive ring buffer
+  * @date           : 17-10-2026
+  *
+  * The RXNE interrupt moves every received byte into a ring buffer, so
+  * nothing typed is lost while the main loop is busy elsewhere. The ISR is
+  * the only writer of the head index and the reader is the only writer of
+  * the tail index, so no locking is needed between them.
+
+  ******************************************************************************
+  */
+
+#include "uartRx.h"
+
+extern UART_HandleTypeDef huart2; // VCP
+
+static uint8_t uartRxBuffer[UART_RX_BUFFER_SIZE];
+static volatile uint16_t uartRxHead = 0;  // next free slot, advanced by the ISR
+static volatile uint16_t uartRxTail = 0;  // next byte to read, advanced by uart_read
+static volatile uint32_t uartRxDropped = 0;
+
+
+// FUNCTION      : uart_rx_init
+// DESCRIPTION   :
+//   Empty the buffer and start taking USART2 receive interrupts
+// PARAMETERS    :
+//   none
+// RETURNS       :
+//   nothing
+void uart_rx_init(void)
+{
+  uartRxHead = uartRxTail = 0;
+  __HAL_UART_CLEAR_OREFLAG(&huart2);
+  __HAL_UART_ENABLE_IT(&huart2, UART_IT_RXNE);
+}
+
+
+// FUNCTION      : uart_rx_irq_handler
+// DESCRIPTION   :
+//   Move a received byte into the buffer. Reading SR then DR also clears
+//   an overrun, so HAL_UART_IRQHandler never sees it as an error.
+// PARAMETERS    :
+//   none
+// RETURNS       :
+//   nothing
+void uart_rx_irq_handler(void)
+{
+  uint32_t status = huart2.Instance->SR;
+
+  if (status & (USART_SR_RXNE | USART_SR_ORE)) {
+    uint8_t data = (uint8_t)huart2.Instance->DR;
+    uint16_t next = (uartRxHead + 1) & (UART_RX_BUFFER_SIZE - 1);
+
+    if (status & USART_SR_ORE) {
+      uartRxDropped++; // at least one byte arrived before the last was read
+    }
+    if (next == uartRxTail) {
+      uartRxDropped++; // buffer full, keep the older bytes
+      return;
+    }
+    uartRxBuffer[uartRxHead] = data;
+    __DMB(); // byte must be visible before the new head
+    uartRxHead = next;
+  }
+}
+
+
+// FUNCTION      : uart_available
+// DESCRIPTION   :
+//   Number of received bytes waiting to be read
+// PARAMETERS    :
+//   none
+// RETURNS       :
+//   uint16_t : byte count
+uint16_t uart_available(void)
+{
+  return (uartRxHead - uartRxTail) & (UART_RX_BUFFER_SIZE - 1);
+}
+
+
+// FUNCTION      : uart_read
+// DESCRIPTION   :
+//   Take the next received byte without waiting
+// PARAMETERS    :
+//   none
+// RETURNS       :
+//   int : the byte (0-255), or -1 if nothing has been received
+int uart_read(void)
+{
+  uint16_t tail = uartRxTail;
+  uint8_t data;
+
+  if (tail == uartRxHead) {
+    return -1;
+  }
+  data = uartRxBuffer[tail];
+  __DMB(); // finish reading the slot before handing it back to the ISR
+  uartRxTail = (tail + 1) & (UART_RX_BUFFER_SIZE - 1);
+  return data;
+}
+
+
+uint32_t uart_rx_dropped(void)
+{
+  return uartRxDropped;
+}
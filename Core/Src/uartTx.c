@@ -0,0 +1,186 @@
+/**
+  ******************************************************************************
+  * @file           : uartTx.c
+
+  * @brief          : buffered USART2 (VCP) transmit drained by DMA
+  * @date           : 17-10-2026
+  *
+  * printf goes through _write into uart_tx_write, which only copies into a
+  * ring buffer and returns. Up to UART_TX_CHUNK bytes at a time are moved
+  * from the ring into a separate DMA buffer and sent on DMA1 Stream6; the
+  * transmit-complete callback sends the next chunk. Because the bytes being
+  * sent are never in the ring, the OVERWRITE policy can always reclaim the
+  * oldest queued bytes straight away.
+
+  ******************************************************************************
+  */
+
+#include <string.h>
+
+#include "uartTx.h"
+
+extern UART_HandleTypeDef huart2; // VCP
+
+static char uartTxRing[UART_TX_BUFFER_SIZE];
+static volatile uint16_t uartTxHead = 0;    // next free slot
+static volatile uint16_t uartTxTail = 0;    // oldest queued byte
+static uint8_t uartTxChunk[UART_TX_CHUNK];  // bytes currently owned by the DMA
+static volatile uint8_t uartTxBusy = 0;
+static volatile uint32_t uartTxDropped = 0;
+static uart_tx_policy_t uartTxPolicy = UART_TX_POLICY;
+
+#define UART_TX_USED()  ((uint16_t)((uartTxHead - uartTxTail) & (UART_TX_BUFFER_SIZE - 1)))
+#define UART_TX_FREE()  ((uint16_t)(UART_TX_BUFFER_SIZE - 1 - UART_TX_USED()))
+
+
+// Send the next chunk if the DMA is idle. Called with interrupts masked or
+// from the transmit-complete callback.
+static void uart_tx_kick(void)
+{
+  uint16_t count = UART_TX_USED(), i;
+
+  if (uartTxBusy || count == 0) {
+    return;
+  }
+  if (count > UART_TX_CHUNK) {
+    count = UART_TX_CHUNK;
+  }
+  for (i = 0; i < count; i++) {
+    uartTxChunk[i] = uartTxRing[(uartTxTail + i) & (UART_TX_BUFFER_SIZE - 1)];
+  }
+  uartTxTail = (uartTxTail + count) & (UART_TX_BUFFER_SIZE - 1);
+
+  uartTxBusy = 1;
+  if (HAL_UART_Transmit_DMA(&huart2, uartTxChunk, count) != HAL_OK) {
+    uartTxBusy = 0;
+    uartTxDropped += count;
+  }
+}
+
+
+// Copy as much of ptr as fits into the ring; returns how many bytes were taken
+static int uart_tx_enqueue(const char *ptr, int len)
+{
+  uint16_t room = UART_TX_FREE(), first;
+
+  if (len > room) {
+    len = room;
+  }
+  first = UART_TX_BUFFER_SIZE - uartTxHead; // bytes before the ring wraps
+  if (first > len) {
+    first = len;
+  }
+  memcpy(&uartTxRing[uartTxHead], ptr, first);
+  memcpy(uartTxRing, ptr + first, len - first);
+  uartTxHead = (uartTxHead + len) & (UART_TX_BUFFER_SIZE - 1);
+  return len;
+}
+
+
+// FUNCTION      : uart_tx_write
+// DESCRIPTION   :
+//   Queue bytes for transmission and return without waiting for them to be
+//   sent (except under UART_TX_BLOCK with a full buffer).
+// PARAMETERS    :
+//   const char *ptr : bytes to send
+//   int len         : number of bytes
+// RETURNS       :
+//   int : len, so printf never sees a short write
+int uart_tx_write(const char *ptr, int len)
+{
+  uint8_t inIsr = (__get_IPSR() != 0);
+  uint32_t primask;
+  int done = 0;
+
+  while (done < len) {
+    primask = __get_PRIMASK();
+    __disable_irq();
+
+    if (uartTxPolicy == UART_TX_OVERWRITE) {
+      int need = len - done;
+      if (need > UART_TX_BUFFER_SIZE - 1) {
+        // Only the newest bytes can fit
+        uartTxDropped += need - (UART_TX_BUFFER_SIZE - 1);
+        done = len - (UART_TX_BUFFER_SIZE - 1);
+        need = UART_TX_BUFFER_SIZE - 1;
+      }
+      if (need > UART_TX_FREE()) {
+        uint16_t discard = need - UART_TX_FREE();
+        uartTxTail = (uartTxTail + discard) & (UART_TX_BUFFER_SIZE - 1);
+        uartTxDropped += discard;
+      }
+    }
+    done += uart_tx_enqueue(ptr + done, len - done);
+    uart_tx_kick();
+
+    __set_PRIMASK(primask);
+
+    if (done < len) {
+      if (uartTxPolicy == UART_TX_BLOCK && !inIsr && !primask) {
+        while (UART_TX_FREE() == 0); // the DMA callback makes room
+      } else {
+        uartTxDropped += len - done;
+        break;
+      }
+    }
+  }
+  return len;
+}
+
+
+void uart_tx_set_policy(uart_tx_policy_t policy)
+{
+  uartTxPolicy = policy;
+}
+
+
+// FUNCTION      : uart_tx_flush
+// DESCRIPTION   :
+//   Wait until every queued byte has left the UART, e.g. before a reset or
+//   before stopping the clocks
+// PARAMETERS    :
+//   none
+// RETURNS       :
+//   nothing
+void uart_tx_flush(void)
+{
+  while (uart_tx_busy());
+}
+
+
+// Non-blocking form of uart_tx_flush, for callers that run with interrupts
+// masked and so can't wait for the DMA
+uint8_t uart_tx_busy(void)
+{
+  return uartTxBusy || UART_TX_USED() != 0;
+}
+
+
+uint16_t uart_tx_space(void)
+{
+  return UART_TX_FREE();
+}
+
+
+uint32_t uart_tx_dropped(void)
+{
+  return uartTxDropped;
+}
+
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+  if (huart->Instance == USART2) {
+    uartTxBusy = 0;
+    uart_tx_kick();
+  }
+}
+
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+  if (huart->Instance == USART2 && huart->gState == HAL_UART_STATE_READY) {
+    // A transmit error ended the chunk early; carry on with the next one
+    uartTxBusy = 0;
+    uart_tx_kick();
+  }
+}
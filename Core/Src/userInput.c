@@ -16,31 +16,21 @@
 #include <stdio.h>
 
 #include "userInput.h"
+#include "uartRx.h"
 
-extern UART_HandleTypeDef huart2; // VCP
 
 // FUNCTION      : GetCharFromUART2
 // DESCRIPTION   :
-//   Get a single character of input from UART2 and return standard HAL GPIO
-//   state information
+//   Get a single character of input from UART2 without waiting. Characters
+//   are collected by the USART2 interrupt (see uartRx.c), so none are lost
+//   between calls.
 // PARAMETERS    :
 //   none
 // RETURNS       :
-//  character received
+//  character received, or 0 if nothing is waiting
 char GetCharFromUART2 ( void )
 {
-  char	RxBuffer[LENGTH_OF_INPUT_ARRAY] = {0};
+  int ch = uart_read();
 
-  HAL_StatusTypeDef UartStatus = HAL_OK;
-
-  UartStatus = HAL_UART_Receive(&huart2, (uint8_t *)RxBuffer, 1, 1);
-
-
-  // check if Receive got a character
-  if( !((UartStatus == HAL_TIMEOUT) || (UartStatus == HAL_OK)) )
-  {
-    printf("ERROR in GetCharFromUART2\n\r");  // nothing received or error so signal that via a print
-  }
-
-  return *RxBuffer;
+  return (ch < 0) ? 0 : (char)ch;
 }
@@ -7,10 +7,24 @@
 C_SRCS += \
 ../Core/Src/DHT.c \
 ../Core/Src/adc.c \
+../Core/Src/adcScan.c \
+../Core/Src/clockProfile.c \
 ../Core/Src/debounce.c \
+../Core/Src/displayBench.c \
+../Core/Src/dma.c \
+../Core/Src/flashLog.c \
+../Core/Src/fontAtlas.c \
 ../Core/Src/fonts.c \
 ../Core/Src/gpio.c \
+../Core/Src/logger.c \
+../Core/Src/lowPower.c \
 ../Core/Src/main.c \
+../Core/Src/oledChart.c \
+../Core/Src/oledUi.c \
+../Core/Src/profiler.c \
+../Core/Src/sampleCodec.c \
+../Core/Src/scheduler.c \
+../Core/Src/sensorHistory.c \
 ../Core/Src/spi.c \
 ../Core/Src/ssd1331.c \
 ../Core/Src/stm32f4xx_hal_msp.c \
@@ -18,17 +32,34 @@ C_SRCS += \
 ../Core/Src/syscalls.c \
 ../Core/Src/sysmem.c \
 ../Core/Src/system_stm32f4xx.c \
+../Core/Src/telemetry.c \
 ../Core/Src/tim.c \
+../Core/Src/uartRx.c \
+../Core/Src/uartTx.c \
 ../Core/Src/usart.c \
 ../Core/Src/userInput.c 
 
 OBJS += \
 ./Core/Src/DHT.o \
 ./Core/Src/adc.o \
+./Core/Src/adcScan.o \
+./Core/Src/clockProfile.o \
 ./Core/Src/debounce.o \
+./Core/Src/displayBench.o \
+./Core/Src/dma.o \
+./Core/Src/flashLog.o \
+./Core/Src/fontAtlas.o \
 ./Core/Src/fonts.o \
 ./Core/Src/gpio.o \
+./Core/Src/logger.o \
+./Core/Src/lowPower.o \
 ./Core/Src/main.o \
+./Core/Src/oledChart.o \
+./Core/Src/oledUi.o \
+./Core/Src/profiler.o \
+./Core/Src/sampleCodec.o \
+./Core/Src/scheduler.o \
+./Core/Src/sensorHistory.o \
 ./Core/Src/spi.o \
 ./Core/Src/ssd1331.o \
 ./Core/Src/stm32f4xx_hal_msp.o \
@@ -36,17 +67,34 @@ OBJS += \
 ./Core/Src/syscalls.o \
 ./Core/Src/sysmem.o \
 ./Core/Src/system_stm32f4xx.o \
+./Core/Src/telemetry.o \
 ./Core/Src/tim.o \
+./Core/Src/uartRx.o \
+./Core/Src/uartTx.o \
 ./Core/Src/usart.o \
 ./Core/Src/userInput.o 
 
 C_DEPS += \
 ./Core/Src/DHT.d \
 ./Core/Src/adc.d \
+./Core/Src/adcScan.d \
+./Core/Src/clockProfile.d \
 ./Core/Src/debounce.d \
+./Core/Src/displayBench.d \
+./Core/Src/dma.d \
+./Core/Src/flashLog.d \
+./Core/Src/fontAtlas.d \
 ./Core/Src/fonts.d \
 ./Core/Src/gpio.d \
+./Core/Src/logger.d \
+./Core/Src/lowPower.d \
 ./Core/Src/main.d \
+./Core/Src/oledChart.d \
+./Core/Src/oledUi.d \
+./Core/Src/profiler.d \
+./Core/Src/sampleCodec.d \
+./Core/Src/scheduler.d \
+./Core/Src/sensorHistory.d \
 ./Core/Src/spi.d \
 ./Core/Src/ssd1331.d \
 ./Core/Src/stm32f4xx_hal_msp.d \
@@ -54,7 +102,10 @@ C_DEPS += \
 ./Core/Src/syscalls.d \
 ./Core/Src/sysmem.d \
 ./Core/Src/system_stm32f4xx.d \
+./Core/Src/telemetry.d \
 ./Core/Src/tim.d \
+./Core/Src/uartRx.d \
+./Core/Src/uartTx.d \
 ./Core/Src/usart.d \
 ./Core/Src/userInput.d 
 
@@ -66,7 +117,7 @@ Core/Src/%.o Core/Src/%.su Core/Src/%.cyclo: ../Core/Src/%.c Core/Src/subdir.mk
 clean: clean-Core-2f-Src
 
 clean-Core-2f-Src:
-	-$(RM) ./Core/Src/DHT.cyclo ./Core/Src/DHT.d ./Core/Src/DHT.o ./Core/Src/DHT.su ./Core/Src/adc.cyclo ./Core/Src/adc.d ./Core/Src/adc.o ./Core/Src/adc.su ./Core/Src/debounce.cyclo ./Core/Src/debounce.d ./Core/Src/debounce.o ./Core/Src/debounce.su ./Core/Src/fonts.cyclo ./Core/Src/fonts.d ./Core/Src/fonts.o ./Core/Src/fonts.su ./Core/Src/gpio.cyclo ./Core/Src/gpio.d ./Core/Src/gpio.o ./Core/Src/gpio.su ./Core/Src/main.cyclo ./Core/Src/main.d ./Core/Src/main.o ./Core/Src/main.su ./Core/Src/spi.cyclo ./Core/Src/spi.d ./Core/Src/spi.o ./Core/Src/spi.su ./Core/Src/ssd1331.cyclo ./Core/Src/ssd1331.d ./Core/Src/ssd1331.o ./Core/Src/ssd1331.su ./Core/Src/stm32f4xx_hal_msp.cyclo ./Core/Src/stm32f4xx_hal_msp.d ./Core/Src/stm32f4xx_hal_msp.o ./Core/Src/stm32f4xx_hal_msp.su ./Core/Src/stm32f4xx_it.cyclo ./Core/Src/stm32f4xx_it.d ./Core/Src/stm32f4xx_it.o ./Core/Src/stm32f4xx_it.su ./Core/Src/syscalls.cyclo ./Core/Src/syscalls.d ./Core/Src/syscalls.o ./Core/Src/syscalls.su ./Core/Src/sysmem.cyclo ./Core/Src/sysmem.d ./Core/Src/sysmem.o ./Core/Src/sysmem.su ./Core/Src/system_stm32f4xx.cyclo ./Core/Src/system_stm32f4xx.d ./Core/Src/system_stm32f4xx.o ./Core/Src/system_stm32f4xx.su ./Core/Src/tim.cyclo ./Core/Src/tim.d ./Core/Src/tim.o ./Core/Src/tim.su ./Core/Src/usart.cyclo ./Core/Src/usart.d ./Core/Src/usart.o ./Core/Src/usart.su ./Core/Src/userInput.cyclo ./Core/Src/userInput.d ./Core/Src/userInput.o ./Core/Src/userInput.su
+	-$(RM) ./Core/Src/DHT.cyclo ./Core/Src/DHT.d ./Core/Src/DHT.o ./Core/Src/DHT.su ./Core/Src/adc.cyclo ./Core/Src/adc.d ./Core/Src/adc.o ./Core/Src/adc.su ./Core/Src/adcScan.cyclo ./Core/Src/adcScan.d ./Core/Src/adcScan.o ./Core/Src/adcScan.su ./Core/Src/clockProfile.cyclo ./Core/Src/clockProfile.d ./Core/Src/clockProfile.o ./Core/Src/clockProfile.su ./Core/Src/debounce.cyclo ./Core/Src/debounce.d ./Core/Src/debounce.o ./Core/Src/debounce.su ./Core/Src/displayBench.cyclo ./Core/Src/displayBench.d ./Core/Src/displayBench.o ./Core/Src/displayBench.su ./Core/Src/dma.cyclo ./Core/Src/dma.d ./Core/Src/dma.o ./Core/Src/dma.su ./Core/Src/flashLog.cyclo ./Core/Src/flashLog.d ./Core/Src/flashLog.o ./Core/Src/flashLog.su ./Core/Src/fontAtlas.cyclo ./Core/Src/fontAtlas.d ./Core/Src/fontAtlas.o ./Core/Src/fontAtlas.su ./Core/Src/fonts.cyclo ./Core/Src/fonts.d ./Core/Src/fonts.o ./Core/Src/fonts.su ./Core/Src/gpio.cyclo ./Core/Src/gpio.d ./Core/Src/gpio.o ./Core/Src/gpio.su ./Core/Src/logger.cyclo ./Core/Src/logger.d ./Core/Src/logger.o ./Core/Src/logger.su ./Core/Src/lowPower.cyclo ./Core/Src/lowPower.d ./Core/Src/lowPower.o ./Core/Src/lowPower.su ./Core/Src/main.cyclo ./Core/Src/main.d ./Core/Src/main.o ./Core/Src/main.su ./Core/Src/oledChart.cyclo ./Core/Src/oledChart.d ./Core/Src/oledChart.o ./Core/Src/oledChart.su ./Core/Src/oledUi.cyclo ./Core/Src/oledUi.d ./Core/Src/oledUi.o ./Core/Src/oledUi.su ./Core/Src/profiler.cyclo ./Core/Src/profiler.d ./Core/Src/profiler.o ./Core/Src/profiler.su ./Core/Src/sampleCodec.cyclo ./Core/Src/sampleCodec.d ./Core/Src/sampleCodec.o ./Core/Src/sampleCodec.su ./Core/Src/scheduler.cyclo ./Core/Src/scheduler.d ./Core/Src/scheduler.o ./Core/Src/scheduler.su ./Core/Src/sensorHistory.cyclo ./Core/Src/sensorHistory.d ./Core/Src/sensorHistory.o ./Core/Src/sensorHistory.su ./Core/Src/spi.cyclo ./Core/Src/spi.d ./Core/Src/spi.o ./Core/Src/spi.su ./Core/Src/ssd1331.cyclo ./Core/Src/ssd1331.d ./Core/Src/ssd1331.o ./Core/Src/ssd1331.su ./Core/Src/stm32f4xx_hal_msp.cyclo ./Core/Src/stm32f4xx_hal_msp.d ./Core/Src/stm32f4xx_hal_msp.o ./Core/Src/stm32f4xx_hal_msp.su ./Core/Src/stm32f4xx_it.cyclo ./Core/Src/stm32f4xx_it.d ./Core/Src/stm32f4xx_it.o ./Core/Src/stm32f4xx_it.su ./Core/Src/syscalls.cyclo ./Core/Src/syscalls.d ./Core/Src/syscalls.o ./Core/Src/syscalls.su ./Core/Src/sysmem.cyclo ./Core/Src/sysmem.d ./Core/Src/sysmem.o ./Core/Src/sysmem.su ./Core/Src/system_stm32f4xx.cyclo ./Core/Src/system_stm32f4xx.d ./Core/Src/system_stm32f4xx.o ./Core/Src/system_stm32f4xx.su ./Core/Src/telemetry.cyclo ./Core/Src/telemetry.d ./Core/Src/telemetry.o ./Core/Src/telemetry.su ./Core/Src/tim.cyclo ./Core/Src/tim.d ./Core/Src/tim.o ./Core/Src/tim.su ./Core/Src/uartRx.cyclo ./Core/Src/uartRx.d ./Core/Src/uartRx.o ./Core/Src/uartRx.su ./Core/Src/uartTx.cyclo ./Core/Src/uartTx.d ./Core/Src/uartTx.o ./Core/Src/uartTx.su ./Core/Src/usart.cyclo ./Core/Src/usart.d ./Core/Src/usart.o ./Core/Src/usart.su ./Core/Src/userInput.cyclo ./Core/Src/userInput.d ./Core/Src/userInput.o ./Core/Src/userInput.su
 
 .PHONY: clean-Core-2f-Src
 
@@ -0,0 +1,485 @@
+/**
+  ******************************************************************************
+  * @file           : codecCheck.c
+
+  * @brief          : checks of the sample codec, the sensor history and the
+  *                   flash log against plain references
+  * @date           : 17-10-2026
+  *
+  *   codecCheck [-f flash.bin]
+  *
+  * Prints one line per check and exits with 1 if any of them failed:
+  *   codec     random streams of 1 to CODEC_MAX_CHANNELS channels, with runs
+  *             longer than a one-byte varint, values jumping across the whole
+  *             int32 range and a tick wrapping past 2^32, must decode to
+  *             exactly what was written, also when the buffer fills up
+  *   history   history_get() and history_stats() after every push, against
+  *             an array of everything pushed and sums over the window
+  *   flash     a page cut short by a reset at several points of its
+  *             programming must be skipped after the next flash_log_init(),
+  *             with every committed record still there and new records
+  *             appended after it; then the log is run around both sectors
+  * -f starts the flash check from that image if it exists (e.g. one that
+  * firmwareSim -f left behind) and saves the result back, torn page
+  * included, so that firmwareSim -f can boot on it.
+
+  ******************************************************************************
+  */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "main.h"
+#include "sampleCodec.h"
+#include "sensorHistory.h"
+#include "flashLog.h"
+#include "sim.h"
+
+#define STREAM_SAMPLES     4000
+#define HISTORY_PUSHES     3000
+#define FLASH_BATCH        150          // records between two tears, more than a page holds
+#define FLASH_MAX_RECORDS  400000
+
+// Where flashLog.c keeps its two sectors (see STM32F411RETX_FLASH.ld)
+#define LOG_SECTOR_BASE(s) (0x08040000UL + (uint32_t)(s) * FLASH_LOG_SECTOR_SIZE)
+#define LOG_PAGES          (FLASH_LOG_SECTOR_SIZE / FLASH_LOG_PAGE_SIZE)
+#define LOG_MAGIC          0x474F4C53UL
+
+typedef struct {
+	uint16_t boot;
+	flash_log_record_t record;
+} logged_t;
+
+static uint32_t seed = 0x12345678;
+static int failures = 0;
+
+
+// xorshift32, so that every run checks the same data
+static uint32_t rnd(void)
+{
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	return seed;
+}
+
+
+static void report(const char *name, int ok, const char *detail)
+{
+	printf("%-32s %s%s%s\n", name, ok ? "ok" : "FAIL", *detail ? ": " : "", detail);
+	if (!ok) {
+		failures++;
+	}
+}
+
+
+/* ---- Codec --------------------------------------------------------------- */
+
+// Next value of a channel: mostly steady or a small step, sometimes a jump
+// anywhere in the int32 range (the delta then wraps)
+static int32_t next_value(int32_t value)
+{
+	uint32_t r = rnd() % 100;
+
+	if (r < 60) return value;
+	if (r < 95) return value + (int32_t)(rnd() % 7) - 3;
+	if (r < 97) return (rnd() & 1) ? INT32_MAX : INT32_MIN;
+	return (int32_t)rnd();
+}
+
+
+// Writes up to STREAM_SAMPLES samples into a buffer of the given size and
+// reads them back; the samples that didn't fit must not show up. About one
+// change in runEvery starts a run of repeats. Returns 1
+// if everything matched, with the sizes in detail, 0 with what didn't.
+static int run_stream(uint8_t channels, uint16_t size, uint32_t tick, uint8_t runEvery, char *detail, size_t length)
+{
+	static uint32_t ticks[STREAM_SAMPLES];
+	static int32_t values[STREAM_SAMPLES][CODEC_MAX_CHANNELS];
+	static uint8_t buf[0xFFFF];
+	codec_writer_t writer;
+	codec_reader_t reader;
+	uint32_t dt = 1000, readTick, i, written = 0, repeat = 0;
+	int32_t value[CODEC_MAX_CHANNELS] = {0}, readValue[CODEC_MAX_CHANNELS];
+	uint8_t ch, full = 0;
+
+	codec_writer_init(&writer, buf, size, channels);
+	for (i = 0; i < STREAM_SAMPLES && !full; i++) {
+		if (repeat > 0) {
+			repeat--;        // same step, same values: grows a run
+		} else if (rnd() % runEvery == 0) {
+			repeat = rnd() % 300;
+		} else {
+			if (rnd() % 8 == 0) dt = (rnd() % 4 == 0) ? rnd() % 100000 : 1000 + rnd() % 5 - 2;
+			for (ch = 0; ch < channels; ch++) value[ch] = next_value(value[ch]);
+		}
+		tick += dt;
+		if (codec_write(&writer, tick, value)) {
+			ticks[written] = tick;
+			memcpy(values[written], value, sizeof(value));
+			written++;
+		} else {
+			full = 1;
+		}
+	}
+	if (writer.count != written || writer.len > size) {
+		snprintf(detail, length, "writer counted %u samples in %u bytes, %u were accepted into %u",
+				writer.count, writer.len, written, size);
+		return 0;
+	}
+
+	codec_reader_init(&reader, buf, writer.len, channels);
+	for (i = 0; i < written; i++) {
+		if (!codec_read(&reader, &readTick, readValue)) {
+			snprintf(detail, length, "stream ends at sample %u of %u", i, written);
+			return 0;
+		}
+		if (readTick != ticks[i] || memcmp(readValue, values[i], channels * sizeof(int32_t)) != 0) {
+			snprintf(detail, length, "sample %u: tick %u value %d, wrote tick %u value %d",
+					i, readTick, readValue[0], ticks[i], values[i][0]);
+			return 0;
+		}
+	}
+	if (codec_read(&reader, &readTick, readValue)) {
+		snprintf(detail, length, "a sample past the %u written", written);
+		return 0;
+	}
+	snprintf(detail, length, "%u samples in %u bytes%s", written, writer.len, full ? ", buffer full" : "");
+	return 1;
+}
+
+
+static void check_stream(const char *name, uint8_t channels, uint16_t size, uint32_t tick)
+{
+	char detail[96];
+
+	report(name, run_stream(channels, size, tick, 16, detail, sizeof(detail)), detail);
+}
+
+
+static void check_codec(void)
+{
+	char detail[96];
+	uint16_t size;
+	uint8_t channels;
+	int ok = 1;
+
+	check_stream("codec 1 channel", 1, 0xFFFF, 0);
+	check_stream("codec 3 channels, tick wraps", 3, 0xFFFF, 0xFFFFFFFFUL - 2000000UL);
+	check_stream("codec 4 channels", CODEC_MAX_CHANNELS, 0xFFFF, 0);
+	check_stream("codec 3 channels, 248 B page", 3, FLASH_LOG_PAGE_DATA, 0);
+	check_stream("codec 1 channel, 48 B block", 1, 48, 0);
+
+	// Every small size, so that a sample or a run growing a byte lands right
+	// at the end, with few runs and with one after every change
+	for (size = 1; size <= 256 && ok; size++) {
+		for (channels = 1; channels <= CODEC_MAX_CHANNELS && ok; channels++) {
+			ok = run_stream(channels, size, 0, 16, detail, sizeof(detail))
+					&& run_stream(channels, size, 0, 1, detail, sizeof(detail));
+		}
+	}
+	if (ok) {
+		snprintf(detail, sizeof(detail), "1 to 4 channels into 1 to 256 bytes");
+	}
+	report("codec full buffers", ok, detail);
+}
+
+
+/* ---- History ------------------------------------------------------------- */
+
+// Pushes samples into one channel and compares everything the module gives
+// back after each push
+static void check_history(const char *name, uint8_t channel, uint32_t spread, uint8_t quiet)
+{
+	static history_sample_t pushed[HISTORY_PUSHES];
+	history_sample_t sample;
+	history_stats_t stats;
+	uint32_t i, tick = 0xFFFFFFFFUL - 500000UL;  // the tick wraps on the way
+	int32_t value = 0;
+	uint16_t age, count, window;
+	char detail[96] = "";
+
+	for (i = 0; i < HISTORY_PUSHES && !*detail; i++) {
+		if (quiet) {
+			// What the module is sized for: a steady interval, a step now and then
+			tick += 1000;
+			value += (rnd() % 4 == 0) ? (int32_t)(rnd() % 2) * 2 - 1 : 0;
+		} else {
+			tick += 1000 + rnd() % 50;
+			value = (int32_t)(rnd() % (2 * spread + 1)) - (int32_t)spread;
+		}
+		pushed[i].tick = tick;
+		pushed[i].value = value;
+		history_push(channel, tick, value);
+
+		count = history_count(channel);
+		if (count > i + 1 || count > HISTORY_DEPTH || (quiet && count != ((i + 1 < HISTORY_DEPTH) ? i + 1 : HISTORY_DEPTH))) {
+			snprintf(detail, sizeof(detail), "push %u: %u samples stored", i, count);
+			break;
+		}
+		for (age = 0; age < count; age++) {
+			if (!history_get(channel, age, &sample) || sample.tick != pushed[i - age].tick
+					|| sample.value != pushed[i - age].value) {
+				snprintf(detail, sizeof(detail), "push %u: age %u is %u/%d, pushed %u/%d", i, age,
+						sample.tick, sample.value, pushed[i - age].tick, pushed[i - age].value);
+				break;
+			}
+		}
+		if (!*detail && history_get(channel, count, &sample)) {
+			snprintf(detail, sizeof(detail), "push %u: age %u exists with %u stored", i, count, count);
+		}
+
+		// Brute force over the window, in double
+		double sum = 0, sumSq = 0, mean, variance;
+		int32_t min = INT32_MAX, max = INT32_MIN, v;
+		window = (i + 1 < HISTORY_WINDOW) ? i + 1 : HISTORY_WINDOW;
+		for (age = 0; age < window; age++) {
+			v = pushed[i - age].value;
+			sum += v;
+			if (v < min) min = v;
+			if (v > max) max = v;
+		}
+		mean = sum / window;
+		for (age = 0; age < window; age++) {
+			sumSq += (pushed[i - age].value - mean) * (pushed[i - age].value - mean);
+		}
+		variance = sumSq / window;
+
+		history_stats(channel, &stats);
+		if (!*detail && (stats.count != window || stats.min != min || stats.max != max
+				|| fabs(stats.mean - mean) > 1e-5 * fabs(mean) + 1e-3
+				|| fabs(stats.variance - variance) > 1e-4 * variance + 1e-3)) {
+			snprintf(detail, sizeof(detail), "push %u: n %u mean %.3f var %.3f min %d max %d, expected %u %.3f %.3f %d %d",
+					i, stats.count, stats.mean, stats.variance, stats.min, stats.max, window, mean, variance, min, max);
+		}
+	}
+	if (!*detail) {
+		snprintf(detail, sizeof(detail), "%u pushes, %u kept", HISTORY_PUSHES, history_count(channel));
+		report(name, 1, detail);
+	} else {
+		report(name, 0, detail);
+	}
+}
+
+
+/* ---- Flash log ----------------------------------------------------------- */
+
+static logged_t *expected;          // what the log should hold, oldest first
+static uint32_t expectedCount = 0;
+
+
+static flash_log_record_t make_record(void)
+{
+	static uint32_t time = 0;
+	flash_log_record_t record;
+
+	time += 1000 + rnd() % 3;
+	record.time = time;
+	record.humidity = (rnd() % 20 == 0) ? FLASH_LOG_NO_DATA : 40 + rnd() % 5;
+	record.temperature = (int8_t)(20 + rnd() % 3);
+	record.light = (uint16_t)(rnd() % 4096);
+	return record;
+}
+
+
+static int same_record(const flash_log_record_t *a, const flash_log_record_t *b)
+{
+	return a->time == b->time && a->humidity == b->humidity && a->temperature == b->temperature && a->light == b->light;
+}
+
+
+// Appends records and syncs, so that all of them are committed
+static void log_records(uint32_t count)
+{
+	flash_log_info_t info;
+
+	flash_log_info(&info);
+	while (count-- && expectedCount < FLASH_MAX_RECORDS) {
+		expected[expectedCount].boot = info.boot;
+		expected[expectedCount].record = make_record();
+		flash_log_append(&expected[expectedCount].record);
+		expectedCount++;
+	}
+	flash_log_sync();
+}
+
+
+// Dumps the log; it must be the newest records of the expected list, all
+// of them unless the log wrapped. Returns how many were dumped, 0 on a mismatch.
+static uint32_t check_dump(char *detail, size_t size)
+{
+	flash_log_cursor_t cursor;
+	flash_log_record_t record;
+	flash_log_info_t info;
+	uint32_t n = 0, first;
+	uint16_t boot;
+
+	flash_log_info(&info);
+	if (info.records > expectedCount) {
+		snprintf(detail, size, "%u records in flash, %u logged", info.records, expectedCount);
+		return 0;
+	}
+	first = expectedCount - info.records;
+	flash_log_dump_begin(&cursor);
+	while (flash_log_dump_next(&cursor, &boot, &record)) {
+		if (first + n >= expectedCount) {
+			snprintf(detail, size, "more records dumped than the %u counted", info.records);
+			return 0;
+		}
+		if (boot != expected[first + n].boot || !same_record(&record, &expected[first + n].record)) {
+			snprintf(detail, size, "record %u: boot %u time %u, logged boot %u time %u",
+					first + n, boot, record.time, expected[first + n].boot, expected[first + n].record.time);
+			return 0;
+		}
+		n++;
+	}
+	if (n != info.records) {
+		snprintf(detail, size, "%u records dumped, %u counted", n, info.records);
+		return 0;
+	}
+	return n;
+}
+
+
+// The page programmed last: the highest non-blank one of the newest sector
+static uint32_t last_page(void)
+{
+	uint32_t best = 0, seq = 0, s, p;
+
+	for (s = 0; s < FLASH_LOG_SECTOR_COUNT; s++) {
+		const uint32_t *header = (const uint32_t *)LOG_SECTOR_BASE(s);   // seq, ~seq, erases, magic
+		if (header[3] != LOG_MAGIC || header[1] != ~header[0] || (best && header[0] <= seq)) continue;
+		for (p = LOG_PAGES - 1; p > 0; p--) {
+			if (*(const uint32_t *)(LOG_SECTOR_BASE(s) + p * FLASH_LOG_PAGE_SIZE) != 0xFFFFFFFFUL) {
+				best = LOG_SECTOR_BASE(s) + p * FLASH_LOG_PAGE_SIZE;
+				seq = header[0];
+				break;
+			}
+		}
+	}
+	return best;
+}
+
+
+// Leaves the last page as a reset would have after programming its first
+// `words` words: flashLog.c writes the CRC and the data words first, from
+// offset 4, and the commit word at offset 0 last. The flash is plain memory
+// in the simulator, so "unprogramming" is a write.
+static uint32_t tear_last_page(uint16_t words)
+{
+	uint32_t *page = (uint32_t *)(uintptr_t)last_page();
+	uint32_t records;
+	uint16_t i;
+
+	if (page == NULL) return 0;
+	records = page[0] >> 16;
+	page[0] = 0xFFFFFFFFUL;
+	for (i = 1 + words; i < FLASH_LOG_PAGE_SIZE / 4; i++) {
+		page[i] = 0xFFFFFFFFUL;
+	}
+	return records;
+}
+
+
+static void check_flash(const char *path)
+{
+	static const uint16_t tearAt[] = { 1, 2, 32, FLASH_LOG_PAGE_SIZE / 4 - 1 };
+	flash_log_info_t info;
+	char detail[128] = "", name[40];
+	uint32_t n, lost, erases;
+	uint8_t i;
+
+	expected = malloc(FLASH_MAX_RECORDS * sizeof(*expected));
+	if (path != NULL && access(path, R_OK) == 0 && sim_flash_load(path) != 0) {
+		snprintf(detail, sizeof(detail), "can't load %s", path);
+		report("flash image", 0, detail);
+		return;
+	}
+
+	// Whatever the image holds already is the start of the expected log
+	flash_log_init();
+	{
+		flash_log_cursor_t cursor;
+		flash_log_dump_begin(&cursor);
+		while (expectedCount < FLASH_MAX_RECORDS
+				&& flash_log_dump_next(&cursor, &expected[expectedCount].boot, &expected[expectedCount].record)) {
+			expectedCount++;
+		}
+	}
+	n = check_dump(detail, sizeof(detail));
+	snprintf(name, sizeof(name), "flash boot, %u records", expectedCount);
+	report(name, *detail == 0, detail);
+
+	for (i = 0; i < sizeof(tearAt) / sizeof(tearAt[0]); i++) {
+		log_records(FLASH_BATCH);
+		lost = tear_last_page(tearAt[i]);
+		expectedCount -= lost;    // the records of the torn page, the newest ones
+		flash_log_init();         // the reset
+		log_records(FLASH_BATCH); // must go after the torn page, not onto it
+		flash_log_init();
+		*detail = 0;
+		n = check_dump(detail, sizeof(detail));
+		snprintf(name, sizeof(name), "flash torn after %u words", tearAt[i]);
+		if (!*detail) {
+			snprintf(detail, sizeof(detail), "%u records lost, %u read back", lost, n);
+		}
+		report(name, n != 0, detail);
+	}
+
+	// Around both sectors: the oldest records go, the rest stay in order
+	flash_log_info(&info);
+	erases = info.erases[0] + info.erases[1];
+	while (expectedCount + 1000 < FLASH_MAX_RECORDS && info.erases[0] + info.erases[1] < erases + 2) {
+		log_records(1000);
+		flash_log_info(&info);
+	}
+	flash_log_init();
+	*detail = 0;
+	n = check_dump(detail, sizeof(detail));
+	if (!*detail) {
+		snprintf(detail, sizeof(detail), "%u of %u records kept, erases %u/%u", n, expectedCount, info.erases[0], info.erases[1]);
+		if (info.erases[0] + info.erases[1] < erases + 2) n = 0;
+	}
+	report("flash wraps around", n != 0, detail);
+
+	// End on a torn page for whoever boots on the image next
+	log_records(FLASH_BATCH);
+	tear_last_page(16);
+	if (path != NULL && sim_flash_save(path) != 0) {
+		snprintf(detail, sizeof(detail), "can't write %s", path);
+		report("flash image", 0, detail);
+	}
+	free(expected);
+}
+
+
+int main(int argc, char **argv)
+{
+	const char *flashPath = NULL;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "f:")) != -1) {
+		if (opt == 'f') {
+			flashPath = optarg;
+		} else {
+			fprintf(stderr, "usage: %s [-f flash.bin]\n", argv[0]);
+			return 2;
+		}
+	}
+
+	sim_init();
+	sim_uart_output(NULL);
+	sim_board_init();
+
+	check_codec();
+	check_history("history quiet humidity", HISTORY_HUMIDITY, 0, 1);
+	check_history("history noisy temperature", HISTORY_TEMPERATURE, 100000, 0);
+	check_history("history light", HISTORY_LIGHT, 2048, 0);
+	check_flash(flashPath);
+
+	printf("%s\n", failures ? "FAILED" : "all ok");
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,79 @@
+/**
+  ******************************************************************************
+  * @file           : displayBench.c
+
+  * @brief          : the firmware's display benchmark on the simulated board
+  * @date           : 17-10-2026
+  *
+  *   displayBench [-n runs]
+  *
+  * Runs the cases of Core/Src/displayBench.c (menu key 'b' on the board) at
+  * 100 MHz and prints the same CSV table on stdout, with the times the target
+  * would take. The SPI counts the driver reports are checked against the
+  * bytes and transfers the simulated SPI2 actually saw; a mismatch is printed
+  * on stderr and makes the exit status 1.
+
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "main.h"
+#include "ssd1331.h"
+#include "displayBench.h"
+#include "sim.h"
+
+
+static int oled_idle(void)
+{
+	return !ssd1331_is_busy();
+}
+
+
+int main(int argc, char **argv)
+{
+	display_bench_result_t result;
+	sim_stats_t stats;
+	uint32_t runs = DISPLAY_BENCH_RUNS;
+	int opt, status = 0;
+
+	while ((opt = getopt(argc, argv, "n:")) != -1) {
+		if (opt == 'n') {
+			runs = (uint32_t)strtoul(optarg, NULL, 0);
+		} else {
+			fprintf(stderr, "usage: %s [-n runs]\n", argv[0]);
+			return 2;
+		}
+	}
+	if (runs == 0 || runs > 0xFFFF) {
+		runs = DISPLAY_BENCH_RUNS;
+	}
+
+	sim_init();
+	sim_board_init();
+	ssd1331_init();
+	sim_idle_until(oled_idle);
+
+	display_bench_print_header((uint16_t)runs);
+	for (uint8_t index = 0; index < display_bench_cases(); index++) {
+		display_bench_setup(index);
+		sim_idle_until(oled_idle);
+		sim_stats_reset();
+		display_bench_case(index, (uint16_t)runs, &result);
+		sim_stats(&stats);
+		display_bench_print(&result);
+		// print() only queues the line on USART2, let it out before the next case
+		sim_advance_us(100000);
+
+		if (stats.spiBytes != (uint64_t)result.spiBytes * runs || stats.spiTransfers != result.spiTransfers * runs) {
+			fprintf(stderr, "%s: driver counted %u bytes / %u transfers per call, SPI2 saw %llu / %u in %u calls\n",
+					result.name, result.spiBytes, result.spiTransfers,
+					(unsigned long long)stats.spiBytes, stats.spiTransfers, runs);
+			status = 1;
+		}
+	}
+	fflush(stdout);
+	return status;
+}
@@ -0,0 +1,310 @@
+/**
+  ******************************************************************************
+  * @file           : driverBench.c
+
+  * @brief          : throughput and latency of the drivers on the simulated
+  *                   board
+  * @date           : 17-10-2026
+  *
+  *   driverBench [-n runs]
+  *
+  * Brings the board up as main() does (100 MHz, SPI2 at 6.25 MHz) and times
+  * each case over a number of runs. Per run it prints:
+  *   sim_us    virtual time from the call until the panel / sensor is idle
+  *             again, i.e. what the target would spend at this clock
+  *   spi_B     SPI2 bytes sent, xfers the HAL_SPI_Transmit(_DMA) calls
+  *   host_ns   real time the host spent in the calls; a rough CPU cost,
+  *             inflated where the driver busy-waits on the simulated SPI
+  * A check column compares a pixel of the simulated panel with what the
+  * case should have drawn.
+
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "main.h"
+#include "ssd1331.h"
+#include "DHT.h"
+#include "debounce.h"
+#include "userInput.h"
+#include "uartRx.h"
+#include "sim.h"
+
+typedef struct {
+	const char *name;
+	void (*run)(uint32_t i);
+	uint8_t checkX, checkY;     // pixel that must end up checkColor
+	uint16_t checkColor;
+} bench_case_t;
+
+static const uint8_t bitmap[32] = {            // 16x16, a frame with a cross
+	0xFF, 0xFF, 0xC0, 0x03, 0xA0, 0x05, 0x90, 0x09, 0x88, 0x11, 0x84, 0x21, 0x82, 0x41, 0x81, 0x81,
+	0x81, 0x81, 0x82, 0x41, 0x84, 0x21, 0x88, 0x11, 0x90, 0x09, 0xA0, 0x05, 0xC0, 0x03, 0xFF, 0xFF,
+};
+
+
+static uint64_t host_ns(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+
+static int oled_idle(void)
+{
+	return !ssd1331_is_busy();
+}
+
+
+static int dht_idle(void)
+{
+	return !DHT_IsBusy();
+}
+
+
+/* ---- Display cases ------------------------------------------------------- */
+
+static void run_clear(uint32_t i)
+{
+	ssd1331_clear_screen((i & 1) ? BLUE : BLACK);
+	ssd1331_clear_screen(BLACK);
+}
+
+static void run_fill_rect(uint32_t i)
+{
+	ssd1331_fill_rect(10, 10, 40, 20, (i & 1) ? GREEN : RED);
+	ssd1331_fill_rect(10, 10, 40, 20, RED);
+}
+
+static void run_string(uint32_t i)
+{
+	ssd1331_display_string(0, 0, (i & 1) ? "Temp: 23 C" : "Temp: 22 C", FONT_1206, WHITE);
+	ssd1331_flush();
+}
+
+static void run_string_1608(uint32_t i)
+{
+	ssd1331_display_string(0, 16, (i & 1) ? "Hum: 46 %" : "Hum: 45 %", FONT_1608, WHITE);
+	ssd1331_flush();
+}
+
+static void run_num(uint32_t i)
+{
+	ssd1331_display_num(0, 32, 1000 + i % 9000, 4, FONT_1206, YELLOW);
+	ssd1331_flush();
+}
+
+static void run_circle(uint32_t i)
+{
+	ssd1331_draw_circle(48, 32, 20, (i & 1) ? CYAN : WHITE);
+	ssd1331_flush();
+}
+
+static void run_line(uint32_t i)
+{
+	ssd1331_draw_line(0, 0, 95, 63, (i & 1) ? PINK : WHITE);
+	ssd1331_flush();
+}
+
+static void run_rect(uint32_t i)
+{
+	ssd1331_draw_rect(5, 5, 60, 40, (i & 1) ? GOLDEN : WHITE);
+	ssd1331_flush();
+}
+
+static void run_bitmap(uint32_t i)
+{
+	ssd1331_draw_bitmap(70, 40, bitmap, 16, 16, (i & 1) ? PURPLE : WHITE);
+	ssd1331_flush();
+}
+
+static void run_points(uint32_t i)
+{
+	for (uint8_t x = 0; x < 96; x += 3) {
+		ssd1331_draw_point(x, 60, (i & 1) ? GREY : WHITE);
+	}
+	ssd1331_flush();
+}
+
+static const bench_case_t displayCases[] = {
+	{ "clear_screen x2",       run_clear,       50, 50, BLACK },
+	{ "fill_rect 40x20 x2",    run_fill_rect,   20, 20, RED },
+	{ "display_string 1206",   run_string,       0,  5, BLACK },
+	{ "display_string 1608",   run_string_1608,  0, 20, BLACK },
+	{ "display_num 4 digits",  run_num,          0, 33, BLACK },
+	{ "draw_circle r20",       run_circle,      28, 32, WHITE },
+	{ "draw_line diagonal",    run_line,         0,  0, WHITE },
+	{ "draw_rect 60x40",       run_rect,         5, 20, WHITE },
+	{ "draw_bitmap 16x16",     run_bitmap,      70, 40, WHITE },
+	{ "draw_point x32",        run_points,       0, 60, WHITE },
+};
+
+
+// FUNCTION      : bench_display
+// DESCRIPTION   :
+//   Time one display case: the calls themselves on the host clock, then the
+//   virtual time until the DMA queue and the controller are idle.
+// PARAMETERS    :
+//   const bench_case_t *test : case to run
+//   uint32_t runs            : number of runs to average over
+// RETURNS       :
+//   nothing
+static void bench_display(const bench_case_t *test, uint32_t runs)
+{
+	uint64_t simStart, hostSpent = 0, hostStart;
+	sim_stats_t stats;
+	uint16_t pixel;
+
+	ssd1331_wait_idle();
+	sim_stats_reset();
+	simStart = sim_time_ns();
+	for (uint32_t i = runs; i-- > 0; ) {
+		hostStart = host_ns();
+		test->run(i);
+		hostSpent += host_ns() - hostStart;
+		sim_idle_until(oled_idle);
+	}
+	sim_stats(&stats);
+	// The last run is run(0), which draws in the colours the check expects
+	pixel = sim_oled_pixel(test->checkX, test->checkY);
+
+	printf("%-24s %10.1f %9.1f %7.1f %10.0f  %s\n", test->name,
+			(double)(sim_time_ns() - simStart) / 1000.0 / runs,
+			(double)stats.spiBytes / runs, (double)stats.spiTransfers / runs,
+			(double)hostSpent / runs, (pixel == test->checkColor) ? "ok" : "MISMATCH");
+}
+
+
+/* ---- Sensor and input cases ---------------------------------------------- */
+
+static void bench_dht(uint32_t runs)
+{
+	DHT_DataTypedef data = { 0 };
+	uint64_t simStart, simSpent = 0, hostStart, hostSpent = 0;
+	uint32_t good = 0;
+
+	for (uint32_t i = 0; i < runs; i++) {
+		sim_dht_set((uint8_t)(30 + i % 50), (int8_t)(15 + i % 20), 1);
+		simStart = sim_time_ns();
+		hostStart = host_ns();
+		DHT_StartRead();
+		hostSpent += host_ns() - hostStart;
+		sim_idle_until(dht_idle);
+		simSpent += sim_time_ns() - simStart;
+		if (DHT_GetResult(&data) == DHT_READY && data.Humidity == 30 + i % 50 && data.Temperature == 15 + i % 20) {
+			good++;
+		}
+		sim_advance_us(1000);
+	}
+	printf("%-24s %10.1f %9s %7s %10.0f  %u/%u read back\n", "DHT11 read", (double)simSpent / 1000.0 / runs,
+			"-", "-", (double)hostSpent / runs, good, runs);
+
+	sim_dht_set(0, 0, 0);
+	simStart = sim_time_ns();
+	DHT_StartRead();
+	sim_idle_until(dht_idle);
+	printf("%-24s %10.1f %9s %7s %10s  %s\n", "DHT11 no sensor", (double)(sim_time_ns() - simStart) / 1000.0,
+			"-", "-", "-", (DHT_GetResult(&data) == DHT_FAILED) ? "ok" : "MISMATCH");
+	sim_dht_set(45, 22, 1);
+}
+
+
+static void bounce(uint32_t level)
+{
+	sim_gpio_set_input(2, B0_Pin, (uint8_t)level);
+}
+
+
+static void bench_debounce(uint32_t runs)
+{
+	uint64_t simStart, simSpent = 0, hostStart, hostSpent = 0;
+	uint32_t good = 0;
+
+	deBounceInit(13, 'C', 1);
+	for (uint32_t i = 0; i < runs; i++) {
+		// 3 ms of contact bounce, then pressed (low) for good
+		sim_gpio_set_input(2, B0_Pin, 1);
+		for (uint32_t t = 1; t <= 10; t++) {
+			sim_event_at(sim_time_ns() + t * 300000ULL, bounce, t & 1);
+		}
+		simStart = sim_time_ns();
+		hostStart = host_ns();
+		if (deBounceReadPin(13, 'C', 10) == GPIO_PIN_RESET) {
+			good++;
+		}
+		hostSpent += host_ns() - hostStart;
+		simSpent += sim_time_ns() - simStart;
+	}
+	printf("%-24s %10.1f %9s %7s %10.0f  %u/%u settled low\n", "debounce 10 ms (bouncy)",
+			(double)simSpent / 1000.0 / runs, "-", "-", (double)hostSpent / runs, good, runs);
+}
+
+
+static void bench_input(uint32_t runs)
+{
+	uint64_t simStart, simSpent = 0, hostStart, hostSpent = 0;
+	uint32_t polls = 0, good = 0;
+	char ch;
+
+	for (uint32_t i = 0; i < runs; i++) {
+		sim_uart_input("k", 1);
+		simStart = sim_time_ns();
+		hostStart = host_ns();
+		while ((ch = GetCharFromUART2()) == 0) {
+			polls++;
+			sim_advance_us(1);
+		}
+		hostSpent += host_ns() - hostStart;
+		simSpent += sim_time_ns() - simStart;
+		good += (ch == 'k');
+	}
+	printf("%-24s %10.1f %9s %7s %10.0f  %u/%u received\n", "key to GetCharFromUART2",
+			(double)simSpent / 1000.0 / runs, "-", "-", (double)hostSpent / (polls + runs), good, runs);
+}
+
+
+int main(int argc, char **argv)
+{
+	uint32_t runs = 100;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "n:")) != -1) {
+		if (opt == 'n') {
+			runs = (uint32_t)strtoul(optarg, NULL, 0);
+		} else {
+			fprintf(stderr, "usage: %s [-n runs]\n", argv[0]);
+			return 2;
+		}
+	}
+	if (runs == 0) {
+		runs = 1;
+	}
+
+	sim_init();
+	sim_uart_output(NULL);      // the drivers' own printf output isn't wanted here
+	sim_board_init();
+	uart_rx_init();
+	ssd1331_init();
+	sim_idle_until(oled_idle);
+
+	printf("# %u runs per case, core at %u MHz\n", runs, (unsigned)(SystemCoreClock / 1000000));
+	printf("%-24s %10s %9s %7s %10s  %s\n", "case", "sim_us", "spi_B", "xfers", "host_ns", "check");
+	for (size_t c = 0; c < sizeof(displayCases) / sizeof(displayCases[0]); c++) {
+		bench_display(&displayCases[c], runs);
+	}
+	bench_dht(runs < 20 ? runs : 20);
+	bench_debounce(runs < 20 ? runs : 20);
+	bench_input(runs);
+
+	if (sim_oled_unknown_commands()) {
+		printf("# %u unknown SSD1331 command bytes\n", sim_oled_unknown_commands());
+	}
+	return 0;
+}
@@ -0,0 +1,139 @@
+/**
+  ******************************************************************************
+  * @file           : firmwareSim.c
+
+  * @brief          : runs the whole firmware on the simulated board
+  * @date           : 17-10-2026
+  *
+  *   firmwareSim [-t seconds] [-k [ms:]keys]... [-d hum,temp] [-o oled.ppm]
+  *               [-w trace.vcd] [-f flash.bin]
+  *
+  * main() runs for the given virtual time (10 s by default) with its console
+  * on stdout. Each -k types its keys on the console, at the given virtual ms
+  * or one second after the previous -k ("\r" and "\n" are understood).
+  * Afterwards the simulator statistics go to stderr, the OLED contents to a
+  * PPM file and the pin waveforms to a VCD file if asked for. -f loads the
+  * flash from a file if it exists and saves it back at the end, so the flash
+  * log survives between runs.
+
+  ******************************************************************************
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "sim.h"
+
+#define MAX_KEYS        32
+
+static char *keys[MAX_KEYS];
+static uint8_t keyCount = 0;
+
+
+static void type_keys(uint32_t index)
+{
+	sim_uart_input(keys[index], (uint16_t)strlen(keys[index]));
+}
+
+
+// "\r" and "\n" written on the command line to the real characters, in place
+static char *unescape(char *text)
+{
+	char *in = text, *out = text;
+
+	while (*in) {
+		if (in[0] == '\\' && (in[1] == 'r' || in[1] == 'n')) {
+			*out++ = (in[1] == 'r') ? '\r' : '\n';
+			in += 2;
+		} else {
+			*out++ = *in++;
+		}
+	}
+	*out = '\0';
+	return text;
+}
+
+
+int main(int argc, char **argv)
+{
+	const char *ppmPath = NULL, *vcdPath = NULL, *flashPath = NULL;
+	uint32_t seconds = 10, humidity, temperature;
+	uint64_t keyMs = 1500;
+	sim_stats_t stats;
+	char *colon;
+	int opt;
+
+	sim_init();
+	while ((opt = getopt(argc, argv, "t:k:d:o:w:f:h")) != -1) {
+		switch (opt) {
+		case 't':
+			seconds = (uint32_t)strtoul(optarg, NULL, 0);
+			break;
+		case 'k':
+			if (keyCount == MAX_KEYS) {
+				break;
+			}
+			colon = strchr(optarg, ':');
+			if (colon != NULL && colon != optarg && strspn(optarg, "0123456789") == (size_t)(colon - optarg)) {
+				keyMs = strtoull(optarg, NULL, 10);
+				optarg = colon + 1;
+			}
+			keys[keyCount] = unescape(optarg);
+			sim_event_at(keyMs * 1000000ULL, type_keys, keyCount);
+			keyCount++;
+			keyMs += 1000;
+			break;
+		case 'd':
+			if (sscanf(optarg, "%u,%u", &humidity, &temperature) == 2) {
+				sim_dht_set((uint8_t)humidity, (int8_t)temperature, 1);
+			} else {
+				sim_dht_set(0, 0, 0);   // no sensor on the line
+			}
+			break;
+		case 'o':
+			ppmPath = optarg;
+			break;
+		case 'w':
+			vcdPath = optarg;
+			sim_trace_start();
+			break;
+		case 'f':
+			flashPath = optarg;
+			if (access(flashPath, R_OK) == 0 && sim_flash_load(flashPath) != 0) {
+				fprintf(stderr, "can't load %s\n", flashPath);
+				return 1;
+			}
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-t seconds] [-k [ms:]keys]... [-d hum,temp|none] [-o oled.ppm] "
+					"[-w trace.vcd] [-f flash.bin]\n", argv[0]);
+			return opt == 'h' ? 0 : 2;
+		}
+	}
+
+	sim_run_firmware(seconds * 1000);
+	fflush(stdout);
+
+	sim_stats(&stats);
+	fprintf(stderr, "\n--- %u s simulated\n", seconds);
+	fprintf(stderr, "spi: %llu bytes, %u transfers, %u CS frames, busy %llu us\n",
+			(unsigned long long)stats.spiBytes, stats.spiTransfers, stats.spiFrames,
+			(unsigned long long)(stats.spiBusyNs / 1000));
+	fprintf(stderr, "uart tx: %u bytes, irqs: %u, gpio writes: %u, spin loops broken: %u\n",
+			stats.uartTxBytes, stats.irqs, stats.gpioWrites, stats.spinBreaks);
+	if (sim_oled_unknown_commands()) {
+		fprintf(stderr, "oled: %u unknown command bytes\n", sim_oled_unknown_commands());
+	}
+	if (ppmPath != NULL && sim_oled_save_ppm(ppmPath) != 0) {
+		fprintf(stderr, "can't write %s\n", ppmPath);
+	}
+	if (vcdPath != NULL && sim_trace_save_vcd(vcdPath) != 0) {
+		fprintf(stderr, "can't write %s\n", vcdPath);
+	}
+	if (flashPath != NULL && sim_flash_save(flashPath) != 0) {
+		fprintf(stderr, "can't write %s\n", flashPath);
+	}
+	return 0;
+}
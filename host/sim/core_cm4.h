@@ -0,0 +1,173 @@
+/**
+  ******************************************************************************
+  * @file           : core_cm4.h
+
+  * @brief          : host stand-in for the CMSIS Cortex-M4 core header
+  * @date           : 17-10-2026
+  *
+  * stm32f411xe.h includes "core_cm4.h" after defining the IRQ numbers. The
+  * host build puts host/sim first on the include path, so this file is found
+  * instead of Drivers/CMSIS/Include/core_cm4.h, whose intrinsics are ARM
+  * assembly. The device header, the HAL headers and the firmware then
+  * compile unchanged:
+  *   - SCB, SysTick, NVIC and CoreDebug are plain structs in RAM
+  *   - DWT is fetched through sim_dwt(), which lets virtual time move on and
+  *     returns the cycle counter of the simulated core
+  *   - PRIMASK, IPSR and WFI are the interrupt state of the simulator
+  *     (simCore.c)
+
+  ******************************************************************************
+  */
+
+#ifndef HOST_SIM_CORE_CM4_H_
+#define HOST_SIM_CORE_CM4_H_
+
+#include <stdint.h>
+
+#define __CORTEX_M                (4U)
+#define __FPU_USED                1U
+
+#define __I     volatile const
+#define __O     volatile
+#define __IO    volatile
+#define __IM    volatile const
+#define __OM    volatile
+#define __IOM   volatile
+
+#ifndef __ASM
+#define __ASM                     __asm
+#endif
+#ifndef __INLINE
+#define __INLINE                  inline
+#endif
+#ifndef __STATIC_INLINE
+#define __STATIC_INLINE           static inline
+#endif
+#ifndef __STATIC_FORCEINLINE
+#define __STATIC_FORCEINLINE      __attribute__((always_inline)) static inline
+#endif
+#ifndef __NO_RETURN
+#define __NO_RETURN               __attribute__((__noreturn__))
+#endif
+#ifndef __USED
+#define __USED                    __attribute__((used))
+#endif
+#ifndef __WEAK
+#define __WEAK                    __attribute__((weak))
+#endif
+#ifndef __PACKED
+#define __PACKED                  __attribute__((packed, aligned(1)))
+#endif
+#ifndef __ALIGNED
+#define __ALIGNED(x)              __attribute__((aligned(x)))
+#endif
+
+/* Core peripherals, only the registers the firmware and HAL headers touch */
+typedef struct {
+	__IM  uint32_t CPUID;
+	__IOM uint32_t ICSR;
+	__IOM uint32_t VTOR;
+	__IOM uint32_t AIRCR;
+	__IOM uint32_t SCR;
+	__IOM uint32_t CCR;
+	__IOM uint8_t  SHP[12U];
+	__IOM uint32_t SHCSR;
+	__IOM uint32_t CPACR;
+} SCB_Type;
+
+typedef struct {
+	__IOM uint32_t CTRL;
+	__IOM uint32_t LOAD;
+	__IOM uint32_t VAL;
+	__IM  uint32_t CALIB;
+} SysTick_Type;
+
+typedef struct {
+	__IOM uint32_t ISER[8U];
+	__IOM uint32_t ICER[8U];
+	__IOM uint32_t ISPR[8U];
+	__IOM uint32_t ICPR[8U];
+	__IOM uint32_t IABR[8U];
+	__IOM uint8_t  IP[240U];
+} NVIC_Type;
+
+typedef struct {
+	__IOM uint32_t CTRL;
+	__IOM uint32_t CYCCNT;
+	__IOM uint32_t CPICNT;
+	__IOM uint32_t EXCCNT;
+	__IOM uint32_t SLEEPCNT;
+	__IOM uint32_t LSUCNT;
+	__IOM uint32_t FOLDCNT;
+} DWT_Type;
+
+typedef struct {
+	__IOM uint32_t DHCSR;
+	__OM  uint32_t DCRSR;
+	__IOM uint32_t DCRDR;
+	__IOM uint32_t DEMCR;
+} CoreDebug_Type;
+
+#define SCB_SCR_SEVONPEND_Pos         4U
+#define SCB_SCR_SEVONPEND_Msk         (1UL << SCB_SCR_SEVONPEND_Pos)
+#define SCB_SCR_SLEEPDEEP_Pos         2U
+#define SCB_SCR_SLEEPDEEP_Msk         (1UL << SCB_SCR_SLEEPDEEP_Pos)
+#define SCB_SCR_SLEEPONEXIT_Pos       1U
+#define SCB_SCR_SLEEPONEXIT_Msk       (1UL << SCB_SCR_SLEEPONEXIT_Pos)
+#define SysTick_CTRL_COUNTFLAG_Msk    (1UL << 16U)
+#define SysTick_CTRL_CLKSOURCE_Msk    (1UL << 2U)
+#define SysTick_CTRL_TICKINT_Msk      (1UL << 1U)
+#define SysTick_CTRL_ENABLE_Msk       (1UL)
+#define DWT_CTRL_CYCCNTENA_Pos        0U
+#define DWT_CTRL_CYCCNTENA_Msk        (1UL << DWT_CTRL_CYCCNTENA_Pos)
+#define CoreDebug_DEMCR_TRCENA_Pos    24U
+#define CoreDebug_DEMCR_TRCENA_Msk    (1UL << CoreDebug_DEMCR_TRCENA_Pos)
+
+extern SCB_Type sim_scb;
+extern SysTick_Type sim_systick;
+extern NVIC_Type sim_nvic;
+extern CoreDebug_Type sim_core_debug;
+DWT_Type *sim_dwt(void);
+
+#define SCB                           (&sim_scb)
+#define SysTick                       (&sim_systick)
+#define NVIC                          (&sim_nvic)
+#define CoreDebug                     (&sim_core_debug)
+#define DWT                           (sim_dwt())
+
+/* Interrupt state of the simulated core (simCore.c) */
+uint32_t sim_get_primask(void);
+void sim_set_primask(uint32_t primask);
+uint32_t sim_get_ipsr(void);
+void sim_wfi(void);
+
+__STATIC_INLINE void __enable_irq(void)            { sim_set_primask(0); }
+__STATIC_INLINE void __disable_irq(void)           { sim_set_primask(1); }
+__STATIC_INLINE uint32_t __get_PRIMASK(void)       { return sim_get_primask(); }
+__STATIC_INLINE void __set_PRIMASK(uint32_t mask)  { sim_set_primask(mask); }
+__STATIC_INLINE uint32_t __get_IPSR(void)          { return sim_get_ipsr(); }
+__STATIC_INLINE void __WFI(void)                   { sim_wfi(); }
+__STATIC_INLINE void __WFE(void)                   { sim_wfi(); }
+__STATIC_INLINE void __SEV(void)                   { }
+__STATIC_INLINE void __NOP(void)                   { __asm volatile ("nop"); }
+__STATIC_INLINE void __DSB(void)                   { __sync_synchronize(); }
+__STATIC_INLINE void __DMB(void)                   { __sync_synchronize(); }
+__STATIC_INLINE void __ISB(void)                   { __sync_synchronize(); }
+__STATIC_INLINE uint8_t __CLZ(uint32_t value)      { return value ? (uint8_t)__builtin_clz(value) : 32U; }
+
+__STATIC_INLINE uint32_t __RBIT(uint32_t value)
+{
+	uint32_t result = 0;
+	for (uint8_t i = 0; i < 32; i++) {
+		result = (result << 1) | ((value >> i) & 1U);
+	}
+	return result;
+}
+
+/* Exclusive access: a single host thread runs the firmware, so they always succeed */
+__STATIC_INLINE uint32_t __LDREXW(volatile uint32_t *addr)              { return *addr; }
+__STATIC_INLINE uint16_t __LDREXH(volatile uint16_t *addr)              { return *addr; }
+__STATIC_INLINE uint32_t __STREXW(uint32_t value, volatile uint32_t *addr) { *addr = value; return 0; }
+__STATIC_INLINE uint32_t __STREXH(uint16_t value, volatile uint16_t *addr) { *addr = value; return 0; }
+
+#endif /* HOST_SIM_CORE_CM4_H_ */
@@ -0,0 +1,29 @@
+/**
+  ******************************************************************************
+  * @file           : hostCompat.h
+
+  * @brief          : forced into every firmware source of the host build
+  * @date           : 17-10-2026
+  *
+  * On the target uint32_t is unsigned long, so the firmware prints it with
+  * %lu. On a 64-bit host it is unsigned int and %lu would read 8 bytes. The
+  * firmware's printf/snprintf calls are routed through sim_printf() and
+  * sim_snprintf(), which drop a single 'l' length modifier before handing the
+  * format to the C library (long long, %ll, is left alone).
+
+  ******************************************************************************
+  */
+
+#ifndef HOST_SIM_HOSTCOMPAT_H_
+#define HOST_SIM_HOSTCOMPAT_H_
+
+#include <stdio.h>
+#include <stddef.h>
+
+int sim_printf(const char *format, ...);
+int sim_snprintf(char *buffer, size_t size, const char *format, ...);
+
+#define printf(...)    sim_printf(__VA_ARGS__)
+#define snprintf(...)  sim_snprintf(__VA_ARGS__)
+
+#endif /* HOST_SIM_HOSTCOMPAT_H_ */
@@ -0,0 +1,80 @@
+/**
+  ******************************************************************************
+  * @file           : lowPowerSim.c
+
+  * @brief          : lowPower.c for the host build
+  * @date           : 17-10-2026
+  *
+  * lowPower.c drives the RTC wake-up timer and Stop mode at register level,
+  * which the simulator doesn't model. This keeps its API and its statistics
+  * but always idles with WFI, which on the host means "skip to the next
+  * event". LP_STOP is accepted and behaves like LP_SLEEP.
+
+  ******************************************************************************
+  */
+
+#include "lowPower.h"
+#include "scheduler.h"
+
+static lp_mode_t lpMode = LP_MODE;
+static uint32_t lpMark = 0;             // DWT cycle count when the core last woke up
+static lp_stats_t lpStats;
+
+
+static uint32_t lp_us(uint32_t cycles)
+{
+	return cycles / (SystemCoreClock / 1000000);
+}
+
+
+static void lp_fold_active(uint32_t now)
+{
+	lpStats.activeUs += lp_us(now - lpMark);
+	lpMark = now;
+}
+
+
+void lp_init(void)
+{
+	lpMark = DWT->CYCCNT;
+}
+
+
+void lp_set_mode(lp_mode_t mode)
+{
+	lpMode = mode;
+}
+
+
+lp_mode_t lp_get_mode(void)
+{
+	return lpMode;
+}
+
+
+void lp_stats(lp_stats_t *stats)
+{
+	lp_fold_active(DWT->CYCCNT);
+	*stats = lpStats;
+}
+
+
+void lp_wakeup_irq_handler(void)
+{
+}
+
+
+void sched_idle(uint32_t idleMs)
+{
+	uint32_t now = DWT->CYCCNT;
+
+	(void)idleMs;
+	if (lpMode == LP_RUN) {
+		if (now - lpMark >= SystemCoreClock / 1000) lp_fold_active(now);
+		return;
+	}
+	lp_fold_active(now);
+	__WFI();
+	lpStats.sleepUs += lp_us(DWT->CYCCNT - now);
+	lpMark = DWT->CYCCNT;
+}
@@ -0,0 +1,117 @@
+/**
+  ******************************************************************************
+  * @file           : sim.h
+
+  * @brief          : simulated STM32F411 board for running the drivers and
+  *                   the firmware on a Linux host
+  * @date           : 17-10-2026
+  *
+  * The firmware sources are compiled unchanged against the real device and
+  * HAL headers, with host/sim/core_cm4.h in front of the CMSIS one. The HAL
+  * functions they call are implemented by simHal.c instead of the ST
+  * drivers, and the peripheral register blocks and the flash are mapped at
+  * their real addresses, so register accesses just work.
+  *
+  * Time is virtual. It moves on when the firmware waits for something (a
+  * blocking SPI/UART transfer, HAL_Delay, WFI), by a few cycles whenever it
+  * reads the DWT cycle counter or the HAL tick, and when a host program
+  * calls sim_advance_us(). Code between those points takes no virtual time;
+  * host programs measure its real cost with the host clock instead.
+  *
+  * Peripherals that finish in the background (SPI2 and USART2 TX DMA, the
+  * ADC scan, TIM2 compare/capture, received characters) are events at a
+  * virtual time. When time passes one, the peripheral state is updated and
+  * its interrupt is made pending; pending interrupts run the real IRQ
+  * handlers of stm32f4xx_it.c once PRIMASK allows. A loop that spins on a
+  * flag without calling into the HAL (e.g. waiting for a full DMA queue to
+  * drain) is caught by a host timer and time is moved to the next event.
+
+  ******************************************************************************
+  */
+
+#ifndef HOST_SIM_SIM_H_
+#define HOST_SIM_SIM_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+/* ---- Set-up -------------------------------------------------------------- */
+
+void sim_init(void);                        // map the peripherals and flash, start the spin watchdog
+void sim_board_init(void);                  // what main() does before its USER CODE 2 block
+void sim_uart_output(FILE *stream);         // where USART2 TX bytes go (NULL: dropped), stdout by default
+int sim_flash_load(const char *path);       // flash image to start from, 0 on success
+int sim_flash_save(const char *path);
+
+/* ---- Time ---------------------------------------------------------------- */
+
+uint64_t sim_time_ns(void);
+void sim_advance_us(uint32_t us);           // let the peripherals run (interrupts are taken)
+void sim_idle_until(int (*done)(void));     // advance event by event until done() returns non-zero
+
+// Run the firmware's main() for runMs of virtual time, then return to the
+// caller (the firmware is abandoned where it was, don't call it again)
+void sim_run_firmware(uint32_t runMs);
+
+/* ---- Statistics ---------------------------------------------------------- */
+
+typedef struct {
+	uint64_t spiBytes;          // SPI2 bytes clocked out
+	uint32_t spiTransfers;      // HAL_SPI_Transmit / _DMA calls
+	uint32_t spiFrames;         // chip-select low periods on the OLED
+	uint64_t spiBusyNs;         // time SPI2 was shifting
+	uint32_t uartTxBytes;
+	uint32_t irqs;              // interrupt handlers run
+	uint32_t gpioWrites;        // HAL_GPIO_WritePin calls
+	uint32_t spinBreaks;        // busy-wait loops the watchdog moved on
+} sim_stats_t;
+
+void sim_stats(sim_stats_t *stats);
+void sim_stats_reset(void);
+
+/* ---- Devices on the board ------------------------------------------------ */
+
+void sim_dht_set(uint8_t humidity, int8_t temperature, uint8_t present);
+void sim_adc_set(uint8_t rank, uint16_t value, uint16_t noise);     // rank as ADC_SCAN_*
+void sim_uart_input(const char *bytes, uint16_t len);               // "typed" at 115200 baud
+void sim_gpio_set_input(uint8_t port, uint16_t pin, uint8_t level); // port 0 = GPIOA
+
+// OLED: the SSD1331 command stream is decoded into a model of its GDDRAM
+uint16_t sim_oled_pixel(uint8_t x, uint8_t y);                      // RGB565
+int sim_oled_save_ppm(const char *path);
+uint32_t sim_oled_unknown_commands(void);
+
+// GPIO waveforms: record every pin change (and the DHT11 line) from now on
+void sim_trace_start(void);
+int sim_trace_save_vcd(const char *path);
+
+/* ---- Between the simulator files ----------------------------------------- */
+
+typedef void (*sim_event_fn)(uint32_t arg);
+
+#define SIM_GPIO_PORTS     3       // A, B, C
+
+uint32_t sim_cycles_to_ns(uint32_t cycles);
+void sim_spend_cycles(uint32_t cycles);     // the firmware did something that takes time
+void sim_spend_ns(uint64_t ns);
+void sim_event_at(uint64_t when, sim_event_fn fn, uint32_t arg);
+void sim_event_cancel(sim_event_fn fn);
+void sim_irq_pend(int irq);
+void sim_irq_enable(int irq, uint8_t enable);
+void sim_irq_clear(int irq);
+void sim_progress(void);
+extern sim_stats_t simStats;
+
+void sim_timers_update(void);               // simHal.c: bring TIM2/TIM4 up to the current time
+void sim_timers_rearm(void);                // reschedule compare events after register writes
+void sim_tim2_capture(uint8_t channel);     // input edge on a TIM2 capture channel (0 = CH1)
+void sim_irq_done(int irq);                 // peripheral side effects once a handler returned
+uint32_t sim_apb1_hz(void);
+uint32_t sim_apb1_timer_hz(void);
+void sim_gpio_changed(uint8_t port, uint16_t pin, uint8_t level);   // simDevices.c
+void sim_spi_bytes(const uint8_t *data, uint16_t len);
+void sim_dht_released(void);
+void sim_uart_tx(const uint8_t *data, uint16_t len);
+uint16_t sim_adc_sample(uint8_t rank);
+
+#endif /* HOST_SIM_SIM_H_ */
@@ -0,0 +1,589 @@
+/**
+  ******************************************************************************
+  * @file           : simCore.c
+
+  * @brief          : virtual time, events and interrupts of the simulated core
+  * @date           : 17-10-2026
+  *
+  * Time is kept in ns, the DWT cycle counter follows it at the current
+  * SystemCoreClock. Peripherals schedule events (a DMA transfer ends, a
+  * character arrives...) and raise interrupts from them; sim_irq_service()
+  * runs the pending handlers in IRQ number order whenever PRIMASK is clear
+  * and no handler is already running (there is no preemption between them).
+  *
+  * Busy-wait loops that only poll a flag never call back into the
+  * simulator, so time would stand still. An interval timer checks every
+  * SIM_WATCHDOG_US of host time whether the firmware has called in since the
+  * last check; if not, it lets up to SIM_SPIN_STEP_NS pass from the signal
+  * handler, stopping at the next event, which is where a real interrupt
+  * would have come from.
+
+  ******************************************************************************
+  */
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <setjmp.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/time.h>
+
+#include "stm32f4xx_hal.h"
+#include "stm32f4xx_it.h"
+#include "gpio.h"
+#include "dma.h"
+#include "usart.h"
+#include "adc.h"
+#include "spi.h"
+#include "tim.h"
+#include "sim.h"
+
+#define SIM_MAX_EVENTS        32
+#define SIM_SPIN_STEP_NS      20000     // virtual time a watchdog check lets pass at most
+#define SIM_WATCHDOG_US       50        // host time between checks for a spinning firmware
+#define SIM_PERIPH_SIZE       0x30000   // APB1, APB2 and AHB1 up to DMA2
+#define SIM_FLASH_SIZE        0x80000   // 512 KB
+#define SIM_IRQS              96
+#define SIM_DWT_READ_CYCLES   4         // a read of the cycle counter and the compare around it
+#define SIM_DWT_BATCH         64        // cycles of counter reads owed before time is moved
+
+typedef struct {
+	uint64_t when;
+	sim_event_fn fn;
+	uint32_t arg;
+} sim_event_t;
+
+SCB_Type sim_scb;
+SysTick_Type sim_systick;
+NVIC_Type sim_nvic;
+CoreDebug_Type sim_core_debug;
+static DWT_Type simDwt;
+static uint32_t simDwtOwed = 0;                 // cycles of DWT reads not yet added to the clock
+
+sim_stats_t simStats;
+
+static volatile uint64_t simNs = 0;
+static uint64_t simCycles = 0;
+static uint64_t simCycleRem = 0;         // ns * Hz not yet turned into a whole cycle
+
+static sim_event_t simEvents[SIM_MAX_EVENTS];
+static uint8_t simEventCount = 0;
+
+static volatile sig_atomic_t simLock = 0;       // inside the simulator, the watchdog keeps out
+static volatile uint32_t simPrimask = 0;
+static volatile int simActiveIrq = -1;          // handler running, -1 in thread mode
+static uint32_t simIrqPending[SIM_IRQS / 32];
+static uint32_t simIrqEnabled[SIM_IRQS / 32];
+static volatile uint32_t simProgressCount = 0;
+static uint32_t simProgressSeen = 0;
+
+static uint8_t simRunning = 0;                  // sim_run_firmware() in progress
+static uint64_t simRunEnd = 0;
+static sigjmp_buf simRunExit;
+
+int target_main(void);                          // main() of main.c, renamed by the Makefile
+void SystemClock_Config(void);                  // main.c
+
+
+// Handlers of the interrupts the board uses, as in the vector table
+static void (*const simHandlers[SIM_IRQS])(void) = {
+	[RTC_WKUP_IRQn] = RTC_WKUP_IRQHandler,
+	[EXTI3_IRQn] = EXTI3_IRQHandler,
+	[DMA1_Stream4_IRQn] = DMA1_Stream4_IRQHandler,
+	[DMA1_Stream6_IRQn] = DMA1_Stream6_IRQHandler,
+	[ADC_IRQn] = ADC_IRQHandler,
+	[TIM2_IRQn] = TIM2_IRQHandler,
+	[USART2_IRQn] = USART2_IRQHandler,
+	[DMA2_Stream0_IRQn] = DMA2_Stream0_IRQHandler,
+};
+
+
+static void *sim_map(uintptr_t address, size_t size, uint8_t fill)
+{
+	void *memory = mmap((void *)address, size, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE, -1, 0);
+
+	if (memory == MAP_FAILED || memory != (void *)address) {
+		fprintf(stderr, "sim: can't map 0x%08lx (%s)\n", (unsigned long)address, strerror(errno));
+		exit(1);
+	}
+	memset(memory, fill, size);
+	return memory;
+}
+
+
+// FUNCTION      : sim_step_to
+// DESCRIPTION   :
+//   Move the clock (not past any event), keeping the cycle counter and the
+//   timers in step.
+// PARAMETERS    :
+//   uint64_t when : new time in ns, not before the current one
+// RETURNS       :
+//   nothing
+static void sim_step_to(uint64_t when)
+{
+	uint64_t scaled;
+
+	if (when <= simNs) {
+		return;
+	}
+	scaled = (when - simNs) * SystemCoreClock + simCycleRem;
+	simCycles += scaled / 1000000000ULL;
+	simCycleRem = scaled % 1000000000ULL;
+	simNs = when;
+	sim_timers_update();
+}
+
+
+static int sim_next_event(void)
+{
+	int next = -1;
+
+	for (int i = 0; i < simEventCount; i++) {
+		if (next < 0 || simEvents[i].when < simEvents[next].when) {
+			next = i;
+		}
+	}
+	return next;
+}
+
+
+// FUNCTION      : sim_irq_service
+// DESCRIPTION   :
+//   Run the handlers of the pending, enabled interrupts if the core would
+//   take them now.
+// PARAMETERS    :
+//   none
+// RETURNS       :
+//   nothing
+static void sim_irq_service(void)
+{
+	int irq;
+
+	while (!simPrimask && simActiveIrq < 0 && simLock == 0) {
+		for (irq = 0; irq < SIM_IRQS; irq++) {
+			if (simIrqPending[irq / 32] & simIrqEnabled[irq / 32] & (1UL << (irq % 32))) {
+				break;
+			}
+		}
+		if (irq == SIM_IRQS) {
+			return;
+		}
+		simIrqPending[irq / 32] &= ~(1UL << (irq % 32));
+		simActiveIrq = irq;
+		simStats.irqs++;
+		if (simHandlers[irq]) {
+			simHandlers[irq]();
+		}
+		sim_irq_done(irq);
+		simActiveIrq = -1;
+	}
+}
+
+
+// FUNCTION      : sim_move_to
+// DESCRIPTION   :
+//   Let time pass up to a point: every event due on the way runs at its own
+//   time, then the interrupts they raised are taken.
+// PARAMETERS    :
+//   uint64_t when : time in ns
+// RETURNS       :
+//   nothing
+static void sim_move_to(uint64_t when)
+{
+	sim_event_t event;
+	int next;
+
+	simLock++;
+	while ((next = sim_next_event()) >= 0 && simEvents[next].when <= when) {
+		event = simEvents[next];
+		simEvents[next] = simEvents[--simEventCount];
+		sim_step_to(event.when);
+		event.fn(event.arg);
+	}
+	sim_step_to(when);
+	simLock--;
+	sim_irq_service();
+}
+
+
+// The end of a sim_run_firmware() run is only noticed in thread mode, so
+// the firmware is never left half way through an interrupt handler
+static void sim_check_run_end(void)
+{
+	if (simRunning && simActiveIrq < 0 && simLock == 0 && simNs >= simRunEnd) {
+		siglongjmp(simRunExit, 1);
+	}
+}
+
+
+static void sim_watchdog(int sig)
+{
+	uint64_t when;
+	int next;
+
+	(void)sig;
+	if (simLock != 0 || simPrimask || simActiveIrq >= 0) {
+		return;
+	}
+	if (simProgressCount != simProgressSeen) {
+		simProgressSeen = simProgressCount;
+		return;
+	}
+	// Nothing called in for a whole period: the firmware is polling a flag,
+	// or computing for a while. Either way some time passes, in steps small
+	// enough not to skip far ahead of code that is merely busy.
+	next = sim_next_event();
+	if (next < 0) {
+		return;
+	}
+	when = simNs + SIM_SPIN_STEP_NS;
+	if (simEvents[next].when < when) {
+		when = simEvents[next].when;
+	}
+	simStats.spinBreaks++;
+	sim_move_to(when);
+}
+
+
+/* ---- Set-up -------------------------------------------------------------- */
+
+void sim_init(void)
+{
+	struct sigaction action;
+	struct itimerval period;
+
+	sim_map(PERIPH_BASE, SIM_PERIPH_SIZE, 0);
+	sim_map(FLASH_BASE, SIM_FLASH_SIZE, 0xFF);
+
+	// Reset values the HAL macros and the drivers look at
+	RCC->CR = RCC_CR_HSION | RCC_CR_HSIRDY;
+	USART2->SR = USART_SR_TXE | USART_SR_TC;
+	SystemCoreClock = HSI_VALUE;
+
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = sim_watchdog;
+	action.sa_flags = SA_RESTART;
+	sigemptyset(&action.sa_mask);
+	sigaction(SIGALRM, &action, NULL);
+	period.it_interval.tv_sec = 0;
+	period.it_interval.tv_usec = SIM_WATCHDOG_US;
+	period.it_value = period.it_interval;
+	setitimer(ITIMER_REAL, &period, NULL);
+}
+
+
+int sim_flash_load(const char *path)
+{
+	FILE *file = fopen(path, "rb");
+	size_t got;
+
+	if (file == NULL) {
+		return -1;
+	}
+	got = fread((void *)FLASH_BASE, 1, SIM_FLASH_SIZE, file);
+	fclose(file);
+	return (got == SIM_FLASH_SIZE) ? 0 : -1;
+}
+
+
+int sim_flash_save(const char *path)
+{
+	FILE *file = fopen(path, "wb");
+
+	if (file == NULL) {
+		return -1;
+	}
+	if (fwrite((const void *)FLASH_BASE, 1, SIM_FLASH_SIZE, file) != SIM_FLASH_SIZE) {
+		fclose(file);
+		return -1;
+	}
+	return fclose(file);
+}
+
+
+void sim_board_init(void)
+{
+	HAL_Init();
+	SystemClock_Config();
+	MX_GPIO_Init();
+	MX_DMA_Init();
+	MX_USART2_UART_Init();
+	MX_ADC1_Init();
+	MX_SPI2_Init();
+	MX_TIM4_Init();
+	MX_TIM2_Init();
+}
+
+
+void sim_run_firmware(uint32_t runMs)
+{
+	simRunEnd = simNs + (uint64_t)runMs * 1000000ULL;
+	simRunning = 1;
+	if (sigsetjmp(simRunExit, 1) == 0) {
+		target_main();
+	}
+	simRunning = 0;
+	simPrimask = 0;
+	simActiveIrq = -1;
+}
+
+
+/* ---- Time ---------------------------------------------------------------- */
+
+uint64_t sim_time_ns(void)
+{
+	return simNs;
+}
+
+
+uint32_t sim_cycles_to_ns(uint32_t cycles)
+{
+	return (uint32_t)((uint64_t)cycles * 1000000000ULL / SystemCoreClock);
+}
+
+
+void sim_progress(void)
+{
+	simProgressCount++;
+}
+
+
+void sim_spend_ns(uint64_t ns)
+{
+	simProgressCount++;
+	if (simDwtOwed != 0 && simLock == 0) {
+		ns += sim_cycles_to_ns(simDwtOwed);
+		simDwtOwed = 0;
+	}
+	sim_move_to(simNs + ns);
+	sim_check_run_end();
+}
+
+
+void sim_spend_cycles(uint32_t cycles)
+{
+	sim_spend_ns(sim_cycles_to_ns(cycles));
+}
+
+
+void sim_advance_us(uint32_t us)
+{
+	sim_spend_ns((uint64_t)us * 1000ULL);
+}
+
+
+void sim_idle_until(int (*done)(void))
+{
+	int next;
+
+	while (!done()) {
+		next = sim_next_event();
+		if (next < 0) {
+			return;   // nothing left that could change the outcome
+		}
+		sim_spend_ns(simEvents[next].when - simNs);
+	}
+}
+
+
+void sim_event_at(uint64_t when, sim_event_fn fn, uint32_t arg)
+{
+	simLock++;
+	if (simEventCount == SIM_MAX_EVENTS) {
+		fprintf(stderr, "sim: event queue full\n");
+		exit(1);
+	}
+	simEvents[simEventCount].when = (when < simNs) ? simNs : when;
+	simEvents[simEventCount].fn = fn;
+	simEvents[simEventCount].arg = arg;
+	simEventCount++;
+	simLock--;
+}
+
+
+void sim_event_cancel(sim_event_fn fn)
+{
+	simLock++;
+	for (int i = 0; i < simEventCount; i++) {
+		if (simEvents[i].fn == fn) {
+			simEvents[i--] = simEvents[--simEventCount];
+		}
+	}
+	simLock--;
+}
+
+
+/* ---- Core registers and interrupts --------------------------------------- */
+
+DWT_Type *sim_dwt(void)
+{
+	// A loop polling the counter would otherwise enter the simulator on every
+	// read; the reads are owed and time moves once they add up to a batch.
+	// The counter includes what is owed, so it still advances on every read.
+	if (simLock == 0) {
+		simDwtOwed += SIM_DWT_READ_CYCLES;
+		simProgressCount++;
+		if (simDwtOwed >= SIM_DWT_BATCH) {
+			sim_spend_ns(0);
+		}
+	}
+	simDwt.CYCCNT = (uint32_t)(simCycles + simDwtOwed);
+	return &simDwt;
+}
+
+
+uint32_t sim_get_primask(void)
+{
+	return simPrimask;
+}
+
+
+void sim_set_primask(uint32_t primask)
+{
+	simPrimask = primask & 1;
+	if (!simPrimask) {
+		sim_irq_service();
+	}
+}
+
+
+uint32_t sim_get_ipsr(void)
+{
+	return (simActiveIrq < 0) ? 0 : (uint32_t)simActiveIrq + 16;
+}
+
+
+// FUNCTION      : sim_wfi
+// DESCRIPTION   :
+//   Sleep until the next interrupt: the next event, or the next SysTick at
+//   the latest. Returns even with PRIMASK set, the handler then runs once
+//   interrupts are enabled again, as on the core.
+// PARAMETERS    :
+//   none
+// RETURNS       :
+//   nothing
+void sim_wfi(void)
+{
+	uint64_t wake = (simNs / 1000000ULL + 1) * 1000000ULL;
+	int next = sim_next_event();
+
+	if (next >= 0 && simEvents[next].when < wake) {
+		wake = simEvents[next].when;
+	}
+	sim_spend_ns(wake > simNs ? wake - simNs : 0);
+}
+
+
+void sim_irq_pend(int irq)
+{
+	if (irq >= 0 && irq < SIM_IRQS) {
+		simIrqPending[irq / 32] |= 1UL << (irq % 32);
+	}
+}
+
+
+void sim_irq_enable(int irq, uint8_t enable)
+{
+	if (irq < 0 || irq >= SIM_IRQS) {
+		return;
+	}
+	if (enable) {
+		simIrqEnabled[irq / 32] |= 1UL << (irq % 32);
+	} else {
+		simIrqEnabled[irq / 32] &= ~(1UL << (irq % 32));
+	}
+	sim_irq_service();
+}
+
+
+void sim_irq_clear(int irq)
+{
+	if (irq >= 0 && irq < SIM_IRQS) {
+		simIrqPending[irq / 32] &= ~(1UL << (irq % 32));
+	}
+}
+
+
+/* ---- Statistics ---------------------------------------------------------- */
+
+void sim_stats(sim_stats_t *stats)
+{
+	*stats = simStats;
+}
+
+
+void sim_stats_reset(void)
+{
+	memset(&simStats, 0, sizeof(simStats));
+}
+
+
+/* ---- C library glue ------------------------------------------------------ */
+
+int uart_tx_write(const char *ptr, int len);   // uartTx.c, what _write() calls on the target
+
+// Copy a format, turning the target's %lu / %ld / %lx (32-bit long) into
+// their int forms; %llu and friends stay as they are
+static void sim_format(char *out, size_t size, const char *format)
+{
+	size_t n = 0;
+
+	while (*format && n + 3 < size) {
+		if (*format != '%') {
+			out[n++] = *format++;
+			continue;
+		}
+		out[n++] = *format++;
+		while (*format && strchr("0123456789.-+ #*", *format) && n + 3 < size) {
+			out[n++] = *format++;
+		}
+		if (format[0] == 'l' && format[1] != 'l') {
+			format++;
+		} else if (format[0] == 'l') {
+			out[n++] = *format++;
+			out[n++] = *format++;
+		}
+		if (*format) {
+			out[n++] = *format++;   // the conversion, or the second '%' of "%%"
+		}
+	}
+	out[n] = '\0';
+}
+
+
+int sim_printf(const char *format, ...)
+{
+	char fixed[256], text[1024];
+	va_list args;
+	int len;
+
+	sim_format(fixed, sizeof(fixed), format);
+	va_start(args, format);
+	len = vsnprintf(text, sizeof(text), fixed, args);
+	va_end(args);
+	if (len > (int)sizeof(text) - 1) {
+		len = sizeof(text) - 1;
+	}
+	if (len > 0) {
+		uart_tx_write(text, len);
+	}
+	return len;
+}
+
+
+int sim_snprintf(char *buffer, size_t size, const char *format, ...)
+{
+	char fixed[256];
+	va_list args;
+	int len;
+
+	sim_format(fixed, sizeof(fixed), format);
+	va_start(args, format);
+	len = vsnprintf(buffer, size, fixed, args);
+	va_end(args);
+	return len;
+}
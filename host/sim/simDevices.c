@@ -0,0 +1,556 @@
+/**
+  ******************************************************************************
+  * @file           : simDevices.c
+
+  * @brief          : what is wired to the simulated MCU: the SSD1331 OLED, the
+  *                   DHT11, the analog inputs and the console
+  * @date           : 17-10-2026
+  *
+  * SSD1331: the bytes sent while CS (PB2) is low are decoded as commands
+  * when DC (PB1) is low and as pixel data (RGB565, high byte first) when it
+  * is high. Data goes to the column/row window with horizontal address
+  * increment, as set by SET_REMAP 0x76. The graphic acceleration commands
+  * (line, rectangle, copy, clear) are applied to the GDDRAM model straight
+  * away; the driver times them itself.
+  *
+  * DHT11: once the host releases PA1 after a low pulse of about 18 ms or more,
+  * the sensor answers with the usual frame; every falling edge is a TIM2 CH2
+  * capture while PA1 is in alternate function mode.
+
+  ******************************************************************************
+  */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "stm32f4xx_hal.h"
+#include "sim.h"
+
+#define OLED_W            96
+#define OLED_H            64
+#define OLED_PORT         1         // GPIOB
+#define OLED_DC_PIN       GPIO_PIN_1
+#define OLED_CS_PIN       GPIO_PIN_2
+
+#define DHT_PORT          0         // GPIOA
+#define DHT_PIN           GPIO_PIN_1
+#define DHT_START_MIN_NS  17900000ULL  // the datasheet's 18 ms, less a timer tick of rounding
+#define DHT_EDGES         42
+
+#define SIM_UART_RX_QUEUE 256
+#define SIM_TRACE_MAX     200000
+
+
+/* ---- SSD1331 ------------------------------------------------------------- */
+
+static uint16_t oledRam[OLED_H][OLED_W];
+static uint8_t oledCmd[40];
+static uint8_t oledCmdLen = 0;
+static uint8_t oledCmdNeed = 0;
+static uint8_t oledCol0 = 0, oledCol1 = OLED_W - 1, oledRow0 = 0, oledRow1 = OLED_H - 1;
+static uint8_t oledCol = 0, oledRow = 0;
+static uint8_t oledDataHigh = 0;       // first byte of a pixel received
+static uint8_t oledDataByte = 0;
+static uint8_t oledFill = 0;
+static uint32_t oledUnknown = 0;
+
+/* ---- DHT11 --------------------------------------------------------------- */
+
+static uint8_t dhtPresent = 1;
+static uint8_t dhtHumidity = 45;
+static int8_t dhtTemperature = 22;
+static uint64_t dhtLowSince = 0;
+static uint8_t dhtLineLow = 0;         // the host holds PA1 low
+static uint8_t dhtLevel = 1;           // level on the wire, for the trace
+static uint64_t dhtEdgeAt[DHT_EDGES * 2];    // the whole frame, played back one edge per event
+static uint8_t dhtEdgeLevel[DHT_EDGES * 2];
+static uint8_t dhtEdgeCount = 0;
+
+/* ---- Analog inputs, console ---------------------------------------------- */
+
+static uint16_t adcValue[3] = { 1000, 2000, 3000 };
+static uint16_t adcNoise[3];
+static uint32_t adcSeed = 12345;
+
+static FILE *uartOut = NULL;
+static uint8_t uartOutSet = 0;
+static uint8_t uartRxQueue[SIM_UART_RX_QUEUE];
+static uint16_t uartRxHead = 0, uartRxTail = 0;
+
+/* ---- Waveform trace ------------------------------------------------------ */
+
+typedef struct {
+	uint64_t ns;
+	uint8_t signal;        // port * 16 + pin
+	uint8_t level;
+} sim_trace_t;
+
+static sim_trace_t *traceBuffer = NULL;
+static uint32_t traceCount = 0;
+static uint64_t traceStart = 0;
+
+
+static void sim_trace(uint8_t signal, uint8_t level)
+{
+	if (traceBuffer != NULL && traceCount < SIM_TRACE_MAX) {
+		traceBuffer[traceCount].ns = sim_time_ns();
+		traceBuffer[traceCount].signal = signal;
+		traceBuffer[traceCount].level = level;
+		traceCount++;
+	}
+}
+
+
+/* ---- SSD1331 model ------------------------------------------------------- */
+
+// Parameter bytes after each command byte, 0xFF for commands it doesn't know
+static uint8_t oled_arguments(uint8_t cmd)
+{
+	switch (cmd) {
+	case 0x15: case 0x75: return 2;                        // column / row window
+	case 0x21: return 7;                                   // line
+	case 0x22: return 10;                                  // rectangle
+	case 0x23: return 6;                                   // copy
+	case 0x24: case 0x25: return 4;                        // dim / clear window
+	case 0x26: return 1;                                   // fill enable
+	case 0x27: return 5;                                   // scrolling set-up
+	case 0x2E: case 0x2F: return 0;
+	case 0x81: case 0x82: case 0x83: case 0x87: return 1;
+	case 0x8A: case 0x8B: case 0x8C: return 1;
+	case 0xA0: case 0xA1: case 0xA2: case 0xA8: return 1;
+	case 0xA4: case 0xA5: case 0xA6: case 0xA7: return 0;
+	case 0xAB: return 5;
+	case 0xAD: case 0xB0: case 0xB1: case 0xB3: case 0xBB: case 0xBE: case 0xFD: return 1;
+	case 0xAC: case 0xAE: case 0xAF: case 0xB9: return 0;
+	case 0xB8: return 32;
+	default: return 0xFF;
+	}
+}
+
+
+// C, B, A 6-bit colour components of the graphic commands to RGB565
+static uint16_t oled_color(const uint8_t *cba)
+{
+	return (uint16_t)(((cba[0] >> 1) << 11) | ((cba[1] & 0x3F) << 5) | (cba[2] >> 1));
+}
+
+
+static void oled_set(int x, int y, uint16_t color)
+{
+	if (x >= 0 && x < OLED_W && y >= 0 && y < OLED_H) {
+		oledRam[y][x] = color;
+	}
+}
+
+
+static void oled_rect(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint16_t outline, uint16_t fill, uint8_t filled)
+{
+	for (int y = y0; y <= y1 && y < OLED_H; y++) {
+		for (int x = x0; x <= x1 && x < OLED_W; x++) {
+			uint8_t edge = (x == x0 || x == x1 || y == y0 || y == y1);
+			if (edge) {
+				oledRam[y][x] = outline;
+			} else if (filled) {
+				oledRam[y][x] = fill;
+			}
+		}
+	}
+}
+
+
+static void oled_line(int x0, int y0, int x1, int y1, uint16_t color)
+{
+	int dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+	int dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+	int err = dx + dy, e2;
+
+	for (;;) {
+		oled_set(x0, y0, color);
+		if (x0 == x1 && y0 == y1) {
+			break;
+		}
+		e2 = 2 * err;
+		if (e2 >= dy) { err += dy; x0 += sx; }
+		if (e2 <= dx) { err += dx; y0 += sy; }
+	}
+}
+
+
+static void oled_copy(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint8_t dx, uint8_t dy)
+{
+	static uint16_t source[OLED_H][OLED_W];
+
+	memcpy(source, oledRam, sizeof(source));
+	for (int y = y0; y <= y1 && y < OLED_H; y++) {
+		for (int x = x0; x <= x1 && x < OLED_W; x++) {
+			oled_set(dx + x - x0, dy + y - y0, source[y][x]);
+		}
+	}
+}
+
+
+static void oled_command(void)
+{
+	const uint8_t *a = &oledCmd[1];
+
+	switch (oledCmd[0]) {
+	case 0x15:
+		oledCol0 = a[0] % OLED_W;
+		oledCol1 = a[1] % OLED_W;
+		oledCol = oledCol0;
+		oledDataHigh = 0;
+		break;
+	case 0x75:
+		oledRow0 = a[0] % OLED_H;
+		oledRow1 = a[1] % OLED_H;
+		oledRow = oledRow0;
+		oledDataHigh = 0;
+		break;
+	case 0x21:
+		oled_line(a[0], a[1], a[2], a[3], oled_color(&a[4]));
+		break;
+	case 0x22:
+		oled_rect(a[0], a[1], a[2], a[3], oled_color(&a[4]), oled_color(&a[7]), oledFill);
+		break;
+	case 0x23:
+		oled_copy(a[0], a[1], a[2], a[3], a[4], a[5]);
+		break;
+	case 0x25:
+		oled_rect(a[0], a[1], a[2], a[3], 0, 0, 1);
+		break;
+	case 0x26:
+		oledFill = a[0] & 1;
+		break;
+	default:
+		break;
+	}
+}
+
+
+static void oled_byte(uint8_t byte, uint8_t data)
+{
+	if (data) {
+		if (!oledDataHigh) {
+			oledDataByte = byte;
+			oledDataHigh = 1;
+			return;
+		}
+		oledDataHigh = 0;
+		oledRam[oledRow][oledCol] = (uint16_t)((oledDataByte << 8) | byte);
+		if (oledCol < oledCol1) {
+			oledCol++;
+		} else {
+			oledCol = oledCol0;
+			oledRow = (oledRow < oledRow1) ? oledRow + 1 : oledRow0;
+		}
+		return;
+	}
+
+	if (oledCmdNeed == 0) {
+		oledCmd[0] = byte;
+		oledCmdLen = 1;
+		oledCmdNeed = oled_arguments(byte);
+		if (oledCmdNeed == 0xFF) {
+			oledUnknown++;
+			oledCmdNeed = 0;
+			return;
+		}
+	} else {
+		oledCmd[oledCmdLen++] = byte;
+		oledCmdNeed--;
+	}
+	if (oledCmdNeed == 0) {
+		oled_command();
+	}
+}
+
+
+void sim_spi_bytes(const uint8_t *data, uint16_t len)
+{
+	uint32_t odr = GPIOB->ODR;
+
+	if (odr & OLED_CS_PIN) {
+		return;     // nothing selected
+	}
+	for (uint16_t i = 0; i < len; i++) {
+		oled_byte(data[i], (odr & OLED_DC_PIN) != 0);
+	}
+}
+
+
+uint16_t sim_oled_pixel(uint8_t x, uint8_t y)
+{
+	return (x < OLED_W && y < OLED_H) ? oledRam[y][x] : 0;
+}
+
+
+uint32_t sim_oled_unknown_commands(void)
+{
+	return oledUnknown;
+}
+
+
+int sim_oled_save_ppm(const char *path)
+{
+	FILE *file = fopen(path, "wb");
+
+	if (file == NULL) {
+		return -1;
+	}
+	fprintf(file, "P6\n%d %d\n255\n", OLED_W, OLED_H);
+	for (int y = 0; y < OLED_H; y++) {
+		for (int x = 0; x < OLED_W; x++) {
+			uint16_t c = oledRam[y][x];
+			uint8_t rgb[3] = { (uint8_t)((c >> 11) << 3), (uint8_t)(((c >> 5) & 0x3F) << 2), (uint8_t)((c & 0x1F) << 3) };
+			fwrite(rgb, 1, 3, file);
+		}
+	}
+	return fclose(file);
+}
+
+
+/* ---- DHT11 model --------------------------------------------------------- */
+
+static void dht_edge(uint32_t index)
+{
+	dhtLevel = dhtEdgeLevel[index];
+	if (index + 1 < dhtEdgeCount) {
+		sim_event_at(dhtEdgeAt[index + 1], dht_edge, index + 1);
+	}
+	sim_trace(DHT_PORT * 16 + 1, dhtLevel);
+	if (dhtLevel) {
+		GPIOA->IDR |= DHT_PIN;
+	} else {
+		GPIOA->IDR &= ~DHT_PIN;
+		if (((GPIOA->MODER >> 2) & 3U) == 2U) {
+			sim_tim2_capture(1);     // PA1 on TIM2 CH2, falling edges
+		}
+	}
+}
+
+
+static void dht_add_edge(uint64_t *at, uint64_t delayUs, uint8_t level)
+{
+	*at += delayUs * 1000ULL;
+	dhtEdgeAt[dhtEdgeCount] = *at;
+	dhtEdgeLevel[dhtEdgeCount] = level;
+	dhtEdgeCount++;
+}
+
+
+void sim_dht_released(void)
+{
+	uint8_t frame[5], high;
+	uint64_t at = sim_time_ns();
+
+	if (!dhtLineLow) {
+		return;
+	}
+	dhtLineLow = 0;
+	dhtLevel = 1;
+	GPIOA->IDR |= DHT_PIN;           // pulled up
+	sim_trace(DHT_PORT * 16 + 1, 1);
+	if (!dhtPresent || at - dhtLowSince < DHT_START_MIN_NS) {
+		return;
+	}
+
+	frame[0] = dhtHumidity;
+	frame[1] = 0;
+	frame[2] = (uint8_t)dhtTemperature;
+	frame[3] = 0;
+	frame[4] = (uint8_t)(frame[0] + frame[1] + frame[2] + frame[3]);
+
+	sim_event_cancel(dht_edge);
+	dhtEdgeCount = 0;
+	dht_add_edge(&at, 30, 0);        // response: 80 us low, 80 us high
+	dht_add_edge(&at, 80, 1);
+	high = 80;
+	for (uint8_t bit = 0; bit < 40; bit++) {
+		dht_add_edge(&at, high, 0);  // each bit: 50 us low, then 26 us high for a 0 or 70 us for a 1
+		dht_add_edge(&at, 50, 1);
+		high = (frame[bit / 8] & (0x80 >> (bit % 8))) ? 70 : 26;
+	}
+	dht_add_edge(&at, high, 0);      // end of frame: 50 us low, then the line is released
+	dht_add_edge(&at, 50, 1);
+	sim_event_at(dhtEdgeAt[0], dht_edge, 0);
+}
+
+
+void sim_dht_set(uint8_t humidity, int8_t temperature, uint8_t present)
+{
+	dhtHumidity = humidity;
+	dhtTemperature = temperature;
+	dhtPresent = present;
+}
+
+
+/* ---- GPIO ---------------------------------------------------------------- */
+
+void sim_gpio_changed(uint8_t port, uint16_t pin, uint8_t level)
+{
+	for (uint8_t i = 0; i < 16; i++) {
+		if (pin & (1U << i)) {
+			sim_trace((uint8_t)(port * 16 + i), level);
+		}
+	}
+	if (port == OLED_PORT && (pin & OLED_CS_PIN) && !level) {
+		simStats.spiFrames++;
+	}
+	if (port == DHT_PORT && (pin & DHT_PIN)) {
+		if (!level && !dhtLineLow) {
+			dhtLineLow = 1;
+			dhtLowSince = sim_time_ns();
+		}
+	}
+}
+
+
+void sim_gpio_set_input(uint8_t port, uint16_t pin, uint8_t level)
+{
+	GPIO_TypeDef *gpio = (GPIO_TypeDef *)(GPIOA_BASE + port * (GPIOB_BASE - GPIOA_BASE));
+
+	if (port >= SIM_GPIO_PORTS) {
+		return;
+	}
+	if (level) {
+		gpio->IDR |= pin;
+	} else {
+		gpio->IDR &= ~(uint32_t)pin;
+	}
+	for (uint8_t i = 0; i < 16; i++) {
+		if (pin & (1U << i)) {
+			sim_trace((uint8_t)(port * 16 + i), level);
+		}
+	}
+}
+
+
+/* ---- ADC inputs ---------------------------------------------------------- */
+
+void sim_adc_set(uint8_t rank, uint16_t value, uint16_t noise)
+{
+	if (rank < 3) {
+		adcValue[rank] = value;
+		adcNoise[rank] = noise;
+	}
+}
+
+
+uint16_t sim_adc_sample(uint8_t rank)
+{
+	int32_t value;
+
+	if (rank >= 3) {
+		return 0;
+	}
+	value = adcValue[rank];
+	if (adcNoise[rank]) {
+		adcSeed = adcSeed * 1103515245U + 12345U;
+		value += (int32_t)((adcSeed >> 16) % (2U * adcNoise[rank] + 1)) - adcNoise[rank];
+	}
+	return (uint16_t)(value < 0 ? 0 : (value > 4095 ? 4095 : value));
+}
+
+
+/* ---- Console ------------------------------------------------------------- */
+
+void sim_uart_output(FILE *stream)
+{
+	uartOut = stream;
+	uartOutSet = 1;
+}
+
+
+void sim_uart_tx(const uint8_t *data, uint16_t len)
+{
+	FILE *out = uartOutSet ? uartOut : stdout;
+
+	simStats.uartTxBytes += len;
+	if (out != NULL) {
+		fwrite(data, 1, len, out);
+		fflush(out);
+	}
+}
+
+
+// One character at the end of its frame: RXNE, or ORE if the last one is still there
+static void uart_rx_byte(uint32_t arg)
+{
+	(void)arg;
+	if (uartRxHead == uartRxTail) {
+		return;
+	}
+	if (USART2->SR & USART_SR_RXNE) {
+		USART2->SR |= USART_SR_ORE;
+	} else {
+		USART2->DR = uartRxQueue[uartRxHead];
+		USART2->SR |= USART_SR_RXNE;
+	}
+	uartRxHead = (uartRxHead + 1) % SIM_UART_RX_QUEUE;
+	if (USART2->CR1 & USART_CR1_RXNEIE) {
+		sim_irq_pend(USART2_IRQn);
+	}
+}
+
+
+void sim_uart_input(const char *bytes, uint16_t len)
+{
+	uint64_t at = sim_time_ns();
+
+	for (uint16_t i = 0; i < len; i++) {
+		uint16_t next = (uartRxTail + 1) % SIM_UART_RX_QUEUE;
+		if (next == uartRxHead) {
+			break;
+		}
+		uartRxQueue[uartRxTail] = (uint8_t)bytes[i];
+		uartRxTail = next;
+		at += 10ULL * 1000000000ULL / 115200;
+		sim_event_at(at, uart_rx_byte, 0);
+	}
+}
+
+
+/* ---- Waveform trace ------------------------------------------------------ */
+
+void sim_trace_start(void)
+{
+	if (traceBuffer == NULL) {
+		traceBuffer = malloc(SIM_TRACE_MAX * sizeof(sim_trace_t));
+	}
+	traceCount = 0;
+	traceStart = sim_time_ns();
+}
+
+
+// FUNCTION      : sim_trace_save_vcd
+// DESCRIPTION   :
+//   Write the recorded pin changes as a VCD file (one wire per pin that
+//   changed, ns resolution), for GTKWave or any other waveform viewer.
+// PARAMETERS    :
+//   const char *path : output file
+// RETURNS       :
+//   0 on success, -1 if nothing was recorded or the file can't be written
+int sim_trace_save_vcd(const char *path)
+{
+	uint8_t used[SIM_GPIO_PORTS * 16] = { 0 };
+	FILE *file;
+
+	if (traceBuffer == NULL || (file = fopen(path, "w")) == NULL) {
+		return -1;
+	}
+	for (uint32_t i = 0; i < traceCount; i++) {
+		used[traceBuffer[i].signal] = 1;
+	}
+	fprintf(file, "$timescale 1ns $end\n$scope module board $end\n");
+	for (uint8_t s = 0; s < SIM_GPIO_PORTS * 16; s++) {
+		if (used[s]) {
+			fprintf(file, "$var wire 1 %c P%c%u $end\n", '!' + s, 'A' + s / 16, s % 16);
+		}
+	}
+	fprintf(file, "$upscope $end\n$enddefinitions $end\n");
+	for (uint32_t i = 0; i < traceCount; i++) {
+		fprintf(file, "#%llu\n%u%c\n", (unsigned long long)(traceBuffer[i].ns - traceStart),
+				traceBuffer[i].level, '!' + traceBuffer[i].signal);
+	}
+	return fclose(file);
+}
@@ -0,0 +1,1105 @@
+/**
+  ******************************************************************************
+  * @file           : simHal.c
+
+  * @brief          : the HAL functions the firmware calls, on simulated
+  *                   peripherals
+  * @date           : 17-10-2026
+  *
+  * Same names and signatures as the ST drivers, but each call acts on the
+  * simulator instead of the hardware:
+  *   - GPIO writes go to ODR and are reported to the board model (OLED chip
+  *     select, DHT11 line, waveform trace)
+  *   - SPI2 bytes go to the SSD1331 model and take 8 bit times at the SPI2
+  *     clock set in CR1; a DMA transfer finishes with the DMA1 Stream4
+  *     interrupt that long after it started
+  *   - USART2 TX bytes go to the console output, 10 bit times each
+  *   - TIM2 and TIM4 count at the APB1 timer clock over PSC + 1; compares
+  *     and input captures raise TIM2 interrupts
+  *   - ADC1 fills the DMA buffer one scan per TIM4 period (or back to back
+  *     when free-running) with the DMA2 Stream0 half / full interrupts
+  *   - RCC computes SystemCoreClock and the bus clocks from the requested
+  *     configuration, FLASH programs and erases the mapped flash
+  * Only what this firmware uses is there; everything else fails to link.
+
+  ******************************************************************************
+  */
+
+#include <string.h>
+
+#include "stm32f4xx_hal.h"
+#include "sim.h"
+
+#define SIM_HAL_CALL_CYCLES    100   // entering a HAL transfer function, setting up the DMA
+#define SIM_TICK_READ_CYCLES   20    // HAL_GetTick() and the compare around it
+#define SIM_FLASH_WORD_NS      16000ULL
+
+#define SIM_DMA_HALF           0x01
+#define SIM_DMA_FULL           0x02
+
+__IO uint32_t uwTick;
+uint32_t uwTickPrio = (1UL << __NVIC_PRIO_BITS);
+HAL_TickFreqTypeDef uwTickFreq = HAL_TICK_FREQ_DEFAULT;
+
+static uint32_t simTickOffset = 0;      // ms added by HAL_ResumeTick() callers (none yet)
+static uint8_t simFlashUnlocked = 0;
+
+// RCC: what the last OscConfig / ClockConfig asked for
+static uint32_t simPllM = 16, simPllN = 192, simPllP = 2;
+static uint8_t simPllOn = 0;
+
+// DMA streams the firmware uses: SPI2 TX, USART2 TX, ADC1
+static volatile uint8_t simDmaFlags[3];
+static SPI_HandleTypeDef *simSpi;
+static UART_HandleTypeDef *simUart;
+
+// TIM2 / TIM4 counting
+typedef struct {
+	TIM_TypeDef *tim;
+	uint64_t lastNs;            // time CNT was last brought up to
+	uint64_t restNs;            // time left over from the last whole tick
+	uint8_t input[4];           // channel started as input capture
+	uint8_t running[4];         // channel started (OC/IC/PWM)
+	uint32_t flags;             // SR as the hardware sees it
+} sim_timer_t;
+
+static sim_timer_t simTimers[2] = { { TIM2 }, { TIM4 } };
+
+// ADC1 scan into the circular DMA buffer
+static ADC_HandleTypeDef *simAdc;
+static uint16_t *simAdcBuffer;
+static uint32_t simAdcLength;
+static uint32_t simAdcIndex;
+static uint8_t simAdcRunning = 0;
+static uint8_t simAdcSampling[16];     // sampling time setting per rank
+
+
+/* ---- Weak callbacks, for firmware builds that leave one out -------------- */
+
+__weak void HAL_MspInit(void) { }
+__weak void HAL_SPI_MspInit(SPI_HandleTypeDef *hspi) { (void)hspi; }
+__weak void HAL_UART_MspInit(UART_HandleTypeDef *huart) { (void)huart; }
+__weak void HAL_ADC_MspInit(ADC_HandleTypeDef *hadc) { (void)hadc; }
+__weak void HAL_TIM_Base_MspInit(TIM_HandleTypeDef *htim) { (void)htim; }
+__weak void HAL_TIM_OC_MspInit(TIM_HandleTypeDef *htim) { (void)htim; }
+__weak void HAL_TIM_IC_MspInit(TIM_HandleTypeDef *htim) { (void)htim; }
+__weak void HAL_TIM_PWM_MspInit(TIM_HandleTypeDef *htim) { (void)htim; }
+__weak void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi) { (void)hspi; }
+__weak void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) { (void)huart; }
+__weak void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc) { (void)hadc; }
+__weak void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc) { (void)hadc; }
+__weak void HAL_TIM_OC_DelayElapsedCallback(TIM_HandleTypeDef *htim) { (void)htim; }
+__weak void HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef *htim) { (void)htim; }
+
+
+/* ---- Core, tick, NVIC ---------------------------------------------------- */
+
+HAL_StatusTypeDef HAL_Init(void)
+{
+	HAL_MspInit();
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
+{
+	uwTickPrio = TickPriority;
+	return HAL_OK;
+}
+
+
+uint32_t HAL_GetTick(void)
+{
+	sim_spend_cycles(SIM_TICK_READ_CYCLES);
+	uwTick = (uint32_t)(sim_time_ns() / 1000000ULL) + simTickOffset;
+	return uwTick;
+}
+
+
+void HAL_IncTick(void)
+{
+	simTickOffset++;
+}
+
+
+void HAL_Delay(uint32_t Delay)
+{
+	sim_spend_ns((uint64_t)Delay * 1000000ULL);
+}
+
+
+void HAL_SuspendTick(void) { }
+void HAL_ResumeTick(void) { }
+
+
+void HAL_NVIC_SetPriorityGrouping(uint32_t PriorityGroup) { (void)PriorityGroup; }
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+	(void)IRQn;
+	(void)PreemptPriority;
+	(void)SubPriority;
+}
+
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+	sim_irq_enable(IRQn, 1);
+}
+
+
+void HAL_NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+	sim_irq_enable(IRQn, 0);
+}
+
+
+void HAL_NVIC_ClearPendingIRQ(IRQn_Type IRQn)
+{
+	sim_irq_clear(IRQn);
+}
+
+
+/* ---- RCC, PWR, FLASH ----------------------------------------------------- */
+
+HAL_StatusTypeDef HAL_RCC_OscConfig(const RCC_OscInitTypeDef *RCC_OscInitStruct)
+{
+	if (RCC_OscInitStruct->PLL.PLLState == RCC_PLL_ON) {
+		simPllM = RCC_OscInitStruct->PLL.PLLM;
+		simPllN = RCC_OscInitStruct->PLL.PLLN;
+		simPllP = RCC_OscInitStruct->PLL.PLLP;
+		simPllOn = 1;
+		RCC->CR |= RCC_CR_PLLON | RCC_CR_PLLRDY;
+	} else if (RCC_OscInitStruct->PLL.PLLState == RCC_PLL_OFF) {
+		if ((RCC->CFGR & RCC_CFGR_SWS) == RCC_CFGR_SWS_PLL) {
+			return HAL_ERROR;    // the PLL is the system clock
+		}
+		simPllOn = 0;
+		RCC->CR &= ~(RCC_CR_PLLON | RCC_CR_PLLRDY);
+	}
+	sim_spend_ns(100000);    // PLL lock
+	return HAL_OK;
+}
+
+
+uint32_t HAL_RCC_GetSysClockFreq(void)
+{
+	if ((RCC->CFGR & RCC_CFGR_SWS) == RCC_CFGR_SWS_PLL) {
+		return HSI_VALUE / simPllM * simPllN / simPllP;
+	}
+	return HSI_VALUE;
+}
+
+
+HAL_StatusTypeDef HAL_RCC_ClockConfig(const RCC_ClkInitTypeDef *RCC_ClkInitStruct, uint32_t FLatency)
+{
+	uint32_t cfgr = RCC->CFGR;
+
+	if (RCC_ClkInitStruct->ClockType & RCC_CLOCKTYPE_SYSCLK) {
+		if (RCC_ClkInitStruct->SYSCLKSource == RCC_SYSCLKSOURCE_PLLCLK && !simPllOn) {
+			return HAL_ERROR;
+		}
+		cfgr &= ~(RCC_CFGR_SW | RCC_CFGR_SWS);
+		cfgr |= RCC_ClkInitStruct->SYSCLKSource | (RCC_ClkInitStruct->SYSCLKSource << RCC_CFGR_SWS_Pos);
+	}
+	if (RCC_ClkInitStruct->ClockType & RCC_CLOCKTYPE_HCLK) {
+		cfgr = (cfgr & ~RCC_CFGR_HPRE) | RCC_ClkInitStruct->AHBCLKDivider;
+	}
+	if (RCC_ClkInitStruct->ClockType & RCC_CLOCKTYPE_PCLK1) {
+		cfgr = (cfgr & ~RCC_CFGR_PPRE1) | RCC_ClkInitStruct->APB1CLKDivider;
+	}
+	if (RCC_ClkInitStruct->ClockType & RCC_CLOCKTYPE_PCLK2) {
+		cfgr = (cfgr & ~RCC_CFGR_PPRE2) | (RCC_ClkInitStruct->APB2CLKDivider << 3);
+	}
+	// The timers keep the ticks they counted at the old clock
+	sim_timers_update();
+	RCC->CFGR = cfgr;
+	FLASH->ACR = (FLASH->ACR & ~FLASH_ACR_LATENCY) | FLatency;
+	SystemCoreClock = HAL_RCC_GetSysClockFreq() >> AHBPrescTable[(cfgr & RCC_CFGR_HPRE) >> RCC_CFGR_HPRE_Pos];
+	sim_timers_rearm();
+	return HAL_OK;
+}
+
+
+uint32_t HAL_RCC_GetHCLKFreq(void)
+{
+	return SystemCoreClock;
+}
+
+
+uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+	return SystemCoreClock >> APBPrescTable[(RCC->CFGR & RCC_CFGR_PPRE1) >> RCC_CFGR_PPRE1_Pos];
+}
+
+
+uint32_t HAL_RCC_GetPCLK2Freq(void)
+{
+	return SystemCoreClock >> APBPrescTable[(RCC->CFGR & RCC_CFGR_PPRE2) >> RCC_CFGR_PPRE2_Pos];
+}
+
+
+uint32_t sim_apb1_hz(void)
+{
+	return HAL_RCC_GetPCLK1Freq();
+}
+
+
+uint32_t sim_apb1_timer_hz(void)
+{
+	uint32_t pclk1 = HAL_RCC_GetPCLK1Freq();
+
+	return ((RCC->CFGR & RCC_CFGR_PPRE1) == RCC_HCLK_DIV1) ? pclk1 : 2 * pclk1;
+}
+
+
+void HAL_PWR_EnableBkUpAccess(void)
+{
+	PWR->CR |= PWR_CR_DBP;
+}
+
+
+void HAL_PWR_EnterSLEEPMode(uint32_t Regulator, uint8_t SLEEPEntry)
+{
+	(void)Regulator;
+	(void)SLEEPEntry;
+	sim_wfi();
+}
+
+
+void HAL_PWR_EnterSTOPMode(uint32_t Regulator, uint8_t STOPEntry)
+{
+	(void)Regulator;
+	(void)STOPEntry;
+	sim_wfi();
+}
+
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void)
+{
+	simFlashUnlocked = 1;
+	FLASH->CR &= ~FLASH_CR_LOCK;
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void)
+{
+	simFlashUnlocked = 0;
+	FLASH->CR |= FLASH_CR_LOCK;
+	return HAL_OK;
+}
+
+
+// FUNCTION      : HAL_FLASH_Program
+// DESCRIPTION   :
+//   Program flash like the controller does: bits can only go from 1 to 0,
+//   anything else needs an erase first.
+// PARAMETERS    :
+//   uint32_t TypeProgram : FLASH_TYPEPROGRAM_BYTE / HALFWORD / WORD / DOUBLEWORD
+//   uint32_t Address     : flash address
+//   uint64_t Data        : value
+// RETURNS       :
+//   HAL_OK, HAL_ERROR if locked or outside the flash
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t TypeProgram, uint32_t Address, uint64_t Data)
+{
+	uint8_t size = (TypeProgram == FLASH_TYPEPROGRAM_BYTE) ? 1 : (TypeProgram == FLASH_TYPEPROGRAM_HALFWORD) ? 2
+			: (TypeProgram == FLASH_TYPEPROGRAM_WORD) ? 4 : 8;
+	volatile uint8_t *cell = (volatile uint8_t *)(uintptr_t)Address;
+
+	if (!simFlashUnlocked || Address < FLASH_BASE || Address + size > FLASH_BASE + 0x80000) {
+		return HAL_ERROR;
+	}
+	for (uint8_t i = 0; i < size; i++) {
+		cell[i] &= (uint8_t)(Data >> (8 * i));
+	}
+	sim_spend_ns(SIM_FLASH_WORD_NS * (size > 4 ? 2 : 1));
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef *pEraseInit, uint32_t *SectorError)
+{
+	static const uint32_t sectorKb[8] = { 16, 16, 16, 16, 64, 128, 128, 128 };
+	uint32_t address, sector;
+
+	*SectorError = 0xFFFFFFFFU;
+	if (!simFlashUnlocked || pEraseInit->TypeErase != FLASH_TYPEERASE_SECTORS) {
+		return HAL_ERROR;
+	}
+	for (sector = pEraseInit->Sector; sector < pEraseInit->Sector + pEraseInit->NbSectors; sector++) {
+		if (sector >= 8) {
+			*SectorError = sector;
+			return HAL_ERROR;
+		}
+		address = FLASH_BASE;
+		for (uint32_t s = 0; s < sector; s++) {
+			address += sectorKb[s] * 1024;
+		}
+		memset((void *)(uintptr_t)address, 0xFF, sectorKb[sector] * 1024);
+		// Typical erase times at x32 parallelism: ~250 ms for 16 KB, ~1 s for 128 KB
+		sim_spend_ns((uint64_t)(150 + sectorKb[sector] * 7) * 1000000ULL);
+	}
+	return HAL_OK;
+}
+
+
+/* ---- GPIO ---------------------------------------------------------------- */
+
+static uint8_t sim_gpio_port(GPIO_TypeDef *GPIOx)
+{
+	return (uint8_t)(((uintptr_t)GPIOx - GPIOA_BASE) / (GPIOB_BASE - GPIOA_BASE));
+}
+
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init)
+{
+	uint8_t port = sim_gpio_port(GPIOx);
+
+	for (uint8_t pin = 0; pin < 16; pin++) {
+		if (!(GPIO_Init->Pin & (1U << pin))) {
+			continue;
+		}
+		uint8_t wasOutput = ((GPIOx->MODER >> (2 * pin)) & 3U) == 1U;
+		GPIOx->MODER = (GPIOx->MODER & ~(3U << (2 * pin))) | ((GPIO_Init->Mode & 3U) << (2 * pin));
+		GPIOx->PUPDR = (GPIOx->PUPDR & ~(3U << (2 * pin))) | ((GPIO_Init->Pull & 3U) << (2 * pin));
+		if (GPIO_Init->Pull == GPIO_PULLUP) {
+			GPIOx->IDR |= 1U << pin;
+		}
+		if (!wasOutput && (GPIO_Init->Mode & 3U) == 1U) {
+			// The pin starts driving whatever ODR holds
+			sim_gpio_changed(port, (uint16_t)(1U << pin), (GPIOx->ODR >> pin) & 1U);
+		}
+		if (port == 0 && (1U << pin) == GPIO_PIN_1 && wasOutput && (GPIO_Init->Mode & 3U) != 1U) {
+			sim_dht_released();     // PA1: the host lets go of the DHT11 line
+		}
+	}
+}
+
+
+void HAL_GPIO_DeInit(GPIO_TypeDef *GPIOx, uint32_t GPIO_Pin)
+{
+	for (uint8_t pin = 0; pin < 16; pin++) {
+		if (GPIO_Pin & (1U << pin)) {
+			GPIOx->MODER &= ~(3U << (2 * pin));
+		}
+	}
+}
+
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+	uint32_t before = GPIOx->ODR;
+
+	simStats.gpioWrites++;
+	sim_progress();
+	if (PinState != GPIO_PIN_RESET) {
+		GPIOx->ODR = before | GPIO_Pin;
+	} else {
+		GPIOx->ODR = before & ~(uint32_t)GPIO_Pin;
+	}
+	if (GPIOx->ODR != before) {
+		sim_gpio_changed(sim_gpio_port(GPIOx), GPIO_Pin, PinState != GPIO_PIN_RESET);
+	}
+}
+
+
+void HAL_GPIO_TogglePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+	HAL_GPIO_WritePin(GPIOx, GPIO_Pin, (GPIOx->ODR & GPIO_Pin) ? GPIO_PIN_RESET : GPIO_PIN_SET);
+}
+
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+	uint8_t pin = (uint8_t)__builtin_ctz(GPIO_Pin);
+	uint32_t levels = (((GPIOx->MODER >> (2 * pin)) & 3U) == 1U) ? GPIOx->ODR : GPIOx->IDR;
+
+	sim_progress();
+	return (levels & GPIO_Pin) ? GPIO_PIN_SET : GPIO_PIN_RESET;
+}
+
+
+/* ---- DMA ----------------------------------------------------------------- */
+
+static int sim_dma_index(DMA_Stream_TypeDef *stream)
+{
+	if (stream == DMA1_Stream4) return 0;
+	if (stream == DMA1_Stream6) return 1;
+	if (stream == DMA2_Stream0) return 2;
+	return -1;
+}
+
+
+HAL_StatusTypeDef HAL_DMA_Init(DMA_HandleTypeDef *hdma)
+{
+	hdma->State = HAL_DMA_STATE_READY;
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_DMA_DeInit(DMA_HandleTypeDef *hdma)
+{
+	hdma->State = HAL_DMA_STATE_RESET;
+	return HAL_OK;
+}
+
+
+// FUNCTION      : HAL_DMA_IRQHandler
+// DESCRIPTION   :
+//   End of a DMA transfer (or half of the ADC buffer): hand it to the
+//   callback of the peripheral the stream serves, as the HAL does.
+// PARAMETERS    :
+//   DMA_HandleTypeDef *hdma : stream that interrupted
+// RETURNS       :
+//   nothing
+void HAL_DMA_IRQHandler(DMA_HandleTypeDef *hdma)
+{
+	int index = sim_dma_index(hdma->Instance);
+	uint8_t flags;
+
+	if (index < 0) {
+		return;
+	}
+	flags = simDmaFlags[index];
+	simDmaFlags[index] = 0;
+
+	if (index == 0 && (flags & SIM_DMA_FULL)) {
+		SPI_HandleTypeDef *hspi = (SPI_HandleTypeDef *)hdma->Parent;
+		hspi->State = HAL_SPI_STATE_READY;
+		HAL_SPI_TxCpltCallback(hspi);
+	} else if (index == 1 && (flags & SIM_DMA_FULL)) {
+		UART_HandleTypeDef *huart = (UART_HandleTypeDef *)hdma->Parent;
+		huart->gState = HAL_UART_STATE_READY;
+		HAL_UART_TxCpltCallback(huart);
+	} else if (index == 2) {
+		ADC_HandleTypeDef *hadc = (ADC_HandleTypeDef *)hdma->Parent;
+		if (flags & SIM_DMA_HALF) {
+			HAL_ADC_ConvHalfCpltCallback(hadc);
+		}
+		if (flags & SIM_DMA_FULL) {
+			HAL_ADC_ConvCpltCallback(hadc);
+		}
+	}
+}
+
+
+static void sim_dma_done(uint32_t index)
+{
+	static const IRQn_Type irqs[3] = { DMA1_Stream4_IRQn, DMA1_Stream6_IRQn, DMA2_Stream0_IRQn };
+
+	simDmaFlags[index] |= SIM_DMA_FULL;
+	sim_irq_pend(irqs[index]);
+}
+
+
+/* ---- SPI ----------------------------------------------------------------- */
+
+HAL_StatusTypeDef HAL_SPI_Init(SPI_HandleTypeDef *hspi)
+{
+	if (hspi->State == HAL_SPI_STATE_RESET) {
+		HAL_SPI_MspInit(hspi);
+	}
+	hspi->Instance->CR1 = hspi->Init.Mode | hspi->Init.Direction | hspi->Init.DataSize | hspi->Init.CLKPolarity
+			| hspi->Init.CLKPhase | (hspi->Init.NSS & SPI_CR1_SSM) | hspi->Init.BaudRatePrescaler | hspi->Init.FirstBit;
+	hspi->ErrorCode = HAL_SPI_ERROR_NONE;
+	hspi->State = HAL_SPI_STATE_READY;
+	return HAL_OK;
+}
+
+
+// Time to clock out len bytes at the prescaler in CR1
+static uint64_t sim_spi_ns(SPI_HandleTypeDef *hspi, uint16_t len)
+{
+	uint32_t br = (hspi->Instance->CR1 & SPI_CR1_BR) >> SPI_CR1_BR_Pos;
+	uint32_t hz = sim_apb1_hz() >> (br + 1);
+
+	return (uint64_t)len * 8ULL * 1000000000ULL / hz;
+}
+
+
+static void sim_spi_send(SPI_HandleTypeDef *hspi, const uint8_t *pData, uint16_t Size)
+{
+	hspi->Instance->CR1 |= SPI_CR1_SPE;
+	simStats.spiTransfers++;
+	simStats.spiBytes += Size;
+	simStats.spiBusyNs += sim_spi_ns(hspi, Size);
+	sim_spi_bytes(pData, Size);
+}
+
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, const uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+	(void)Timeout;
+	if (hspi->State != HAL_SPI_STATE_READY) {
+		return HAL_BUSY;
+	}
+	if (pData == NULL || Size == 0) {
+		return HAL_ERROR;
+	}
+	hspi->State = HAL_SPI_STATE_BUSY_TX;
+	sim_spend_cycles(SIM_HAL_CALL_CYCLES);
+	sim_spi_send(hspi, pData, Size);
+	sim_spend_ns(sim_spi_ns(hspi, Size));
+	hspi->State = HAL_SPI_STATE_READY;
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, const uint8_t *pData, uint16_t Size)
+{
+	if (hspi->State != HAL_SPI_STATE_READY) {
+		return HAL_BUSY;
+	}
+	if (pData == NULL || Size == 0) {
+		return HAL_ERROR;
+	}
+	hspi->State = HAL_SPI_STATE_BUSY_TX;
+	simSpi = hspi;
+	sim_spend_cycles(SIM_HAL_CALL_CYCLES);
+	sim_spi_send(hspi, pData, Size);
+	sim_event_at(sim_time_ns() + sim_spi_ns(hspi, Size), sim_dma_done, 0);
+	return HAL_OK;
+}
+
+
+/* ---- UART ---------------------------------------------------------------- */
+
+HAL_StatusTypeDef HAL_UART_Init(UART_HandleTypeDef *huart)
+{
+	if (huart->gState == HAL_UART_STATE_RESET) {
+		HAL_UART_MspInit(huart);
+	}
+	huart->Instance->CR1 |= USART_CR1_UE | USART_CR1_TE | USART_CR1_RE;
+	huart->ErrorCode = HAL_UART_ERROR_NONE;
+	huart->gState = HAL_UART_STATE_READY;
+	huart->RxState = HAL_UART_STATE_READY;
+	return HAL_OK;
+}
+
+
+static uint64_t sim_uart_ns(UART_HandleTypeDef *huart, uint16_t len)
+{
+	return (uint64_t)len * 10ULL * 1000000000ULL / huart->Init.BaudRate;
+}
+
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size, uint32_t Timeout)
+{
+	(void)Timeout;
+	if (huart->gState != HAL_UART_STATE_READY) {
+		return HAL_BUSY;
+	}
+	huart->gState = HAL_UART_STATE_BUSY_TX;
+	sim_uart_tx(pData, Size);
+	sim_spend_ns(sim_uart_ns(huart, Size));
+	huart->gState = HAL_UART_STATE_READY;
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData, uint16_t Size)
+{
+	if (huart->gState != HAL_UART_STATE_READY) {
+		return HAL_BUSY;
+	}
+	if (pData == NULL || Size == 0) {
+		return HAL_ERROR;
+	}
+	huart->gState = HAL_UART_STATE_BUSY_TX;
+	simUart = huart;
+	sim_spend_cycles(SIM_HAL_CALL_CYCLES);
+	sim_uart_tx(pData, Size);
+	sim_event_at(sim_time_ns() + sim_uart_ns(huart, Size), sim_dma_done, 1);
+	return HAL_OK;
+}
+
+
+// Reception is handled by uart_rx_irq_handler() before this runs
+void HAL_UART_IRQHandler(UART_HandleTypeDef *huart)
+{
+	(void)huart;
+}
+
+
+/* ---- TIM ----------------------------------------------------------------- */
+
+static sim_timer_t *sim_timer(TIM_TypeDef *tim)
+{
+	for (uint8_t i = 0; i < 2; i++) {
+		if (simTimers[i].tim == tim) {
+			return &simTimers[i];
+		}
+	}
+	return NULL;
+}
+
+
+static uint64_t sim_timer_tick_ns(const sim_timer_t *timer)
+{
+	return (uint64_t)(timer->tim->PSC + 1) * 1000000000ULL / sim_apb1_timer_hz();
+}
+
+
+static uint64_t sim_timer_modulus(const sim_timer_t *timer)
+{
+	return (uint64_t)timer->tim->ARR + 1;
+}
+
+
+// SR flags are rc_w0: the firmware clears one by writing SR = ~flag, which
+// in plain memory would set every other flag. Bits it wrote as 0 are
+// cleared, the rest keep what the hardware had.
+static void sim_timer_raise(sim_timer_t *timer, uint32_t flag)
+{
+	timer->flags = (timer->flags & timer->tim->SR) | flag;
+	timer->tim->SR = timer->flags;
+}
+
+
+// FUNCTION      : sim_timers_update
+// DESCRIPTION   :
+//   Bring CNT of TIM2 and TIM4 up to the current time, and apply an update
+//   event (EGR UG) the firmware has requested: CNT restarts from 0.
+// PARAMETERS    :
+//   none
+// RETURNS       :
+//   nothing
+void sim_timers_update(void)
+{
+	uint64_t now = sim_time_ns(), tickNs, ticks;
+
+	for (uint8_t i = 0; i < 2; i++) {
+		sim_timer_t *timer = &simTimers[i];
+		TIM_TypeDef *tim = timer->tim;
+
+		if (tim->EGR & TIM_EGR_UG) {
+			tim->EGR = 0;
+			tim->CNT = 0;
+			timer->restNs = 0;
+		}
+		if (!(tim->CR1 & TIM_CR1_CEN)) {
+			timer->lastNs = now;
+			continue;
+		}
+		tickNs = sim_timer_tick_ns(timer);
+		ticks = (now - timer->lastNs + timer->restNs) / tickNs;
+		timer->restNs = (now - timer->lastNs + timer->restNs) % tickNs;
+		timer->lastNs = now;
+		tim->CNT = (uint32_t)((tim->CNT + ticks) % sim_timer_modulus(timer));
+	}
+}
+
+
+static volatile uint32_t *sim_timer_ccr(TIM_TypeDef *tim, uint8_t channel)
+{
+	return &tim->CCR1 + channel;
+}
+
+
+static void sim_tim2_compare(uint32_t channel)
+{
+	sim_timer_t *timer = &simTimers[0];
+
+	if (!timer->running[channel] || timer->input[channel]) {
+		return;
+	}
+	sim_timer_raise(timer, TIM_SR_CC1IF << channel);
+	if (TIM2->DIER & (TIM_DIER_CC1IE << channel)) {
+		sim_irq_pend(TIM2_IRQn);
+	}
+}
+
+
+// FUNCTION      : sim_timers_rearm
+// DESCRIPTION   :
+//   Schedule the next output compare match of the running TIM2 channels,
+//   after anything that may have moved CNT, CCRx or the tick rate.
+// PARAMETERS    :
+//   none
+// RETURNS       :
+//   nothing
+void sim_timers_rearm(void)
+{
+	sim_timer_t *timer = &simTimers[0];
+	uint64_t ticks;
+
+	sim_timers_update();
+	sim_event_cancel(sim_tim2_compare);
+	if (!(TIM2->CR1 & TIM_CR1_CEN)) {
+		return;
+	}
+	for (uint8_t channel = 0; channel < 4; channel++) {
+		if (!timer->running[channel] || timer->input[channel]) {
+			continue;
+		}
+		ticks = (*sim_timer_ccr(TIM2, channel) + sim_timer_modulus(timer) - TIM2->CNT) % sim_timer_modulus(timer);
+		if (ticks == 0) {
+			ticks = sim_timer_modulus(timer);
+		}
+		sim_event_at(sim_time_ns() + ticks * sim_timer_tick_ns(timer) - timer->restNs, sim_tim2_compare, channel);
+	}
+}
+
+
+// FUNCTION      : sim_tim2_capture
+// DESCRIPTION   :
+//   An edge on the input of a TIM2 capture channel: latch CNT into CCRx and
+//   raise the interrupt if the channel is listening.
+// PARAMETERS    :
+//   uint8_t channel : 0 for CH1 ... 3 for CH4
+// RETURNS       :
+//   nothing
+void sim_tim2_capture(uint8_t channel)
+{
+	sim_timer_t *timer = &simTimers[0];
+
+	if (!timer->running[channel] || !timer->input[channel]) {
+		return;
+	}
+	sim_timers_update();
+	*sim_timer_ccr(TIM2, channel) = TIM2->CNT;
+	sim_timer_raise(timer, TIM_SR_CC1IF << channel);
+	if (TIM2->DIER & (TIM_DIER_CC1IE << channel)) {
+		sim_irq_pend(TIM2_IRQn);
+	}
+}
+
+
+HAL_StatusTypeDef HAL_TIM_Base_Init(TIM_HandleTypeDef *htim)
+{
+	if (htim->State == HAL_TIM_STATE_RESET) {
+		HAL_TIM_Base_MspInit(htim);
+	}
+	sim_timers_update();
+	htim->Instance->PSC = htim->Init.Prescaler;
+	htim->Instance->ARR = htim->Init.Period;
+	htim->Instance->EGR = TIM_EGR_UG;
+	sim_timers_update();
+	htim->State = HAL_TIM_STATE_READY;
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_TIM_OC_Init(TIM_HandleTypeDef *htim)
+{
+	HAL_TIM_OC_MspInit(htim);
+	return HAL_TIM_Base_Init(htim);
+}
+
+
+HAL_StatusTypeDef HAL_TIM_IC_Init(TIM_HandleTypeDef *htim)
+{
+	HAL_TIM_IC_MspInit(htim);
+	return HAL_TIM_Base_Init(htim);
+}
+
+
+HAL_StatusTypeDef HAL_TIM_PWM_Init(TIM_HandleTypeDef *htim)
+{
+	HAL_TIM_PWM_MspInit(htim);
+	return HAL_TIM_Base_Init(htim);
+}
+
+
+HAL_StatusTypeDef HAL_TIM_ConfigClockSource(TIM_HandleTypeDef *htim, const TIM_ClockConfigTypeDef *sClockSourceConfig)
+{
+	(void)htim;
+	return (sClockSourceConfig->ClockSource == TIM_CLOCKSOURCE_INTERNAL) ? HAL_OK : HAL_ERROR;
+}
+
+
+HAL_StatusTypeDef HAL_TIMEx_MasterConfigSynchronization(TIM_HandleTypeDef *htim, const TIM_MasterConfigTypeDef *sMasterConfig)
+{
+	(void)htim;
+	(void)sMasterConfig;
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_TIM_OC_ConfigChannel(TIM_HandleTypeDef *htim, const TIM_OC_InitTypeDef *sConfig, uint32_t Channel)
+{
+	*sim_timer_ccr(htim->Instance, Channel / 4) = sConfig->Pulse;
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_TIM_PWM_ConfigChannel(TIM_HandleTypeDef *htim, const TIM_OC_InitTypeDef *sConfig, uint32_t Channel)
+{
+	return HAL_TIM_OC_ConfigChannel(htim, sConfig, Channel);
+}
+
+
+HAL_StatusTypeDef HAL_TIM_IC_ConfigChannel(TIM_HandleTypeDef *htim, const TIM_IC_InitTypeDef *sConfig, uint32_t Channel)
+{
+	(void)htim;
+	(void)sConfig;
+	(void)Channel;
+	return HAL_OK;
+}
+
+
+static void sim_adc_trigger_start(void);
+static void sim_adc_trigger_stop(void);
+
+// Start or stop a channel; the counter runs while any channel does
+static void sim_tim_channel(TIM_HandleTypeDef *htim, uint32_t Channel, uint8_t start, uint8_t input, uint8_t irq)
+{
+	sim_timer_t *timer = sim_timer(htim->Instance);
+	uint8_t channel = (uint8_t)(Channel / 4), any = 0;
+
+	if (timer == NULL) {
+		return;
+	}
+	sim_timers_update();
+	timer->running[channel] = start;
+	timer->input[channel] = input;
+	if (start) {
+		htim->Instance->CCER |= TIM_CCER_CC1E << (4 * channel);
+		if (irq) {
+			htim->Instance->DIER |= TIM_DIER_CC1IE << channel;
+		}
+		htim->Instance->CR1 |= TIM_CR1_CEN;
+	} else {
+		htim->Instance->CCER &= ~(TIM_CCER_CC1E << (4 * channel));
+		htim->Instance->DIER &= ~(TIM_DIER_CC1IE << channel);
+		for (uint8_t i = 0; i < 4; i++) {
+			any |= timer->running[i];
+		}
+		if (!any) {
+			htim->Instance->CR1 &= ~TIM_CR1_CEN;
+		}
+	}
+	sim_timers_update();
+	if (htim->Instance == TIM2) {
+		sim_timers_rearm();
+	} else if (htim->Instance == TIM4 && start) {
+		sim_adc_trigger_start();
+	} else if (htim->Instance == TIM4) {
+		sim_adc_trigger_stop();
+	}
+}
+
+
+HAL_StatusTypeDef HAL_TIM_OC_Start_IT(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+	sim_tim_channel(htim, Channel, 1, 0, 1);
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_TIM_OC_Stop_IT(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+	sim_tim_channel(htim, Channel, 0, 0, 1);
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_TIM_IC_Start_IT(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+	sim_tim_channel(htim, Channel, 1, 1, 1);
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_TIM_IC_Stop_IT(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+	sim_tim_channel(htim, Channel, 0, 1, 1);
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_TIM_PWM_Start(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+	sim_tim_channel(htim, Channel, 1, 0, 0);
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_TIM_PWM_Stop(TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+	sim_tim_channel(htim, Channel, 0, 0, 0);
+	return HAL_OK;
+}
+
+
+uint32_t HAL_TIM_ReadCapturedValue(const TIM_HandleTypeDef *htim, uint32_t Channel)
+{
+	return *sim_timer_ccr(htim->Instance, Channel / 4);
+}
+
+
+void HAL_TIM_IRQHandler(TIM_HandleTypeDef *htim)
+{
+	sim_timer_t *timer = sim_timer(htim->Instance);
+
+	if (timer == NULL) {
+		return;
+	}
+	sim_timer_raise(timer, 0);
+	for (uint8_t channel = 0; channel < 4; channel++) {
+		uint32_t flag = TIM_SR_CC1IF << channel;
+		if (!(htim->Instance->SR & flag) || !(htim->Instance->DIER & (TIM_DIER_CC1IE << channel))) {
+			continue;
+		}
+		timer->flags &= ~flag;
+		htim->Instance->SR = timer->flags;
+		htim->Channel = (HAL_TIM_ActiveChannel)(1U << channel);
+		if (timer->input[channel]) {
+			HAL_TIM_IC_CaptureCallback(htim);
+		} else {
+			HAL_TIM_OC_DelayElapsedCallback(htim);
+		}
+		htim->Channel = HAL_TIM_ACTIVE_CHANNEL_CLEARED;
+	}
+}
+
+
+/* ---- ADC ----------------------------------------------------------------- */
+
+HAL_StatusTypeDef HAL_ADC_Init(ADC_HandleTypeDef *hadc)
+{
+	if (hadc->State == HAL_ADC_STATE_RESET) {
+		HAL_ADC_MspInit(hadc);
+	}
+	hadc->State = HAL_ADC_STATE_READY;
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_ADC_ConfigChannel(ADC_HandleTypeDef *hadc, ADC_ChannelConfTypeDef *sConfig)
+{
+	(void)hadc;
+	if (sConfig->Rank >= 1 && sConfig->Rank <= 16) {
+		simAdcSampling[sConfig->Rank - 1] = (uint8_t)sConfig->SamplingTime;
+	}
+	return HAL_OK;
+}
+
+
+// Time of one conversion of every rank: (sampling + 12) ADC clocks each
+static uint64_t sim_adc_scan_ns(void)
+{
+	static const uint16_t samplingCycles[8] = { 3, 15, 28, 56, 84, 112, 144, 480 };
+	uint32_t adcHz = HAL_RCC_GetPCLK2Freq() / (2 * (((simAdc->Init.ClockPrescaler >> 16) & 3U) + 1));
+	uint32_t cycles = 0;
+
+	for (uint32_t rank = 0; rank < simAdc->Init.NbrOfConversion; rank++) {
+		cycles += samplingCycles[simAdcSampling[rank] & 7U] + 12;
+	}
+	return (uint64_t)cycles * 1000000000ULL / adcHz;
+}
+
+
+static uint64_t sim_adc_period_ns(void)
+{
+	sim_timer_t *timer = &simTimers[1];
+
+	if (simAdc->Init.ContinuousConvMode == ENABLE) {
+		return sim_adc_scan_ns();
+	}
+	return sim_timer_modulus(timer) * sim_timer_tick_ns(timer);
+}
+
+
+// One scan written to the buffer; the half / full marks raise the DMA interrupt
+static void sim_adc_scan(uint32_t arg)
+{
+	uint32_t ranks = simAdc->Init.NbrOfConversion;
+
+	(void)arg;
+	if (!simAdcRunning) {
+		return;
+	}
+	for (uint32_t rank = 0; rank < ranks; rank++) {
+		simAdcBuffer[simAdcIndex++] = sim_adc_sample((uint8_t)rank);
+	}
+	if (simAdcIndex == simAdcLength / 2) {
+		simDmaFlags[2] |= SIM_DMA_HALF;
+		sim_irq_pend(DMA2_Stream0_IRQn);
+	} else if (simAdcIndex >= simAdcLength) {
+		simAdcIndex = 0;
+		simDmaFlags[2] |= SIM_DMA_FULL;
+		sim_irq_pend(DMA2_Stream0_IRQn);
+	}
+	if (simAdc->Init.ContinuousConvMode == ENABLE || (TIM4->CR1 & TIM_CR1_CEN)) {
+		sim_event_at(sim_time_ns() + sim_adc_period_ns(), sim_adc_scan, 0);
+	}
+}
+
+
+static void sim_adc_trigger_start(void)
+{
+	sim_timer_t *timer = &simTimers[1];
+	uint64_t ticks;
+
+	if (!simAdcRunning || simAdc->Init.ContinuousConvMode == ENABLE) {
+		return;
+	}
+	// First trigger at the CH4 compare match, then once per period
+	ticks = (TIM4->CCR4 + sim_timer_modulus(timer) - TIM4->CNT) % sim_timer_modulus(timer);
+	sim_event_cancel(sim_adc_scan);
+	sim_event_at(sim_time_ns() + ticks * sim_timer_tick_ns(timer) + sim_adc_scan_ns(), sim_adc_scan, 0);
+}
+
+
+static void sim_adc_trigger_stop(void)
+{
+	if (simAdc != NULL && simAdc->Init.ContinuousConvMode != ENABLE) {
+		sim_event_cancel(sim_adc_scan);
+	}
+}
+
+
+HAL_StatusTypeDef HAL_ADC_Start_DMA(ADC_HandleTypeDef *hadc, uint32_t *pData, uint32_t Length)
+{
+	simAdc = hadc;
+	simAdcBuffer = (uint16_t *)pData;
+	simAdcLength = Length;
+	simAdcIndex = 0;
+	simAdcRunning = 1;
+	simDmaFlags[2] = 0;
+	hadc->State = HAL_ADC_STATE_REG_BUSY;
+	sim_event_cancel(sim_adc_scan);
+	if (hadc->Init.ContinuousConvMode == ENABLE) {
+		sim_event_at(sim_time_ns() + sim_adc_scan_ns(), sim_adc_scan, 0);
+	} else if (TIM4->CR1 & TIM_CR1_CEN) {
+		sim_adc_trigger_start();
+	}
+	return HAL_OK;
+}
+
+
+HAL_StatusTypeDef HAL_ADC_Stop_DMA(ADC_HandleTypeDef *hadc)
+{
+	simAdcRunning = 0;
+	sim_event_cancel(sim_adc_scan);
+	hadc->State = HAL_ADC_STATE_READY;
+	return HAL_OK;
+}
+
+
+void HAL_ADC_IRQHandler(ADC_HandleTypeDef *hadc)
+{
+	(void)hadc;
+}
+
+
+/* ---- After an interrupt handler ------------------------------------------ */
+
+// FUNCTION      : sim_irq_done
+// DESCRIPTION   :
+//   What the hardware does once a handler has run: reading DR cleared the
+//   USART2 receive flags, and the TIM2 handler may have moved a compare.
+// PARAMETERS    :
+//   int irq : interrupt whose handler just returned
+// RETURNS       :
+//   nothing
+void sim_irq_done(int irq)
+{
+	if (irq == USART2_IRQn) {
+		USART2->SR &= ~(USART_SR_RXNE | USART_SR_ORE);
+	} else if (irq == TIM2_IRQn) {
+		sim_timers_rearm();
+	}
+}
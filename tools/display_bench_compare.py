@@ -0,0 +1,78 @@
+#!/usr/bin/env python3
+"""
+Compare two tables from the OLED drawing benchmark (menu option 'b', see
+Core/Src/displayBench.c, or host/build/displayBench) and report regressions.
+
+Usage:
+    display_bench_compare.py [--tolerance PERCENT] baseline.csv new.csv
+
+Either file may be a raw console capture: lines before the CSV header, '#'
+comments and carriage returns are skipped. A case regresses when its time
+per call grows by more than the tolerance (5 % by default) or when it sends
+more SPI bytes or transfers than before. Exit status 1 if anything regressed
+or a baseline case is missing, 0 otherwise.
+"""
+
+import argparse
+import csv
+import sys
+
+HEADER = "case,runs,us,spi_bytes,spi_xfers,pixels,px_per_s"
+
+
+def read_table(path):
+    rows = {}
+    with open(path, newline="") as f:
+        lines = [line.strip("\r\n\t ") for line in f]
+    try:
+        start = lines.index(HEADER)
+    except ValueError:
+        sys.exit(f"{path}: no '{HEADER}' line")
+    for row in csv.DictReader(line for line in lines[start:] if line and not line.startswith("#")):
+        if row.get("px_per_s") is None:
+            break   # end of the table, the console went on with something else
+        rows[row["case"]] = {
+            "us": float(row["us"]),
+            "spi_bytes": int(row["spi_bytes"]),
+            "spi_xfers": int(row["spi_xfers"]),
+            "px_per_s": int(row["px_per_s"]),
+        }
+    return rows
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--tolerance", type=float, default=5.0, help="allowed time growth in percent")
+    parser.add_argument("baseline")
+    parser.add_argument("new")
+    args = parser.parse_args()
+
+    baseline = read_table(args.baseline)
+    new = read_table(args.new)
+    failed = False
+
+    print(f"{'case':<20} {'us':>20} {'spi_bytes':>16} {'spi_xfers':>12}  verdict")
+    for name, old in baseline.items():
+        cur = new.get(name)
+        if cur is None:
+            print(f"{name:<20} {'missing':>20}")
+            failed = True
+            continue
+        change = (cur["us"] - old["us"]) * 100.0 / old["us"] if old["us"] else 0.0
+        problems = []
+        if change > args.tolerance:
+            problems.append(f"time +{change:.1f}%")
+        if cur["spi_bytes"] > old["spi_bytes"]:
+            problems.append("more bytes")
+        if cur["spi_xfers"] > old["spi_xfers"]:
+            problems.append("more transfers")
+        failed |= bool(problems)
+        print(f"{name:<20} {old['us']:>8.2f} -> {cur['us']:>8.2f} {old['spi_bytes']:>6} -> {cur['spi_bytes']:<6}"
+              f" {old['spi_xfers']:>4} -> {cur['spi_xfers']:<4}  {', '.join(problems) or 'ok'}")
+    for name in new.keys() - baseline.keys():
+        print(f"{name:<20} {'new case':>20}")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,136 @@
+#!/usr/bin/env python3
+"""
+Compile the column-major font tables of Core/Src/fonts.c into the row-major
+glyph atlas the SSD1331 driver blits from (Core/Src/fontAtlas.c).
+
+Usage:
+    font_compile.py [--fonts Core/Src/fonts.c] [-o Core/Src/fontAtlas.c]
+
+fonts.c stores every glyph column by column, (height + 7) / 8 bytes per
+column with the top pixel in the MSB. The atlas stores it row by row,
+(width + 7) / 8 bytes per row with the left pixel in the MSB, so a row
+expands to pixels with two nibble lookups per byte (see ssd1331.c). It also
+records where the ink of each glyph starts and how wide it is, which the
+proportional text calls use for their spacing.
+
+fonts.c stays the source; run this after changing it ('make -C host
+font-check' tells whether the checked-in atlas is current).
+"""
+
+import argparse
+import re
+import sys
+
+# name in fonts.c, atlas name, width, height, first character
+FONTS = [
+    ("c_chFont1206", "c_tFontAtlas1206", 6, 12, 0x20),
+    ("c_chFont1608", "c_tFontAtlas1608", 8, 16, 0x20),
+    ("c_chFont1612", "c_tFontAtlas1612", 16, 16, 0x30),
+    ("c_chFont3216", "c_tFontAtlas3216", 16, 32, 0x30),
+]
+
+
+def read_table(source, name, width, height):
+    match = re.search(r"\b%s\s*\[(\d+)\]\s*\[(\d+)\]\s*=\s*\{(.*?)\};" % name, source, re.S)
+    if match is None:
+        sys.exit(f"fonts.c: no table {name}")
+    count, size = int(match.group(1)), int(match.group(2))
+    if size != width * ((height + 7) // 8):
+        sys.exit(f"fonts.c: {name} has {size} bytes per glyph, expected {width} x {height}")
+    body = re.sub(r"/\*.*?\*/", "", match.group(3), flags=re.S)
+    data = [int(byte, 16) for byte in re.findall(r"0[xX]([0-9A-Fa-f]{1,2})\b", body)]
+    if len(data) != count * size:
+        sys.exit(f"fonts.c: {name} has {len(data)} bytes, expected {count * size}")
+    return [data[i * size:(i + 1) * size] for i in range(count)]
+
+
+def to_rows(glyph, width, height):
+    col_bytes = (height + 7) // 8
+    row_bytes = (width + 7) // 8
+    rows = []
+    for y in range(height):
+        bits = 0
+        for x in range(width):
+            if glyph[x * col_bytes + y // 8] & (0x80 >> (y & 7)):
+                bits |= 1 << (row_bytes * 8 - 1 - x)
+        rows.append([(bits >> (8 * (row_bytes - 1 - b))) & 0xFF for b in range(row_bytes)])
+    return rows
+
+
+def ink(rows, width, row_bytes):
+    used = 0
+    for row in rows:
+        bits = 0
+        for byte in row:
+            bits = (bits << 8) | byte
+        used |= bits >> (row_bytes * 8 - width)
+    columns = [x for x in range(width) if used & (1 << (width - 1 - x))]
+    if not columns:
+        return 0, 0
+    return columns[0], columns[-1] - columns[0] + 1
+
+
+def label(code):
+    char = chr(code)
+    return {"\\": "backslash", "*": "star", "/": "slash"}.get(char, char)
+
+
+def emit(source_path, source):
+    out = [
+        "/**",
+        "  ******************************************************************************",
+        "  * @file           : fontAtlas.c",
+        "",
+        "  * @brief          : row-major glyph atlas compiled from fonts.c",
+        "  * @date           : 17-10-2026",
+        "  *",
+        "  * Generated by tools/font_compile.py from %s, do not edit." % source_path,
+        "",
+        "  ******************************************************************************",
+        "  */",
+        "",
+        '#include "fontAtlas.h"',
+    ]
+    for table, atlas, width, height, first in FONTS:
+        glyphs = read_table(source, table, width, height)
+        row_bytes = (width + 7) // 8
+        prefix = atlas.replace("c_tFontAtlas", "c_chAtlas")
+        extents = []
+        out += ["", "static const uint8_t %sRows[%d] = {" % (prefix, len(glyphs) * height * row_bytes)]
+        for index, glyph in enumerate(glyphs):
+            rows = to_rows(glyph, width, height)
+            extents.append(ink(rows, width, row_bytes))
+            data = ",".join("0x%02X" % byte for row in rows for byte in row)
+            out.append("\t%s, /* %s */" % (data, label(first + index)))
+        out += ["};", ""]
+        out.append("static const uint8_t %sInkLeft[%d] = {" % (prefix, len(glyphs)))
+        out.append("\t" + ",".join(str(left) for left, _ in extents))
+        out += ["};", ""]
+        out.append("static const uint8_t %sInkWidth[%d] = {" % (prefix, len(glyphs)))
+        out.append("\t" + ",".join(str(columns) for _, columns in extents))
+        out += ["};", ""]
+        out += [
+            "const font_atlas_t %s = {" % atlas,
+            "\t%d, %d, %d, 0x%02X, %d," % (width, height, row_bytes, first, len(glyphs)),
+            "\t%sRows, %sInkLeft, %sInkWidth" % (prefix, prefix, prefix),
+            "};",
+        ]
+    return "\n".join(out) + "\n"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--fonts", default="Core/Src/fonts.c")
+    parser.add_argument("-o", "--output", default="Core/Src/fontAtlas.c")
+    args = parser.parse_args()
+
+    with open(args.fonts) as f:
+        source = f.read()
+    text = emit("Core/Src/fonts.c", source)
+    with open(args.output, "w") as f:
+        f.write(text)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
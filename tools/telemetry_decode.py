@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+"""
+Decode the binary telemetry stream sent by the board (menu option 9, see
+Core/Src/telemetry.c) into CSV lines.
+
+Usage:
+    telemetry_decode.py [--elf firmware.elf] /dev/ttyACM0      read the ST-Link VCP (needs pyserial)
+    telemetry_decode.py [--elf firmware.elf] capture.bin       decode a saved capture
+    telemetry_decode.py [--elf firmware.elf] - < capture.bin   decode stdin
+
+--elf gives the firmware the stream came from; log entries are formatted with
+the strings of its .log_fmt section (see Core/Src/logger.c). Without it they
+are printed as a format id and raw arguments.
+
+Output, one line per sample:
+    sensors,<seq>,<tick ms>,<humidity or empty>,<temperature>,<light>,<risk>
+    adc,<seq>,<tick ms of the last scan>,<rate Hz>,<scan>,<ch0>,<ch1>,...
+    log,<seq>,<tick ms>,<level>,<module>,"<message>"
+Lost frames (sequence gaps) and bad frames are reported on stderr.
+"""
+
+import csv
+import re
+import struct
+import subprocess
+import sys
+import tempfile
+
+FRAME_SENSORS = 1
+FRAME_ADC = 2
+FRAME_LOG = 3
+NO_DATA = 0xFF
+BAUD_RATE = 115200
+
+# As in Core/Inc/logger.h
+LOG_LEVELS = {1: "error", 2: "warn", 3: "info", 4: "debug"}
+LOG_MODULES = {0: "main", 1: "dht", 2: "adc", 3: "power"}
+C_CONVERSION = re.compile(r"%([-+ 0#]*\d*(?:\.\d+)?)(?:hh|h|ll|l|z|j|t)?([diuxXoc%])")
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE, as telemetry_crc16()."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(data):
+    """Undo COBS; returns None if the block lengths don't add up."""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def load_log_strings(elf):
+    """Bytes of the .log_fmt section of the firmware; a format id is an offset into it."""
+    with tempfile.NamedTemporaryFile(suffix=".bin") as section:
+        for objcopy in ("arm-none-eabi-objcopy", "objcopy"):
+            try:
+                subprocess.run([objcopy, "-O", "binary", "--only-section=.log_fmt", elf, section.name], check=True)
+                return section.read()
+            except (OSError, subprocess.CalledProcessError):
+                continue
+    raise SystemExit("can't extract .log_fmt from %s (is arm-none-eabi-objcopy installed?)" % elf)
+
+
+def format_c(fmt, args):
+    """printf() for the integer conversions the logger allows; args are raw 32-bit words."""
+    args = list(args)
+
+    def convert(match):
+        flags, conversion = match.groups()
+        if conversion == "%":
+            return "%"
+        value = args.pop(0) if args else 0
+        if conversion in "di":
+            value = value - (1 << 32) if value & 0x80000000 else value
+            conversion = "d"
+        elif conversion == "u":
+            conversion = "d"
+        elif conversion == "c":
+            value = chr(value & 0xFF)
+        return ("%" + flags + conversion) % value
+
+    return C_CONVERSION.sub(convert, fmt)
+
+
+class Decoder:
+    def __init__(self, out=sys.stdout, err=sys.stderr, log_strings=None):
+        self.out = out
+        self.err = err
+        self.log_strings = log_strings
+        self.csv = csv.writer(out, lineterminator="\n")
+        self.buffer = bytearray()
+        self.next_seq = {}
+        self.bad = 0
+        self.lost = 0
+
+    def feed(self, data):
+        self.buffer += data
+        while True:
+            end = self.buffer.find(0)
+            if end < 0:
+                return
+            chunk = bytes(self.buffer[:end])
+            del self.buffer[:end + 1]
+            if chunk:
+                self.frame(chunk)
+
+    def frame(self, chunk):
+        frame = cobs_decode(chunk)
+        if frame is None or len(frame) < 9 or crc16(frame[:-2]) != struct.unpack_from("<H", frame, len(frame) - 2)[0]:
+            self.bad += 1   # text lines from the console end up here too
+            return
+
+        kind, seq, tick = struct.unpack_from("<BHI", frame)
+        payload = frame[7:-2]
+        expected = self.next_seq.get(kind)
+        if expected is not None and seq != expected:
+            gap = (seq - expected) & 0xFFFF
+            self.lost += gap
+            print("lost %d frame(s) of type %d before seq %d" % (gap, kind, seq), file=self.err)
+        self.next_seq[kind] = (seq + 1) & 0xFFFF
+
+        if kind == FRAME_SENSORS and len(payload) == 5:
+            humidity, temperature, light, risk = struct.unpack("<BbHb", payload)
+            print("sensors,%d,%d,%s,%d,%d,%d" % (seq, tick, "" if humidity == NO_DATA else humidity,
+                                                 temperature, light, risk), file=self.out)
+        elif kind == FRAME_ADC and len(payload) >= 4:
+            rate, scans, channels = struct.unpack_from("<HBB", payload)
+            samples = struct.unpack_from("<%dH" % (scans * channels), payload, 4)
+            for scan in range(scans):
+                values = samples[scan * channels:(scan + 1) * channels]
+                print("adc,%d,%d,%d,%d,%s" % (seq, tick, rate, scan, ",".join(str(v) for v in values)), file=self.out)
+        elif kind == FRAME_LOG and len(payload) >= 4 and len(payload) % 4 == 0:
+            fmt_id, level, module = struct.unpack_from("<HBB", payload)
+            args = struct.unpack_from("<%dI" % ((len(payload) - 4) // 4), payload, 4)
+            if self.log_strings is not None and fmt_id < len(self.log_strings):
+                fmt = self.log_strings[fmt_id:self.log_strings.index(b"\0", fmt_id)].decode("ascii", "replace")
+                message = format_c(fmt, args)
+            else:
+                message = " ".join(["#%d" % fmt_id] + ["0x%x" % a for a in args])
+            self.csv.writerow(["log", seq, tick, LOG_LEVELS.get(level, level), LOG_MODULES.get(module, module), message])
+        else:
+            self.bad += 1
+
+
+def main():
+    argv = sys.argv[1:]
+    log_strings = None
+    if len(argv) == 3 and argv[0] == "--elf":
+        log_strings = load_log_strings(argv[1])
+        argv = argv[2:]
+    if len(argv) != 1:
+        print(__doc__, file=sys.stderr)
+        return 2
+
+    source = argv[0]
+    decoder = Decoder(log_strings=log_strings)
+    try:
+        if source == "-":
+            stream = sys.stdin.buffer
+        elif source.startswith("/dev/") or source.upper().startswith("COM"):
+            import serial
+            stream = serial.Serial(source, BAUD_RATE, timeout=0.1)
+        else:
+            stream = open(source, "rb")
+        while True:
+            data = stream.read(4096)
+            if not data:
+                if source.startswith("/dev/") or source.upper().startswith("COM"):
+                    continue
+                break
+            decoder.feed(data)
+            sys.stdout.flush()
+    except KeyboardInterrupt:
+        pass
+    print("%d bad frame(s), %d lost" % (decoder.bad, decoder.lost), file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())